@@ -0,0 +1,325 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2023 Jérémie Galarneau <jeremie.galarneau@gmail.com>
+ */
+
+/*
+ * Assembler of the LED programs (see nsec::led::program).
+ *
+ * A program starts with "program <name>" and is followed by one instruction per
+ * line: the operation's name and its operands, separated by spaces. Registers
+ * are named r0 to r3 and comments start with '#'. Animations are named as in
+ * keyframes.h:
+ *   keyframes <animation> <loop point> [<first keyframe> <keyframe count>]
+ * animates all of an animation's keyframes unless a range is given. The loop
+ * point is relative to the first keyframe of the range. An end instruction is
+ * appended to every program.
+ *
+ * Usage:
+ *   g++ -std=c++17 -o assemble assemble.cpp
+ *   ./assemble < programs.asm > ../include/program_data.hpp
+ */
+
+#include "../include/led/program.hpp"
+#include "keyframes.h"
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace nlp = nsec::led::program;
+
+namespace {
+// The interpreter's program counter is 8-bit.
+constexpr unsigned int max_program_size = 255;
+
+struct program {
+	std::string name;
+	std::vector<uint8_t> bytecode;
+	// Loops not closed by a next yet.
+	unsigned int loop_depth;
+};
+
+const struct {
+	const char *name;
+	nlp::operation op;
+	bool has_register;
+} operations[] = {
+	{ "end", nlp::operation::END, false },
+	{ "wait", nlp::operation::WAIT, false },
+	{ "loop", nlp::operation::LOOP, false },
+	{ "next", nlp::operation::NEXT, false },
+	{ "set", nlp::operation::SET, true },
+	{ "add", nlp::operation::ADD, true },
+	{ "random", nlp::operation::RANDOM, true },
+	{ "start", nlp::operation::START, true },
+	{ "stop", nlp::operation::STOP, true },
+	{ "phase", nlp::operation::PHASE, true },
+	{ "spread", nlp::operation::SPREAD, false },
+	{ "activate", nlp::operation::ACTIVATE, false },
+	{ "keyframes", nlp::operation::KEYFRAMES, false },
+	{ "brightness", nlp::operation::BRIGHTNESS, false },
+	{ "fade", nlp::operation::FADE, false },
+	{ "period", nlp::operation::PERIOD, false },
+};
+
+unsigned int line_number;
+
+[[noreturn]] void fail(const std::string& reason)
+{
+	std::cerr << "line " << line_number << ": " << reason << std::endl;
+	std::exit(EXIT_FAILURE);
+}
+
+unsigned int parse_value(const std::string& token, unsigned int max)
+{
+	std::size_t parsed_length;
+	unsigned long value;
+
+	try {
+		value = std::stoul(token, &parsed_length, 0);
+	} catch (const std::exception&) {
+		fail("invalid value '" + token + "'");
+	}
+
+	if (parsed_length != token.size() || value > max) {
+		fail("invalid value '" + token + "'");
+	}
+
+	return value;
+}
+
+uint8_t parse_register(const std::string& token)
+{
+	if (token.size() != 2 || token[0] != 'r' || token[1] < '0' ||
+	    token[1] >= '0' + nlp::register_count) {
+		fail("invalid register '" + token + "'");
+	}
+
+	return token[1] - '0';
+}
+
+unsigned int animation_index(const std::string& name)
+{
+	for (unsigned int i = 0; i < sizeof(source_animations) / sizeof(*source_animations); i++) {
+		if (name == source_animations[i].name) {
+			return i;
+		}
+	}
+
+	fail("unknown animation '" + name + "'");
+}
+
+void assemble_keyframes(program& current, const std::vector<std::string>& operands)
+{
+	if (operands.size() != 2 && operands.size() != 4) {
+		fail("expected an animation, a loop point and an optional keyframe range");
+	}
+
+	const auto index = animation_index(operands[0]);
+	const unsigned int animation_keyframe_count =
+		source_animations[index].keyframes.size();
+	const auto loop_point = parse_value(operands[1], 15);
+	const auto first = operands.size() == 4 ? parse_value(operands[2], 15) : 0;
+	const auto count = operands.size() == 4 ? parse_value(operands[3], 15) :
+						  animation_keyframe_count;
+
+	if (count == 0 || first + count > animation_keyframe_count) {
+		fail("keyframe range is out of the animation");
+	}
+
+	if (loop_point >= count) {
+		fail("loop point is out of the keyframe range");
+	}
+
+	current.bytecode.push_back(index);
+	current.bytecode.push_back((first << 4) | count);
+	current.bytecode.push_back(loop_point);
+}
+
+void assemble(program& current, const std::vector<std::string>& tokens)
+{
+	const auto *operation = std::begin(operations);
+
+	for (; operation != std::end(operations); operation++) {
+		if (tokens[0] == operation->name) {
+			break;
+		}
+	}
+
+	if (operation == std::end(operations)) {
+		fail("unknown operation '" + tokens[0] + "'");
+	}
+
+	std::vector<std::string> operands(tokens.begin() + 1, tokens.end());
+	uint8_t register_index = 0;
+
+	if (operation->has_register) {
+		if (operands.empty()) {
+			fail("expected a register");
+		}
+
+		register_index = parse_register(operands[0]);
+		operands.erase(operands.begin());
+	}
+
+	current.bytecode.push_back(nlp::opcode(operation->op, register_index));
+
+	switch (operation->op) {
+	case nlp::operation::LOOP:
+		if (++current.loop_depth > nlp::max_loop_depth) {
+			fail("loops are nested too deeply");
+		}
+		break;
+	case nlp::operation::NEXT:
+		if (current.loop_depth == 0) {
+			fail("next without a loop");
+		}
+
+		current.loop_depth--;
+		break;
+	case nlp::operation::KEYFRAMES:
+		assemble_keyframes(current, operands);
+		return;
+	default:
+		break;
+	}
+
+	if (nlp::operand_size(operation->op) == 2 && operands.size() == 1) {
+		// A single 16-bit operand, little endian.
+		const auto value = parse_value(operands[0], 0xffff);
+
+		current.bytecode.push_back(value & 0xff);
+		current.bytecode.push_back(value >> 8);
+		return;
+	}
+
+	if (operands.size() != nlp::operand_size(operation->op)) {
+		fail("unexpected operand count");
+	}
+
+	for (const auto& operand : operands) {
+		current.bytecode.push_back(parse_value(operand, 0xff));
+	}
+}
+
+void finish(program& current)
+{
+	if (current.loop_depth != 0) {
+		fail(current.name + ": loop without a next");
+	}
+
+	current.bytecode.push_back(nlp::opcode(nlp::operation::END));
+
+	if (current.bytecode.size() > max_program_size) {
+		fail(current.name + ": program is too large");
+	}
+}
+
+std::string hex_byte(unsigned int value)
+{
+	std::ostringstream formatted;
+
+	formatted << "0x" << std::hex << std::setw(2) << std::setfill('0') << value;
+	return formatted.str();
+}
+
+void emit_header_prologue()
+{
+	std::cout << "/*" << std::endl;
+	// Split the SPDX identifier to avoid confusing the reuse tool
+	std::cout << " * SPDX-License-";
+	std::cout << "Identifier: MIT" << std::endl;
+	std::cout << " *" << std::endl;
+	std::cout << " * Copyright 2023 Jérémie Galarneau <jeremie.galarneau@gmail.com>"
+		  << std::endl;
+	std::cout << " *" << std::endl;
+	std::cout << " * This header was auto-generated; see the animations folder." << std::endl;
+	std::cout << " */" << std::endl << std::endl;
+
+	std::cout << "#include \"led/program.hpp\"" << std::endl;
+}
+} // anonymous namespace
+
+int main()
+{
+	std::vector<program> programs;
+	std::string line;
+
+	while (std::getline(std::cin, line)) {
+		line_number++;
+		line = line.substr(0, line.find('#'));
+
+		std::istringstream line_stream(line);
+		std::vector<std::string> tokens;
+		for (std::string token; line_stream >> token;) {
+			tokens.push_back(token);
+		}
+
+		if (tokens.empty()) {
+			continue;
+		}
+
+		if (tokens[0] == "program") {
+			if (tokens.size() != 2) {
+				fail("expected a program name");
+			}
+
+			if (!programs.empty()) {
+				finish(programs.back());
+			}
+
+			programs.push_back({ tokens[1], {}, 0 });
+			continue;
+		}
+
+		if (programs.empty()) {
+			fail("instruction outside of a program");
+		}
+
+		assemble(programs.back(), tokens);
+	}
+
+	if (programs.empty()) {
+		fail("no programs");
+	}
+
+	finish(programs.back());
+
+	unsigned int total_size = 0;
+	for (const auto& current : programs) {
+		total_size += current.bytecode.size() + 2;
+	}
+
+	std::ostringstream report;
+	report << programs.size() << " programs, " << total_size << " bytes";
+	std::cerr << report.str() << std::endl;
+
+	emit_header_prologue();
+	std::cout << std::endl << "// " << report.str() << std::endl;
+
+	for (const auto& current : programs) {
+		const auto& bytecode = current.bytecode;
+
+		std::cout << std::endl
+			  << "// " << current.name << ": " << bytecode.size() << " bytes"
+			  << std::endl
+			  << "const uint8_t PROGMEM nsec_program_" << current.name << "[] = {";
+		for (std::size_t i = 0; i < bytecode.size(); i++) {
+			std::cout << (i % 8 == 0 ? "\n\t" : " ") << hex_byte(bytecode[i]) << ",";
+		}
+		std::cout << std::endl << "};" << std::endl;
+	}
+
+	std::cout << std::endl << "const uint8_t *const PROGMEM nsec_programs[] = {" << std::endl;
+	for (const auto& current : programs) {
+		std::cout << "\tnsec_program_" << current.name << "," << std::endl;
+	}
+	std::cout << "};" << std::endl;
+
+	return 0;
+}
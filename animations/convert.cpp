@@ -0,0 +1,401 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2023 Jérémie Galarneau <jeremie.galarneau@gmail.com>
+ */
+
+/*
+ * Animation compiler for the badge's LED strip.
+ *
+ * Packs the source keyframes (see keyframes.h) in the format described by
+ * nsec::led::animation:
+ *   - colors are replaced by indices in a palette shared by all animations,
+ *   - times are encoded as 8-bit steps since the previous keyframe, scaled by a
+ *     per-animation factor. The largest factor that represents all times
+ *     exactly is used; otherwise, the smallest one that fits is used and times
+ *     are rounded up to it,
+ *   - all keyframes live in a single array: an animation whose encoded
+ *     keyframes already appear in it (or overlap its end) reuses them,
+ *   - a table of the animations, in source order, lets LED programs refer to
+ *     them by index,
+ *   - the colors of animations interpolated in HSV come first in the palette
+ *     and are also emitted as HSV colors, chosen to convert back to their RGB
+ *     colors exactly on the badge.
+ *
+ * Usage:
+ *   g++ -std=c++17 -o convert convert.cpp
+ *   ./convert > ../include/animation_data.hpp
+ */
+
+#include "../include/led/interpolation.hpp"
+#include "keyframes.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace nli = nsec::led::interpolation;
+
+namespace {
+constexpr unsigned int max_time_step = 255;
+constexpr unsigned int max_time_scale = 255;
+// The strip animator stores keyframe indices on 4 bits.
+constexpr unsigned int max_keyframe_count = 15;
+
+using color = std::array<unsigned char, 3>;
+
+struct packed_keyframe {
+	unsigned int color;
+	unsigned int time_step;
+
+	bool operator==(const packed_keyframe& other) const
+	{
+		return color == other.color && time_step == other.time_step;
+	}
+};
+
+struct packed_animation {
+	std::string name;
+	source_color_space interpolation_space;
+	unsigned int time_scale;
+	// Largest difference between a source and an encoded time, in ms.
+	unsigned int max_time_error;
+	std::vector<packed_keyframe> keyframes;
+	unsigned int first_keyframe;
+};
+
+[[noreturn]] void fail(const std::string& animation_name, const std::string& reason)
+{
+	std::cerr << animation_name << ": " << reason << std::endl;
+	std::exit(EXIT_FAILURE);
+}
+
+// Encoded time steps of an animation, or an empty vector if a step doesn't fit.
+std::vector<unsigned int> time_steps(const std::vector<source_keyframe>& keyframes,
+				     unsigned int scale)
+{
+	std::vector<unsigned int> steps;
+	unsigned int previous_time = 0;
+
+	for (const auto& keyframe : keyframes) {
+		const auto time = (keyframe.time + scale - 1) / scale;
+
+		if (time - previous_time > max_time_step) {
+			return {};
+		}
+
+		steps.push_back(time - previous_time);
+		previous_time = time;
+	}
+
+	return steps;
+}
+
+unsigned int time_scale(const source_animation& animation)
+{
+	unsigned int exact_scale = 0;
+
+	for (const auto& keyframe : animation.keyframes) {
+		exact_scale = std::gcd(exact_scale, keyframe.time);
+	}
+
+	for (unsigned int scale = std::min(exact_scale, max_time_scale); scale > 0; scale--) {
+		if (exact_scale % scale == 0 && !time_steps(animation.keyframes, scale).empty()) {
+			return scale;
+		}
+	}
+
+	for (unsigned int scale = 1; scale <= max_time_scale; scale++) {
+		if (!time_steps(animation.keyframes, scale).empty()) {
+			return scale;
+		}
+	}
+
+	fail(animation.name, "animation is too long to be encoded");
+}
+
+unsigned int palette_index(std::vector<color>& palette, const color& keyframe_color)
+{
+	const auto it = std::find(palette.begin(), palette.end(), keyframe_color);
+
+	if (it != palette.end()) {
+		return it - palette.begin();
+	}
+
+	palette.push_back(keyframe_color);
+	return palette.size() - 1;
+}
+
+packed_animation pack(const source_animation& animation, std::vector<color>& palette)
+{
+	if (animation.keyframes.empty() || animation.keyframes.size() > max_keyframe_count) {
+		fail(animation.name, "unsupported keyframe count");
+	}
+
+	// The animator ignores the first step: a range of keyframes starts at time 0.
+	if (animation.keyframes[0].time != 0) {
+		fail(animation.name, "the first keyframe must be at time 0");
+	}
+
+	packed_animation packed{
+		animation.name, animation.interpolation_space, time_scale(animation), 0, {}, 0
+	};
+	const auto steps = time_steps(animation.keyframes, packed.time_scale);
+	unsigned int time = 0;
+
+	for (unsigned int i = 0; i < animation.keyframes.size(); i++) {
+		const auto& keyframe = animation.keyframes[i];
+		const color keyframe_color = { keyframe.color[0],
+					       keyframe.color[1],
+					       keyframe.color[2] };
+
+		time += steps[i] * packed.time_scale;
+		packed.max_time_error = std::max(packed.max_time_error, time - keyframe.time);
+		packed.keyframes.push_back({ palette_index(palette, keyframe_color), steps[i] });
+	}
+
+	return packed;
+}
+
+/*
+ * HSV color converting back to a color exactly, with the hue closest to the
+ * color's exact hue. There always is one: the color's value is its largest
+ * component and nli::scale() reaches all chromas and ramp levels.
+ */
+nli::hsv_color hsv_color(const color& rgb)
+{
+	const auto [min, max] = std::minmax({ rgb[0], rgb[1], rgb[2] });
+
+	if (min == max) {
+		return { 0, 0, max };
+	}
+
+	// Exact hue, in [0, 6[ sectors.
+	const double chroma = max - min;
+	double exact_hue;
+	if (max == rgb[0]) {
+		exact_hue = std::fmod((rgb[1] - rgb[2]) / chroma + 6, 6);
+	} else if (max == rgb[1]) {
+		exact_hue = (rgb[2] - rgb[0]) / chroma + 2;
+	} else {
+		exact_hue = (rgb[0] - rgb[1]) / chroma + 4;
+	}
+
+	exact_hue *= nli::hue_sector_size;
+
+	nli::hsv_color best{};
+	double best_distance = nli::hue_range;
+	for (unsigned int hue = 0; hue < nli::hue_range; hue++) {
+		const double distance = std::min(std::abs(hue - exact_hue),
+						 nli::hue_range - std::abs(hue - exact_hue));
+
+		if (distance >= best_distance) {
+			continue;
+		}
+
+		for (unsigned int saturation = 0; saturation <= 255; saturation++) {
+			const nli::hsv_color candidate = { uint16_t(hue),
+							   uint8_t(saturation),
+							   max };
+			const auto converted = nli::rgb(candidate);
+
+			if (converted.red == rgb[0] && converted.green == rgb[1] &&
+			    converted.blue == rgb[2]) {
+				best = candidate;
+				best_distance = distance;
+				break;
+			}
+		}
+	}
+
+	if (best_distance == nli::hue_range) {
+		fail("palette", "color has no exact HSV conversion");
+	}
+
+	return best;
+}
+
+/*
+ * Place an animation's keyframes in the shared keyframe array, reusing an
+ * identical run or the part overlapping the end of the array.
+ */
+void place(packed_animation& animation, std::vector<packed_keyframe>& all_keyframes)
+{
+	const auto& keyframes = animation.keyframes;
+	const auto it = std::search(
+		all_keyframes.begin(), all_keyframes.end(), keyframes.begin(), keyframes.end());
+
+	if (it != all_keyframes.end()) {
+		animation.first_keyframe = it - all_keyframes.begin();
+		return;
+	}
+
+	auto overlap = std::min(keyframes.size() - 1, all_keyframes.size());
+	for (; overlap > 0; overlap--) {
+		if (std::equal(all_keyframes.end() - overlap,
+			       all_keyframes.end(),
+			       keyframes.begin(),
+			       keyframes.begin() + overlap)) {
+			break;
+		}
+	}
+
+	animation.first_keyframe = all_keyframes.size() - overlap;
+	all_keyframes.insert(all_keyframes.end(), keyframes.begin() + overlap, keyframes.end());
+}
+
+void emit_header_prologue()
+{
+	std::cout << "/*" << std::endl;
+	// Split the SPDX identifier to avoid confusing the reuse tool
+	std::cout << " * SPDX-License-";
+	std::cout << "Identifier: MIT" << std::endl;
+	std::cout << " *" << std::endl;
+	std::cout << " * Copyright 2023 Jérémie Galarneau <jeremie.galarneau@gmail.com>"
+		  << std::endl;
+	std::cout << " *" << std::endl;
+	std::cout << " * This header was auto-generated; see the animations folder." << std::endl;
+	std::cout << " */" << std::endl << std::endl;
+
+	std::cout << "#include \"led/animation.hpp\"" << std::endl;
+	std::cout << "#include \"led/interpolation.hpp\"" << std::endl;
+}
+
+std::string hex_byte(unsigned int value)
+{
+	std::ostringstream formatted;
+
+	formatted << "0x" << std::hex << std::setw(2) << std::setfill('0') << value;
+	return formatted.str();
+}
+} // anonymous namespace
+
+int main()
+{
+	std::vector<color> palette;
+	std::vector<packed_animation> animations;
+	std::vector<packed_keyframe> all_keyframes;
+	unsigned int source_keyframe_count = 0;
+
+	for (const auto& animation : source_animations) {
+		if (animation.interpolation_space != source_color_space::hsv) {
+			continue;
+		}
+
+		for (const auto& keyframe : animation.keyframes) {
+			palette_index(palette,
+				      { keyframe.color[0], keyframe.color[1], keyframe.color[2] });
+		}
+	}
+
+	const auto hsv_color_count = palette.size();
+
+	for (const auto& animation : source_animations) {
+		animations.push_back(pack(animation, palette));
+		source_keyframe_count += animation.keyframes.size();
+	}
+
+	if (palette.size() > 256) {
+		fail("palette", "too many colors");
+	}
+
+	// Place the longest animations first to give the shorter ones a chance to reuse them.
+	std::vector<packed_animation *> placement_order;
+	for (auto& animation : animations) {
+		placement_order.push_back(&animation);
+	}
+
+	std::stable_sort(placement_order.begin(),
+			 placement_order.end(),
+			 [](const packed_animation *lhs, const packed_animation *rhs) {
+				 return lhs->keyframes.size() > rhs->keyframes.size();
+			 });
+	for (auto *animation : placement_order) {
+		place(*animation, all_keyframes);
+	}
+
+	const auto source_size = source_keyframe_count * 5;
+	const auto packed_size = palette.size() * 3 + hsv_color_count * 4 +
+		all_keyframes.size() * 2 + animations.size() * (5 + 2);
+	std::ostringstream report;
+	report << animations.size() << " animations, " << palette.size() << " colors ("
+	       << hsv_color_count << " in HSV), "
+	       << all_keyframes.size() << " keyframes (" << source_keyframe_count
+	       << " in the sources), " << packed_size << " bytes (" << source_size
+	       << " unpacked)";
+	std::cerr << report.str() << std::endl;
+
+	emit_header_prologue();
+	std::cout << std::endl << "// " << report.str() << std::endl;
+
+	std::cout << "const uint8_t PROGMEM nsec_animation_palette[][3] = {" << std::endl;
+	for (const auto& entry : palette) {
+		std::cout << "\t{ " << hex_byte(entry[0]) << ", " << hex_byte(entry[1]) << ", "
+			  << hex_byte(entry[2]) << " }," << std::endl;
+	}
+	std::cout << "};" << std::endl << std::endl;
+
+	// Never empty, zero-length arrays are not standard.
+	std::cout << "// HSV colors of the first palette entries, for animations interpolated in "
+		  << "HSV." << std::endl
+		  << "const nsec::led::interpolation::hsv_color PROGMEM "
+		  << "nsec_animation_palette_hsv[] = {" << std::endl;
+	for (std::size_t i = 0; i < std::max<std::size_t>(hsv_color_count, 1); i++) {
+		const auto entry = i < hsv_color_count ? hsv_color(palette[i]) : nli::hsv_color{};
+
+		std::cout << "\t{ " << entry.hue << ", " << hex_byte(entry.saturation) << ", "
+			  << hex_byte(entry.value) << " }," << std::endl;
+	}
+	std::cout << "};" << std::endl << std::endl;
+
+	std::cout << "const nsec::led::animation::packed_keyframe PROGMEM "
+		  << "nsec_animation_keyframes[] = {" << std::endl;
+	for (std::size_t i = 0; i < all_keyframes.size(); i++) {
+		std::cout << (i % 4 == 0 ? "\t" : " ") << "{ " << hex_byte(all_keyframes[i].color)
+			  << ", " << hex_byte(all_keyframes[i].time_step) << " },";
+		if (i % 4 == 3 || i == all_keyframes.size() - 1) {
+			std::cout << std::endl;
+		}
+	}
+	std::cout << "};" << std::endl;
+
+	for (const auto& animation : animations) {
+		std::cout << std::endl
+			  << "// " << animation.name << ": " << animation.keyframes.size()
+			  << " keyframes, " << animation.time_scale << " ms steps";
+		if (animation.max_time_error) {
+			std::cout << ", times rounded up by at most " << animation.max_time_error
+				  << " ms";
+		}
+
+		std::cout << std::endl
+			  << "const nsec::led::animation::descriptor PROGMEM nsec_animation_"
+			  << animation.name << " = {" << std::endl;
+		std::cout << "\t&nsec_animation_keyframes[" << animation.first_keyframe << "], "
+			  << animation.keyframes.size() << ", " << animation.time_scale << ","
+			  << std::endl
+			  << "\tnsec::led::animation::color_space::"
+			  << (animation.interpolation_space == source_color_space::hsv ? "HSV" :
+											 "RGB")
+			  << std::endl;
+		std::cout << "};" << std::endl;
+	}
+
+	std::cout << std::endl
+		  << "// Animations by index, for LED programs." << std::endl
+		  << "const nsec::led::animation::descriptor *const PROGMEM nsec_animations[] = {"
+		  << std::endl;
+	for (const auto& animation : animations) {
+		std::cout << "\t&nsec_animation_" << animation.name << "," << std::endl;
+	}
+	std::cout << "};" << std::endl;
+
+	return 0;
+}
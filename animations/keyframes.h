@@ -0,0 +1,391 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2023 Jérémie Galarneau <jeremie.galarneau@gmail.com>
+ */
+
+/*
+ * Source keyframes of the LED strip animations. Each keyframe is an RGB color
+ * and the time (in ms) at which it is reached since the start of the animation.
+ *
+ * Colors are interpolated in RGB unless the animation asks for HSV: fades then
+ * go around the color wheel instead of through grey, which saves intermediate
+ * keyframes between distant hues.
+ */
+
+#include <vector>
+
+struct source_keyframe {
+	unsigned char color[3];
+	unsigned int time;
+};
+
+enum class source_color_space { rgb, hsv };
+
+struct source_animation {
+	const char *name;
+	std::vector<source_keyframe> keyframes;
+	source_color_space interpolation_space = source_color_space::rgb;
+};
+
+// Must match nsec::config::badge::pairing_animation_time_per_led_progress_bar_ms.
+static const unsigned int progress_bar_step_ms = 1000;
+
+static const source_animation source_animations[] = {
+	{ "red_to_green_progress_bar", {
+		// red
+		{ { 100, 20, 0 }, 0 },
+		{ { 0, 0, 0 }, progress_bar_step_ms / 2 },
+		// green <- beginning of loop
+		{ { 0, 255, 0 }, progress_bar_step_ms },
+		// dimmed green to green loop
+		{ { 48, 120, 19 }, progress_bar_step_ms * 2 },
+		{ { 0, 255, 0 }, progress_bar_step_ms * 3 },
+	} },
+
+	{ "happy_clown_barf", {
+		{ { 0, 0, 0 }, 0 },
+		{ { 161, 255, 181 }, 100 },
+		{ { 255, 128, 140 }, 200 },
+		{ { 255, 188, 110 }, 300 },
+		{ { 255, 255, 110 }, 400 },
+		{ { 110, 192, 255 }, 500 },
+		{ { 161, 255, 181 }, 600 },
+	} },
+
+	{ "no_new_friends", {
+		{ { 0, 0, 0 }, 0 },
+		{ { 255, 0, 0 }, 200 },
+		{ { 0, 0, 0 }, 400 },
+		{ { 255, 0, 0 }, 600 },
+	} },
+
+	// Colors evoking a tungten flash
+	{ "shooting_star_tungsten", {
+		{ { 0, 0, 0 }, 0 }, // black
+		{ { 255, 255, 255 }, 100 }, // white
+		{ { 180, 0, 200 }, 400 }, // violet
+		{ { 70, 0, 0 }, 900 }, // red
+		{ { 0, 0, 0 }, 1500 }, // black
+		{ { 0, 0, 0 }, 5000 }, // maintain black
+	} },
+
+	{ "shooting_star_2", {
+		{ { 0, 255, 159 }, 0 },
+		{ { 0, 138, 198 }, 900 },
+		{ { 0, 0, 0 }, 1500 },
+		{ { 0, 0, 0 }, 5000 },
+	} },
+
+	{ "shooting_star_3", {
+		{ { 123,179,255 }, 0 },
+		{ { 232,106,240 }, 500 },
+		{ { 158,55,159 }, 1000 },
+		{ { 0, 0, 0 }, 1300 },
+		{ { 0, 0, 0 }, 5000 },
+	} },
+
+	{ "shooting_star_4", {
+		{ { 115,205,186 }, 0 },
+		{ { 198,240,234 }, 500 },
+		{ { 79,145,62 }, 1000 },
+		{ { 0, 0, 0 }, 1300 },
+		{ { 0, 0, 0 }, 5000 },
+	} },
+
+	{ "shooting_star_5", {
+		{ { 255, 128, 0 }, 0 },
+		{ { 200, 128, 0 }, 600 },
+		{ { 0, 0, 0 }, 1300 },
+		{ { 0, 0, 0 }, 5000 },
+	} },
+
+	{ "shooting_star_6", {
+		{ { 0, 255, 128 }, 0 },
+		{ { 255,255, 51 }, 500 },
+		{ { 255,153, 51 }, 1000 },
+		{ { 0, 0, 0 }, 1300 },
+		{ { 0, 0, 0 }, 5000 },
+	} },
+
+	{ "shooting_star_7", {
+		{ { 255,0,255 }, 0 },
+		{ { 127,0,255 }, 500 },
+		{ { 0,0,32 }, 1000 },
+		{ { 0, 0, 0 }, 1300 },
+		{ { 0, 0, 0 }, 5000 },
+	} },
+
+	{ "shooting_star_8", {
+		{ { 0, 0, 0 }, 0 },
+		{ { 255, 204, 204 }, 100 },
+		{ { 51, 153, 255 }, 400 },
+		{ { 76, 0, 153 }, 900 },
+		{ { 0, 0, 0 }, 1500 },
+		{ { 0, 0, 0 }, 5000 },
+	} },
+
+	// Dark wave synth
+	{ "color_cycle_1", {
+		{ { 0,0,0 }, 0 },
+		{ { 255,73,219 }, 1 },
+		{ { 28,28,62 }, 1000 },
+		{ { 50,240,255 }, 2000 },
+		{ { 255,129,50 }, 3000 },
+		{ { 90,52,123 }, 4000 },
+		{ { 255,73,219 }, 5000 },
+	} },
+
+	// red-white
+	{ "color_cycle_2", {
+		{ { 0,0,0 }, 0 },
+		{ { 255,255,255 }, 1 },
+		{ { 255,0,0 }, 1000 },
+		{ { 255,255,255 }, 2000 },
+	} },
+
+	// pastel rainbow
+	{ "color_cycle_3", {
+		{ { 0,0,0 }, 0 },
+		{ { 255,179,186 }, 1 },
+		{ { 255,223,186 }, 1000 },
+		{ { 255,255,186 }, 2000 },
+		{ { 186,255,201 }, 3000 },
+		{ { 186,225,255 }, 4000 },
+		{ { 255,179,186 }, 5000 },
+	}, source_color_space::hsv },
+
+	// orange breathing
+	{ "color_cycle_orange_breathing", {
+		{ { 0,0,0 }, 0 },
+		{ { 153,76,0 }, 1 },
+		{ { 255,178,102 }, 2000 },
+		{ { 153,76,0 }, 4000 },
+	} },
+
+	{ "color_cycle_red_breathing", {
+		{ { 0,0,0 }, 0 },
+		{ { 153,0,0 }, 1 },
+		{ { 255,102,102 }, 2000 },
+		{ { 153,0,0 }, 4000 },
+	} },
+
+	{ "color_cycle_yellow_breathing", {
+		{ { 0,0,0 }, 0 },
+		{ { 153,153,0 }, 1 },
+		{ { 255,255,102 }, 2000 },
+		{ { 153,153,0 }, 4000 },
+	} },
+
+	{ "color_cycle_green_breathing", {
+		{ { 0,0,0 }, 0 },
+		{ { 0,153,0 }, 1 },
+		{ { 102,255,102 }, 2000 },
+		{ { 0,153,0 }, 4000 },
+	} },
+
+	{ "color_cycle_cyan_breathing", {
+		{ { 0,0,0 }, 0 },
+		{ { 0,153,153 }, 1 },
+		{ { 102,255,255 }, 2000 },
+		{ { 0,153,153 }, 4000 },
+	} },
+
+	{ "color_cycle_blue_breathing", {
+		{ { 0,0,0 }, 0 },
+		{ { 102,102,255 }, 1 },
+		{ { 0,0,153 }, 2000 },
+		{ { 102,102,255 }, 4000 },
+	} },
+
+	{ "color_cycle_violet_breathing", {
+		{ { 0,0,0 }, 0 },
+		{ { 76,0,153 }, 1 },
+		{ { 178,102,255 }, 2000 },
+		{ { 76,0,153 }, 4000 },
+	} },
+
+	{ "color_cycle_pink_breathing", {
+		{ { 0,0,0 }, 0 },
+		{ { 153,0,153 }, 1 },
+		{ { 255,102,255 }, 2000 },
+		{ { 153,0,153 }, 4000 },
+	} },
+
+	{ "color_cycle_white_breathing", {
+		{ { 0,0,0 }, 0 },
+		{ { 153,76,0 }, 1 },
+		{ { 255,178,102 }, 2000 },
+		{ { 153,76,0 }, 4000 },
+	} },
+
+	// Magenta-blue heartbeat
+	{ "color_cycle_magenta_blue_hb", {
+		{ { 0,0,0 }, 0 },
+		{ { 0,0,0 }, 1 },
+		{ { 0,0,0 }, 200 },
+		{ { 255,50,255 }, 300 },
+		{ { 20,20,20 }, 400 },
+		{ { 20,20,20 }, 500 },
+		{ { 25,25,127 }, 600 },
+		{ { 0,0,0 }, 800 },
+		{ { 0,0,0 }, 1200 },
+	} },
+
+	{ "color_cycle_green_pink_hb", {
+		{ { 0,0,0 }, 0 },
+		{ { 0,0,0 }, 1 },
+		{ { 0,0,0 }, 200 },
+		{ { 50,200,50 }, 300 },
+		{ { 10,10,10 }, 400 },
+		{ { 10,10,10 }, 500 },
+		{ { 200,50,170 }, 600 },
+		{ { 0,0,0 }, 800 },
+		{ { 0,0,0 }, 1200 },
+	} },
+
+	// purple-white
+	{ "color_cycle_4", {
+		{ { 0,0,0 }, 0 },
+		{ { 255,255,255 }, 1 },
+		{ { 101, 78, 146 }, 1000 },
+		{ { 255,255,255 }, 2000 },
+	} },
+
+	// yellow-white
+	{ "color_cycle_5", {
+		{ { 0,0,0 }, 0 },
+		{ { 255,255,255 }, 1 },
+		{ { 249, 245, 75 }, 1000 },
+		{ { 255,255,255 }, 2000 },
+	} },
+
+	// cyan-white
+	{ "color_cycle_6", {
+		{ { 0,0,0 }, 0 },
+		{ { 255,255,255 }, 1 },
+		{ { 139, 245, 250 }, 1000 },
+		{ { 255,255,255 }, 2000 },
+	} },
+
+	// orange-white
+	{ "color_cycle_7", {
+		{ { 0,0,0 }, 0 },
+		{ { 255,255,255 }, 1 },
+		{ { 252, 115, 0 }, 1000 },
+		{ { 255,255,255 }, 2000 },
+	} },
+
+	// lime-white
+	{ "color_cycle_8", {
+		{ { 0,0,0 }, 0 },
+		{ { 255,255,255 }, 1 },
+		{ { 130, 205, 71 }, 1000 },
+		{ { 255,255,255 }, 2000 },
+	} },
+
+	// pink-white
+	{ "color_cycle_9", {
+		{ { 0,0,0 }, 0 },
+		{ { 255,255,255 }, 1 },
+		{ { 249, 0, 191 }, 1000 },
+		{ { 255,255,255 }, 2000 },
+	} },
+
+	{ "color_cycle_10", {
+		{ { 0, 0, 0 }, 0 },
+		{ { 242, 227, 219 }, 100 },
+		{ { 65, 100, 74 }, 200 },
+		{ { 38, 58, 41 }, 300 },
+		{ { 232, 106, 51 }, 400 },
+		{ { 242, 227, 219 }, 500 },
+	} },
+
+	{ "color_cycle_11", {
+		{ { 0, 0, 0 }, 0 },
+		{ { 255, 184, 76 }, 100 },
+		{ { 242, 102, 171 }, 200 },
+		{ { 164, 89, 209 }, 300 },
+		{ { 44, 211, 225 }, 400 },
+		{ { 255, 184, 76 }, 500 },
+	}, source_color_space::hsv },
+
+	// Pride
+	{ "color_cycle_12", {
+		{ { 0, 0, 0 }, 0 },
+		{ { 228, 3, 3 }, 500 },
+		{ { 228, 3, 3 }, 950 },
+		{ { 255, 140, 0 }, 1000 },
+		{ { 255, 140, 0 }, 1450 },
+		{ { 255, 237, 0 }, 1500 },
+		{ { 255, 237, 0 }, 1950 },
+		{ { 0, 128, 38 }, 2000 },
+		{ { 0, 128, 38 }, 2450 },
+		{ { 36, 64, 142 }, 2500 },
+		{ { 36, 64, 142 }, 2950 },
+		{ { 115, 41, 130 }, 3000 },
+		{ { 115, 41, 130 }, 3450 },
+		{ { 228, 3, 3 }, 3500 },
+	} },
+
+	{ "color_cycle_13", {
+		{ { 0, 0, 0 }, 0 },
+		{ { 0, 0, 0 }, 1 },
+		{ { 21, 4, 133 }, 500 },
+		{ { 21, 4, 133 }, 1000 },
+		{ { 0, 0, 0 }, 1100 },
+		{ { 0, 0, 0 }, 1250 },
+		{ { 198, 42, 136 }, 1750 },
+		{ { 198, 42, 136 }, 2250 },
+		{ { 0, 0, 0 }, 2350 },
+		{ { 0, 0, 0 }, 2450 },
+		{ { 3, 196, 161 }, 2950 },
+		{ { 3, 196, 161 }, 3450 },
+		{ { 0, 0, 0 }, 3550 },
+		{ { 0, 0, 0 }, 3650 },
+	} },
+
+	{ "color_cycle_14", {
+		{ { 0, 0, 0 }, 0 },
+		{ { 0, 0, 0 }, 1 },
+		{ { 31, 138, 112 }, 500 },
+		{ { 31, 138, 112 }, 1000 },
+		{ { 0, 0, 0 }, 1100 },
+		{ { 0, 0, 0 }, 1250 },
+		{ { 191, 219, 56 }, 1750 },
+		{ { 191, 219, 56 }, 2250 },
+		{ { 0, 0, 0 }, 2350 },
+		{ { 0, 0, 0 }, 2450 },
+		{ { 252, 115, 0 }, 2950 },
+		{ { 252, 115, 0 }, 3450 },
+		{ { 0, 0, 0 }, 3550 },
+		{ { 0, 0, 0 }, 3650 },
+	} },
+
+	{ "color_cycle_spark_1", {
+		{ { 0, 0, 0 }, 0 },
+		{ { 255, 255, 255 }, 100 },
+		{ { 180, 0, 200 }, 400 },
+		{ { 70, 0, 0 }, 900 },
+		{ { 0, 0, 0 }, 1500 },
+		{ { 0, 0, 0 }, 5000 },
+	} },
+
+	{ "color_cycle_spark_2", {
+		{ { 0, 0, 0 }, 0 },
+		{ { 230, 238, 117 }, 100 },
+		{ { 218, 73, 73 }, 400 },
+		{ { 79, 28, 76 }, 900 },
+		{ { 0, 0, 0 }, 1500 },
+		{ { 0, 0, 0 }, 5000 },
+	} },
+
+	{ "color_cycle_spark_3", {
+		{ { 0, 0, 0 }, 0 },
+		{ { 160, 193, 184 }, 100 },
+		{ { 113, 159, 176 }, 400 },
+		{ { 53, 31, 57 }, 900 },
+		{ { 0, 0, 0 }, 1500 },
+		{ { 0, 0, 0 }, 5000 },
+	} },
+};
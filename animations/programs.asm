@@ -0,0 +1,68 @@
+# SPDX-License-Identifier: MIT
+#
+# Copyright 2023 Jérémie Galarneau <jeremie.galarneau@gmail.com>
+#
+# LED programs, see assemble.cpp for the syntax and nsec::led::program for the
+# instructions. Ticks last the program's period, in ms, and programs stop after
+# their last instruction.
+
+# Drops falling on random LEDs.
+program rain
+	period 20
+	brightness 50
+	keyframes shooting_star_2 3
+	activate 0xffff
+	spread 3
+	loop 0
+		random r0 16
+		start r0
+		wait 7
+	next
+
+# The LEDs light up one after the other, then cycle through the colors.
+program rainbow_chase
+	period 20
+	brightness 0
+	keyframes color_cycle_12 1
+	fade 50 50
+	set r0 0
+	loop 16
+		start r0
+		add r0 1
+		wait 5
+	next
+
+# Breathing wave alternating between two colors.
+program breathing_wave
+	period 20
+	brightness 0
+	activate 0xffff
+	loop 0
+		keyframes color_cycle_cyan_breathing 1
+		spread 6
+		fade 50 25
+		wait 250
+		fade 0 25
+		wait 25
+		keyframes color_cycle_violet_breathing 1
+		spread 6
+		fade 50 25
+		wait 250
+		fade 0 25
+		wait 25
+	next
+
+# Sparks fading from white to black on random LEDs, without the leading black keyframe.
+program sparkle
+	period 20
+	brightness 50
+	keyframes color_cycle_spark_1 3 1 4
+	activate 0xffff
+	spread 4
+	loop 0
+		random r0 16
+		start r0
+		random r1 16
+		start r1
+		wait 4
+	next
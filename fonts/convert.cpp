@@ -0,0 +1,219 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2023 Jérémie Galarneau <jeremie.galarneau@gmail.com>
+ */
+
+/*
+ * Font compiler for the badge's proportional fonts.
+ *
+ * Generates the small (one page high) and large (two pages high) fonts from
+ * the classic 5x7 glyphs:
+ *   - blank columns are trimmed from each glyph to make the fonts proportional,
+ *   - the large font is upscaled with Scale2x, which smooths diagonals instead
+ *     of producing the blocky glyphs of a plain pixel doubling.
+ *
+ * Glyphs are laid out in the SSD1306's page/column order (see
+ * nsec::display::font::descriptor) so the firmware can blit them a page byte at
+ * a time.
+ *
+ * Usage:
+ *   g++ -std=c++17 -o convert convert.cpp
+ *   ./convert > ../include/font_data.hpp
+ */
+
+#include "classic_5x7.h"
+
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+struct glyph {
+	unsigned int width;
+	unsigned int height;
+	// Row-major, true when the pixel is lit.
+	std::vector<bool> pixels;
+
+	bool at(int x, int y) const
+	{
+		if (x < 0 || y < 0 || x >= int(width) || y >= int(height)) {
+			return false;
+		}
+
+		return pixels[y * width + x];
+	}
+};
+
+struct font_parameters {
+	std::string name;
+	unsigned int scale;
+	unsigned int page_count;
+	unsigned int spacing;
+	unsigned int space_width;
+};
+
+constexpr unsigned int source_glyph_count = sizeof(source_glyphs) / sizeof(source_glyphs[0]);
+const char last_character = char(source_first_character + source_glyph_count - 1);
+
+glyph trimmed_source_glyph(unsigned int index, unsigned int space_width)
+{
+	const auto *columns = source_glyphs[index];
+	unsigned int first = 0, last = source_glyph_width;
+
+	while (first < last && columns[first] == 0) {
+		first++;
+	}
+
+	while (last > first && columns[last - 1] == 0) {
+		last--;
+	}
+
+	if (first == last) {
+		// Blank glyph (space).
+		return { space_width, source_glyph_height,
+			 std::vector<bool>(space_width * source_glyph_height, false) };
+	}
+
+	glyph trimmed{ last - first, source_glyph_height, {} };
+	for (unsigned int y = 0; y < trimmed.height; y++) {
+		for (unsigned int x = first; x < last; x++) {
+			trimmed.pixels.push_back((columns[x] >> y) & 1);
+		}
+	}
+
+	return trimmed;
+}
+
+/*
+ * Scale2x: each pixel E becomes a 2x2 block. A sub-pixel takes the color of
+ * the two neighbours it touches when they match (and the opposite neighbours
+ * don't), which rounds off the staircases of diagonal strokes.
+ */
+glyph scale2x(const glyph& source)
+{
+	glyph scaled{ source.width * 2, source.height * 2, {} };
+
+	scaled.pixels.resize(scaled.width * scaled.height);
+	for (int y = 0; y < int(source.height); y++) {
+		for (int x = 0; x < int(source.width); x++) {
+			const bool e = source.at(x, y);
+			const bool b = source.at(x, y - 1);
+			const bool d = source.at(x - 1, y);
+			const bool f = source.at(x + 1, y);
+			const bool h = source.at(x, y + 1);
+			const auto set = [&scaled](int sx, int sy, bool value) {
+				scaled.pixels[sy * scaled.width + sx] = value;
+			};
+
+			set(2 * x, 2 * y, (d == b && b != f && d != h) ? d : e);
+			set(2 * x + 1, 2 * y, (b == f && b != d && f != h) ? f : e);
+			set(2 * x, 2 * y + 1, (d == h && d != b && h != f) ? d : e);
+			set(2 * x + 1, 2 * y + 1, (h == f && d != h && b != f) ? f : e);
+		}
+	}
+
+	return scaled;
+}
+
+void emit_header_prologue()
+{
+	std::cout << "/*" << std::endl;
+	// Split the SPDX identifier to avoid confusing the reuse tool
+	std::cout << " * SPDX-License-";
+	std::cout << "Identifier: MIT" << std::endl;
+	std::cout << " *" << std::endl;
+	std::cout << " * Copyright 2023 Jérémie Galarneau <jeremie.galarneau@gmail.com>"
+		  << std::endl;
+	std::cout << " *" << std::endl;
+	std::cout << " * This header was auto-generated; see the fonts folder." << std::endl;
+	std::cout << " */" << std::endl << std::endl;
+
+	std::cout << "#include \"display/font.hpp\"" << std::endl;
+}
+
+void emit_bytes(const std::vector<unsigned int>& values, unsigned int digits)
+{
+	const unsigned int values_per_line = digits == 2 ? 12 : 8;
+
+	for (std::size_t i = 0; i < values.size(); i++) {
+		std::cout << (i % values_per_line == 0 ? "\t" : " ") << "0x" << std::hex
+			  << std::setw(digits) << std::setfill('0') << values[i] << std::dec
+			  << ",";
+		if (i % values_per_line == values_per_line - 1 || i == values.size() - 1) {
+			std::cout << std::endl;
+		}
+	}
+}
+
+void emit_font(const font_parameters& parameters)
+{
+	std::vector<glyph> glyphs;
+	unsigned int atlas_width = 0;
+
+	for (unsigned int i = 0; i < source_glyph_count; i++) {
+		auto current = trimmed_source_glyph(i, parameters.space_width / parameters.scale);
+
+		if (parameters.scale == 2) {
+			current = scale2x(current);
+		}
+
+		atlas_width += current.width;
+		glyphs.push_back(current);
+	}
+
+	std::vector<unsigned int> offsets, atlas(atlas_width * parameters.page_count, 0);
+	unsigned int column = 0;
+
+	for (const auto& current : glyphs) {
+		offsets.push_back(column);
+		for (unsigned int y = 0; y < current.height; y++) {
+			for (unsigned int x = 0; x < current.width; x++) {
+				if (current.at(x, y)) {
+					atlas[(y / 8) * atlas_width + column + x] |= 1 << (y % 8);
+				}
+			}
+		}
+
+		column += current.width;
+	}
+
+	offsets.push_back(atlas_width);
+
+	std::ostringstream report;
+	report << parameters.name << ": " << glyphs.size() << " glyphs, "
+	       << parameters.page_count * 8 << " px high, " << atlas.size()
+	       << " atlas bytes, " << offsets.size() * 2 << " offset bytes";
+	std::cerr << report.str() << std::endl;
+
+	const auto prefix = "nsec_font_" + parameters.name;
+
+	std::cout << std::endl << "// " << report.str() << std::endl;
+	std::cout << "const uint16_t PROGMEM " << prefix << "_glyph_offsets[] = {" << std::endl;
+	emit_bytes(offsets, 4);
+	std::cout << "};" << std::endl << std::endl;
+
+	std::cout << "const uint8_t PROGMEM " << prefix << "_atlas[] = {" << std::endl;
+	emit_bytes(atlas, 2);
+	std::cout << "};" << std::endl << std::endl;
+
+	std::cout << "const nsec::display::font::descriptor nsec::display::font::"
+		  << parameters.name << " PROGMEM = {" << std::endl;
+	std::cout << "\t'" << source_first_character << "', '" << last_character << "', "
+		  << parameters.page_count << ", " << parameters.spacing << ", " << atlas_width
+		  << ", " << prefix << "_glyph_offsets, " << prefix << "_atlas" << std::endl;
+	std::cout << "};" << std::endl;
+}
+} // anonymous namespace
+
+int main()
+{
+	emit_header_prologue();
+	emit_font({ "small", 1, 1, 1, 2 });
+	emit_font({ "large", 2, 2, 2, 4 });
+
+	return 0;
+}
@@ -0,0 +1,456 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2023 Jérémie Galarneau <jeremie.galarneau@gmail.com>
+ *
+ * This header was auto-generated; see the animations folder.
+ */
+
+#include "led/animation.hpp"
+#include "led/interpolation.hpp"
+
+// 39 animations, 94 colors (10 in HSV), 214 keyframes (224 in the sources), 1023 bytes (1120 unpacked)
+const uint8_t PROGMEM nsec_animation_palette[][3] = {
+	{ 0x00, 0x00, 0x00 },
+	{ 0xff, 0xb3, 0xba },
+	{ 0xff, 0xdf, 0xba },
+	{ 0xff, 0xff, 0xba },
+	{ 0xba, 0xff, 0xc9 },
+	{ 0xba, 0xe1, 0xff },
+	{ 0xff, 0xb8, 0x4c },
+	{ 0xf2, 0x66, 0xab },
+	{ 0xa4, 0x59, 0xd1 },
+	{ 0x2c, 0xd3, 0xe1 },
+	{ 0x64, 0x14, 0x00 },
+	{ 0x00, 0xff, 0x00 },
+	{ 0x30, 0x78, 0x13 },
+	{ 0xa1, 0xff, 0xb5 },
+	{ 0xff, 0x80, 0x8c },
+	{ 0xff, 0xbc, 0x6e },
+	{ 0xff, 0xff, 0x6e },
+	{ 0x6e, 0xc0, 0xff },
+	{ 0xff, 0x00, 0x00 },
+	{ 0xff, 0xff, 0xff },
+	{ 0xb4, 0x00, 0xc8 },
+	{ 0x46, 0x00, 0x00 },
+	{ 0x00, 0xff, 0x9f },
+	{ 0x00, 0x8a, 0xc6 },
+	{ 0x7b, 0xb3, 0xff },
+	{ 0xe8, 0x6a, 0xf0 },
+	{ 0x9e, 0x37, 0x9f },
+	{ 0x73, 0xcd, 0xba },
+	{ 0xc6, 0xf0, 0xea },
+	{ 0x4f, 0x91, 0x3e },
+	{ 0xff, 0x80, 0x00 },
+	{ 0xc8, 0x80, 0x00 },
+	{ 0x00, 0xff, 0x80 },
+	{ 0xff, 0xff, 0x33 },
+	{ 0xff, 0x99, 0x33 },
+	{ 0xff, 0x00, 0xff },
+	{ 0x7f, 0x00, 0xff },
+	{ 0x00, 0x00, 0x20 },
+	{ 0xff, 0xcc, 0xcc },
+	{ 0x33, 0x99, 0xff },
+	{ 0x4c, 0x00, 0x99 },
+	{ 0xff, 0x49, 0xdb },
+	{ 0x1c, 0x1c, 0x3e },
+	{ 0x32, 0xf0, 0xff },
+	{ 0xff, 0x81, 0x32 },
+	{ 0x5a, 0x34, 0x7b },
+	{ 0x99, 0x4c, 0x00 },
+	{ 0xff, 0xb2, 0x66 },
+	{ 0x99, 0x00, 0x00 },
+	{ 0xff, 0x66, 0x66 },
+	{ 0x99, 0x99, 0x00 },
+	{ 0xff, 0xff, 0x66 },
+	{ 0x00, 0x99, 0x00 },
+	{ 0x66, 0xff, 0x66 },
+	{ 0x00, 0x99, 0x99 },
+	{ 0x66, 0xff, 0xff },
+	{ 0x66, 0x66, 0xff },
+	{ 0x00, 0x00, 0x99 },
+	{ 0xb2, 0x66, 0xff },
+	{ 0x99, 0x00, 0x99 },
+	{ 0xff, 0x66, 0xff },
+	{ 0xff, 0x32, 0xff },
+	{ 0x14, 0x14, 0x14 },
+	{ 0x19, 0x19, 0x7f },
+	{ 0x32, 0xc8, 0x32 },
+	{ 0x0a, 0x0a, 0x0a },
+	{ 0xc8, 0x32, 0xaa },
+	{ 0x65, 0x4e, 0x92 },
+	{ 0xf9, 0xf5, 0x4b },
+	{ 0x8b, 0xf5, 0xfa },
+	{ 0xfc, 0x73, 0x00 },
+	{ 0x82, 0xcd, 0x47 },
+	{ 0xf9, 0x00, 0xbf },
+	{ 0xf2, 0xe3, 0xdb },
+	{ 0x41, 0x64, 0x4a },
+	{ 0x26, 0x3a, 0x29 },
+	{ 0xe8, 0x6a, 0x33 },
+	{ 0xe4, 0x03, 0x03 },
+	{ 0xff, 0x8c, 0x00 },
+	{ 0xff, 0xed, 0x00 },
+	{ 0x00, 0x80, 0x26 },
+	{ 0x24, 0x40, 0x8e },
+	{ 0x73, 0x29, 0x82 },
+	{ 0x15, 0x04, 0x85 },
+	{ 0xc6, 0x2a, 0x88 },
+	{ 0x03, 0xc4, 0xa1 },
+	{ 0x1f, 0x8a, 0x70 },
+	{ 0xbf, 0xdb, 0x38 },
+	{ 0xe6, 0xee, 0x75 },
+	{ 0xda, 0x49, 0x49 },
+	{ 0x4f, 0x1c, 0x4c },
+	{ 0xa0, 0xc1, 0xb8 },
+	{ 0x71, 0x9f, 0xb0 },
+	{ 0x35, 0x1f, 0x39 },
+};
+
+// HSV colors of the first palette entries, for animations interpolated in HSV.
+const nsec::led::interpolation::hsv_color PROGMEM nsec_animation_palette_hsv[] = {
+	{ 0, 0x00, 0x00 },
+	{ 1512, 0x4c, 0xff },
+	{ 137, 0x45, 0xff },
+	{ 256, 0x45, 0xff },
+	{ 568, 0x45, 0xff },
+	{ 879, 0x45, 0xff },
+	{ 154, 0xb3, 0xff },
+	{ 1409, 0x94, 0xf2 },
+	{ 1184, 0x92, 0xd1 },
+	{ 787, 0xcd, 0xe1 },
+};
+
+const nsec::led::animation::packed_keyframe PROGMEM nsec_animation_keyframes[] = {
+	{ 0x00, 0x00 }, { 0x4d, 0x0a }, { 0x4d, 0x09 }, { 0x4e, 0x01 },
+	{ 0x4e, 0x09 }, { 0x4f, 0x01 }, { 0x4f, 0x09 }, { 0x50, 0x01 },
+	{ 0x50, 0x09 }, { 0x51, 0x01 }, { 0x51, 0x09 }, { 0x52, 0x01 },
+	{ 0x52, 0x09 }, { 0x4d, 0x01 }, { 0x00, 0x00 }, { 0x00, 0x01 },
+	{ 0x53, 0xf9 }, { 0x53, 0xfa }, { 0x00, 0x32 }, { 0x00, 0x4b },
+	{ 0x54, 0xfa }, { 0x54, 0xfa }, { 0x00, 0x32 }, { 0x00, 0x32 },
+	{ 0x55, 0xfa }, { 0x55, 0xfa }, { 0x00, 0x32 }, { 0x00, 0x32 },
+	{ 0x00, 0x00 }, { 0x00, 0x01 }, { 0x56, 0xf9 }, { 0x56, 0xfa },
+	{ 0x00, 0x32 }, { 0x00, 0x4b }, { 0x57, 0xfa }, { 0x57, 0xfa },
+	{ 0x00, 0x32 }, { 0x00, 0x32 }, { 0x46, 0xfa }, { 0x46, 0xfa },
+	{ 0x00, 0x32 }, { 0x00, 0x32 }, { 0x00, 0x00 }, { 0x00, 0x01 },
+	{ 0x00, 0x63 }, { 0x3d, 0x32 }, { 0x3e, 0x32 }, { 0x3e, 0x32 },
+	{ 0x3f, 0x32 }, { 0x00, 0x64 }, { 0x00, 0xc8 }, { 0x00, 0x00 },
+	{ 0x00, 0x01 }, { 0x00, 0x63 }, { 0x40, 0x32 }, { 0x41, 0x32 },
+	{ 0x41, 0x32 }, { 0x42, 0x32 }, { 0x00, 0x64 }, { 0x00, 0xc8 },
+	{ 0x00, 0x00 }, { 0x0d, 0x01 }, { 0x0e, 0x01 }, { 0x0f, 0x01 },
+	{ 0x10, 0x01 }, { 0x11, 0x01 }, { 0x0d, 0x01 }, { 0x00, 0x00 },
+	{ 0x29, 0x01 }, { 0x2a, 0xf9 }, { 0x2b, 0xfa }, { 0x2c, 0xfa },
+	{ 0x2d, 0xfa }, { 0x29, 0xfa }, { 0x00, 0x00 }, { 0x01, 0x01 },
+	{ 0x02, 0xf9 }, { 0x03, 0xfa }, { 0x04, 0xfa }, { 0x05, 0xfa },
+	{ 0x01, 0xfa }, { 0x00, 0x00 }, { 0x13, 0x01 }, { 0x14, 0x03 },
+	{ 0x15, 0x05 }, { 0x00, 0x06 }, { 0x00, 0x23 }, { 0x00, 0x00 },
+	{ 0x26, 0x01 }, { 0x27, 0x03 }, { 0x28, 0x05 }, { 0x00, 0x06 },
+	{ 0x00, 0x23 }, { 0x00, 0x00 }, { 0x49, 0x01 }, { 0x4a, 0x01 },
+	{ 0x4b, 0x01 }, { 0x4c, 0x01 }, { 0x49, 0x01 }, { 0x00, 0x00 },
+	{ 0x06, 0x01 }, { 0x07, 0x01 }, { 0x08, 0x01 }, { 0x09, 0x01 },
+	{ 0x06, 0x01 }, { 0x00, 0x00 }, { 0x58, 0x01 }, { 0x59, 0x03 },
+	{ 0x5a, 0x05 }, { 0x00, 0x06 }, { 0x00, 0x23 }, { 0x00, 0x00 },
+	{ 0x5b, 0x01 }, { 0x5c, 0x03 }, { 0x5d, 0x05 }, { 0x00, 0x06 },
+	{ 0x00, 0x23 }, { 0x0a, 0x00 }, { 0x00, 0x02 }, { 0x0b, 0x02 },
+	{ 0x0c, 0x04 }, { 0x0b, 0x04 }, { 0x18, 0x00 }, { 0x19, 0x05 },
+	{ 0x1a, 0x05 }, { 0x00, 0x03 }, { 0x00, 0x25 }, { 0x1b, 0x00 },
+	{ 0x1c, 0x05 }, { 0x1d, 0x05 }, { 0x00, 0x03 }, { 0x00, 0x25 },
+	{ 0x20, 0x00 }, { 0x21, 0x05 }, { 0x22, 0x05 }, { 0x00, 0x03 },
+	{ 0x00, 0x25 }, { 0x23, 0x00 }, { 0x24, 0x05 }, { 0x25, 0x05 },
+	{ 0x00, 0x03 }, { 0x00, 0x25 }, { 0x00, 0x00 }, { 0x12, 0x01 },
+	{ 0x00, 0x01 }, { 0x12, 0x01 }, { 0x16, 0x00 }, { 0x17, 0x09 },
+	{ 0x00, 0x06 }, { 0x00, 0x23 }, { 0x1e, 0x00 }, { 0x1f, 0x06 },
+	{ 0x00, 0x07 }, { 0x00, 0x25 }, { 0x00, 0x00 }, { 0x13, 0x01 },
+	{ 0x12, 0xf9 }, { 0x13, 0xfa }, { 0x00, 0x00 }, { 0x2e, 0x01 },
+	{ 0x2f, 0xf9 }, { 0x2e, 0xfa }, { 0x00, 0x00 }, { 0x30, 0x01 },
+	{ 0x31, 0xf9 }, { 0x30, 0xfa }, { 0x00, 0x00 }, { 0x32, 0x01 },
+	{ 0x33, 0xf9 }, { 0x32, 0xfa }, { 0x00, 0x00 }, { 0x34, 0x01 },
+	{ 0x35, 0xf9 }, { 0x34, 0xfa }, { 0x00, 0x00 }, { 0x36, 0x01 },
+	{ 0x37, 0xf9 }, { 0x36, 0xfa }, { 0x00, 0x00 }, { 0x38, 0x01 },
+	{ 0x39, 0xf9 }, { 0x38, 0xfa }, { 0x00, 0x00 }, { 0x28, 0x01 },
+	{ 0x3a, 0xf9 }, { 0x28, 0xfa }, { 0x00, 0x00 }, { 0x3b, 0x01 },
+	{ 0x3c, 0xf9 }, { 0x3b, 0xfa }, { 0x00, 0x00 }, { 0x13, 0x01 },
+	{ 0x43, 0xf9 }, { 0x13, 0xfa }, { 0x00, 0x00 }, { 0x13, 0x01 },
+	{ 0x44, 0xf9 }, { 0x13, 0xfa }, { 0x00, 0x00 }, { 0x13, 0x01 },
+	{ 0x45, 0xf9 }, { 0x13, 0xfa }, { 0x00, 0x00 }, { 0x13, 0x01 },
+	{ 0x46, 0xf9 }, { 0x13, 0xfa }, { 0x00, 0x00 }, { 0x13, 0x01 },
+	{ 0x47, 0xf9 }, { 0x13, 0xfa }, { 0x00, 0x00 }, { 0x13, 0x01 },
+	{ 0x48, 0xf9 }, { 0x13, 0xfa },
+};
+
+// red_to_green_progress_bar: 5 keyframes, 250 ms steps
+const nsec::led::animation::descriptor PROGMEM nsec_animation_red_to_green_progress_bar = {
+	&nsec_animation_keyframes[117], 5, 250,
+	nsec::led::animation::color_space::RGB
+};
+
+// happy_clown_barf: 7 keyframes, 100 ms steps
+const nsec::led::animation::descriptor PROGMEM nsec_animation_happy_clown_barf = {
+	&nsec_animation_keyframes[60], 7, 100,
+	nsec::led::animation::color_space::RGB
+};
+
+// no_new_friends: 4 keyframes, 200 ms steps
+const nsec::led::animation::descriptor PROGMEM nsec_animation_no_new_friends = {
+	&nsec_animation_keyframes[142], 4, 200,
+	nsec::led::animation::color_space::RGB
+};
+
+// shooting_star_tungsten: 6 keyframes, 100 ms steps
+const nsec::led::animation::descriptor PROGMEM nsec_animation_shooting_star_tungsten = {
+	&nsec_animation_keyframes[81], 6, 100,
+	nsec::led::animation::color_space::RGB
+};
+
+// shooting_star_2: 4 keyframes, 100 ms steps
+const nsec::led::animation::descriptor PROGMEM nsec_animation_shooting_star_2 = {
+	&nsec_animation_keyframes[146], 4, 100,
+	nsec::led::animation::color_space::RGB
+};
+
+// shooting_star_3: 5 keyframes, 100 ms steps
+const nsec::led::animation::descriptor PROGMEM nsec_animation_shooting_star_3 = {
+	&nsec_animation_keyframes[122], 5, 100,
+	nsec::led::animation::color_space::RGB
+};
+
+// shooting_star_4: 5 keyframes, 100 ms steps
+const nsec::led::animation::descriptor PROGMEM nsec_animation_shooting_star_4 = {
+	&nsec_animation_keyframes[127], 5, 100,
+	nsec::led::animation::color_space::RGB
+};
+
+// shooting_star_5: 4 keyframes, 100 ms steps
+const nsec::led::animation::descriptor PROGMEM nsec_animation_shooting_star_5 = {
+	&nsec_animation_keyframes[150], 4, 100,
+	nsec::led::animation::color_space::RGB
+};
+
+// shooting_star_6: 5 keyframes, 100 ms steps
+const nsec::led::animation::descriptor PROGMEM nsec_animation_shooting_star_6 = {
+	&nsec_animation_keyframes[132], 5, 100,
+	nsec::led::animation::color_space::RGB
+};
+
+// shooting_star_7: 5 keyframes, 100 ms steps
+const nsec::led::animation::descriptor PROGMEM nsec_animation_shooting_star_7 = {
+	&nsec_animation_keyframes[137], 5, 100,
+	nsec::led::animation::color_space::RGB
+};
+
+// shooting_star_8: 6 keyframes, 100 ms steps
+const nsec::led::animation::descriptor PROGMEM nsec_animation_shooting_star_8 = {
+	&nsec_animation_keyframes[87], 6, 100,
+	nsec::led::animation::color_space::RGB
+};
+
+// color_cycle_1: 7 keyframes, 4 ms steps, times rounded up by at most 3 ms
+const nsec::led::animation::descriptor PROGMEM nsec_animation_color_cycle_1 = {
+	&nsec_animation_keyframes[67], 7, 4,
+	nsec::led::animation::color_space::RGB
+};
+
+// color_cycle_2: 4 keyframes, 4 ms steps, times rounded up by at most 3 ms
+const nsec::led::animation::descriptor PROGMEM nsec_animation_color_cycle_2 = {
+	&nsec_animation_keyframes[154], 4, 4,
+	nsec::led::animation::color_space::RGB
+};
+
+// color_cycle_3: 7 keyframes, 4 ms steps, times rounded up by at most 3 ms
+const nsec::led::animation::descriptor PROGMEM nsec_animation_color_cycle_3 = {
+	&nsec_animation_keyframes[74], 7, 4,
+	nsec::led::animation::color_space::HSV
+};
+
+// color_cycle_orange_breathing: 4 keyframes, 8 ms steps, times rounded up by at most 7 ms
+const nsec::led::animation::descriptor PROGMEM nsec_animation_color_cycle_orange_breathing = {
+	&nsec_animation_keyframes[158], 4, 8,
+	nsec::led::animation::color_space::RGB
+};
+
+// color_cycle_red_breathing: 4 keyframes, 8 ms steps, times rounded up by at most 7 ms
+const nsec::led::animation::descriptor PROGMEM nsec_animation_color_cycle_red_breathing = {
+	&nsec_animation_keyframes[162], 4, 8,
+	nsec::led::animation::color_space::RGB
+};
+
+// color_cycle_yellow_breathing: 4 keyframes, 8 ms steps, times rounded up by at most 7 ms
+const nsec::led::animation::descriptor PROGMEM nsec_animation_color_cycle_yellow_breathing = {
+	&nsec_animation_keyframes[166], 4, 8,
+	nsec::led::animation::color_space::RGB
+};
+
+// color_cycle_green_breathing: 4 keyframes, 8 ms steps, times rounded up by at most 7 ms
+const nsec::led::animation::descriptor PROGMEM nsec_animation_color_cycle_green_breathing = {
+	&nsec_animation_keyframes[170], 4, 8,
+	nsec::led::animation::color_space::RGB
+};
+
+// color_cycle_cyan_breathing: 4 keyframes, 8 ms steps, times rounded up by at most 7 ms
+const nsec::led::animation::descriptor PROGMEM nsec_animation_color_cycle_cyan_breathing = {
+	&nsec_animation_keyframes[174], 4, 8,
+	nsec::led::animation::color_space::RGB
+};
+
+// color_cycle_blue_breathing: 4 keyframes, 8 ms steps, times rounded up by at most 7 ms
+const nsec::led::animation::descriptor PROGMEM nsec_animation_color_cycle_blue_breathing = {
+	&nsec_animation_keyframes[178], 4, 8,
+	nsec::led::animation::color_space::RGB
+};
+
+// color_cycle_violet_breathing: 4 keyframes, 8 ms steps, times rounded up by at most 7 ms
+const nsec::led::animation::descriptor PROGMEM nsec_animation_color_cycle_violet_breathing = {
+	&nsec_animation_keyframes[182], 4, 8,
+	nsec::led::animation::color_space::RGB
+};
+
+// color_cycle_pink_breathing: 4 keyframes, 8 ms steps, times rounded up by at most 7 ms
+const nsec::led::animation::descriptor PROGMEM nsec_animation_color_cycle_pink_breathing = {
+	&nsec_animation_keyframes[186], 4, 8,
+	nsec::led::animation::color_space::RGB
+};
+
+// color_cycle_white_breathing: 4 keyframes, 8 ms steps, times rounded up by at most 7 ms
+const nsec::led::animation::descriptor PROGMEM nsec_animation_color_cycle_white_breathing = {
+	&nsec_animation_keyframes[158], 4, 8,
+	nsec::led::animation::color_space::RGB
+};
+
+// color_cycle_magenta_blue_hb: 9 keyframes, 2 ms steps, times rounded up by at most 1 ms
+const nsec::led::animation::descriptor PROGMEM nsec_animation_color_cycle_magenta_blue_hb = {
+	&nsec_animation_keyframes[42], 9, 2,
+	nsec::led::animation::color_space::RGB
+};
+
+// color_cycle_green_pink_hb: 9 keyframes, 2 ms steps, times rounded up by at most 1 ms
+const nsec::led::animation::descriptor PROGMEM nsec_animation_color_cycle_green_pink_hb = {
+	&nsec_animation_keyframes[51], 9, 2,
+	nsec::led::animation::color_space::RGB
+};
+
+// color_cycle_4: 4 keyframes, 4 ms steps, times rounded up by at most 3 ms
+const nsec::led::animation::descriptor PROGMEM nsec_animation_color_cycle_4 = {
+	&nsec_animation_keyframes[190], 4, 4,
+	nsec::led::animation::color_space::RGB
+};
+
+// color_cycle_5: 4 keyframes, 4 ms steps, times rounded up by at most 3 ms
+const nsec::led::animation::descriptor PROGMEM nsec_animation_color_cycle_5 = {
+	&nsec_animation_keyframes[194], 4, 4,
+	nsec::led::animation::color_space::RGB
+};
+
+// color_cycle_6: 4 keyframes, 4 ms steps, times rounded up by at most 3 ms
+const nsec::led::animation::descriptor PROGMEM nsec_animation_color_cycle_6 = {
+	&nsec_animation_keyframes[198], 4, 4,
+	nsec::led::animation::color_space::RGB
+};
+
+// color_cycle_7: 4 keyframes, 4 ms steps, times rounded up by at most 3 ms
+const nsec::led::animation::descriptor PROGMEM nsec_animation_color_cycle_7 = {
+	&nsec_animation_keyframes[202], 4, 4,
+	nsec::led::animation::color_space::RGB
+};
+
+// color_cycle_8: 4 keyframes, 4 ms steps, times rounded up by at most 3 ms
+const nsec::led::animation::descriptor PROGMEM nsec_animation_color_cycle_8 = {
+	&nsec_animation_keyframes[206], 4, 4,
+	nsec::led::animation::color_space::RGB
+};
+
+// color_cycle_9: 4 keyframes, 4 ms steps, times rounded up by at most 3 ms
+const nsec::led::animation::descriptor PROGMEM nsec_animation_color_cycle_9 = {
+	&nsec_animation_keyframes[210], 4, 4,
+	nsec::led::animation::color_space::RGB
+};
+
+// color_cycle_10: 6 keyframes, 100 ms steps
+const nsec::led::animation::descriptor PROGMEM nsec_animation_color_cycle_10 = {
+	&nsec_animation_keyframes[93], 6, 100,
+	nsec::led::animation::color_space::RGB
+};
+
+// color_cycle_11: 6 keyframes, 100 ms steps
+const nsec::led::animation::descriptor PROGMEM nsec_animation_color_cycle_11 = {
+	&nsec_animation_keyframes[99], 6, 100,
+	nsec::led::animation::color_space::HSV
+};
+
+// color_cycle_12: 14 keyframes, 50 ms steps
+const nsec::led::animation::descriptor PROGMEM nsec_animation_color_cycle_12 = {
+	&nsec_animation_keyframes[0], 14, 50,
+	nsec::led::animation::color_space::RGB
+};
+
+// color_cycle_13: 14 keyframes, 2 ms steps, times rounded up by at most 1 ms
+const nsec::led::animation::descriptor PROGMEM nsec_animation_color_cycle_13 = {
+	&nsec_animation_keyframes[14], 14, 2,
+	nsec::led::animation::color_space::RGB
+};
+
+// color_cycle_14: 14 keyframes, 2 ms steps, times rounded up by at most 1 ms
+const nsec::led::animation::descriptor PROGMEM nsec_animation_color_cycle_14 = {
+	&nsec_animation_keyframes[28], 14, 2,
+	nsec::led::animation::color_space::RGB
+};
+
+// color_cycle_spark_1: 6 keyframes, 100 ms steps
+const nsec::led::animation::descriptor PROGMEM nsec_animation_color_cycle_spark_1 = {
+	&nsec_animation_keyframes[81], 6, 100,
+	nsec::led::animation::color_space::RGB
+};
+
+// color_cycle_spark_2: 6 keyframes, 100 ms steps
+const nsec::led::animation::descriptor PROGMEM nsec_animation_color_cycle_spark_2 = {
+	&nsec_animation_keyframes[105], 6, 100,
+	nsec::led::animation::color_space::RGB
+};
+
+// color_cycle_spark_3: 6 keyframes, 100 ms steps
+const nsec::led::animation::descriptor PROGMEM nsec_animation_color_cycle_spark_3 = {
+	&nsec_animation_keyframes[111], 6, 100,
+	nsec::led::animation::color_space::RGB
+};
+
+// Animations by index, for LED programs.
+const nsec::led::animation::descriptor *const PROGMEM nsec_animations[] = {
+	&nsec_animation_red_to_green_progress_bar,
+	&nsec_animation_happy_clown_barf,
+	&nsec_animation_no_new_friends,
+	&nsec_animation_shooting_star_tungsten,
+	&nsec_animation_shooting_star_2,
+	&nsec_animation_shooting_star_3,
+	&nsec_animation_shooting_star_4,
+	&nsec_animation_shooting_star_5,
+	&nsec_animation_shooting_star_6,
+	&nsec_animation_shooting_star_7,
+	&nsec_animation_shooting_star_8,
+	&nsec_animation_color_cycle_1,
+	&nsec_animation_color_cycle_2,
+	&nsec_animation_color_cycle_3,
+	&nsec_animation_color_cycle_orange_breathing,
+	&nsec_animation_color_cycle_red_breathing,
+	&nsec_animation_color_cycle_yellow_breathing,
+	&nsec_animation_color_cycle_green_breathing,
+	&nsec_animation_color_cycle_cyan_breathing,
+	&nsec_animation_color_cycle_blue_breathing,
+	&nsec_animation_color_cycle_violet_breathing,
+	&nsec_animation_color_cycle_pink_breathing,
+	&nsec_animation_color_cycle_white_breathing,
+	&nsec_animation_color_cycle_magenta_blue_hb,
+	&nsec_animation_color_cycle_green_pink_hb,
+	&nsec_animation_color_cycle_4,
+	&nsec_animation_color_cycle_5,
+	&nsec_animation_color_cycle_6,
+	&nsec_animation_color_cycle_7,
+	&nsec_animation_color_cycle_8,
+	&nsec_animation_color_cycle_9,
+	&nsec_animation_color_cycle_10,
+	&nsec_animation_color_cycle_11,
+	&nsec_animation_color_cycle_12,
+	&nsec_animation_color_cycle_13,
+	&nsec_animation_color_cycle_14,
+	&nsec_animation_color_cycle_spark_1,
+	&nsec_animation_color_cycle_spark_2,
+	&nsec_animation_color_cycle_spark_3,
+};
@@ -18,6 +18,7 @@
 #include "display/string_property_editor.hpp"
 #include "display/text.hpp"
 #include "led/strip_animator.hpp"
+#include "network/id_exchanger.hpp"
 #include "network/network_handler.hpp"
 #include "ringbuffer.hpp"
 
@@ -43,6 +44,8 @@ public:
 	void relase_focus_current_screen() noexcept;
 	void on_splash_complete() noexcept;
 	uint8_t level() const noexcept;
+	// Last 4 bytes of the board's unique ID, exchanged with our peers.
+	uint32_t id() const noexcept;
 	bool is_connected() const noexcept;
 
 	void on_disconnection() noexcept;
@@ -52,7 +55,13 @@ public:
 	nsec::communication::network_handler::application_message_action
 	on_message_received(communication::message::type message_type,
 			    const uint8_t *message) noexcept;
-	void on_app_message_sent() noexcept;
+	enum class badge_discovered_result : uint8_t { NEW, ALREADY_KNOWN };
+	badge_discovered_result on_badge_discovered(uint32_t id) noexcept;
+	void on_badge_discovery_completed() noexcept;
+	// No byte is expected from our peers for a while.
+	void on_network_quiet_window() noexcept;
+	void on_network_time_offset_changed(uint32_t network_time_offset_ms) noexcept;
+	bool is_network_line_quiet() noexcept;
 
 	void apply_score_change(uint8_t new_badges_discovered_count) noexcept;
 	void show_badge_info() noexcept;
@@ -70,35 +79,6 @@ private:
 		ANIMATE_PAIRING_COMPLETED,
 		IDLE,
 	};
-	class network_id_exchanger {
-	public:
-		network_id_exchanger() = default;
-
-		network_id_exchanger(const network_id_exchanger&) = delete;
-		network_id_exchanger(network_id_exchanger&&) = delete;
-		network_id_exchanger& operator=(const network_id_exchanger&) = delete;
-		network_id_exchanger& operator=(network_id_exchanger&&) = delete;
-		~network_id_exchanger() = default;
-
-		void start(badge&) noexcept;
-		void new_message(badge& badge,
-				 nsec::communication::message::type msg_type,
-				 const uint8_t *payload) noexcept;
-		void message_sent(badge& badge) noexcept;
-		void reset() noexcept;
-		uint8_t new_badges_discovered() const noexcept
-		{
-			return uint8_t(_new_badges_discovered);
-		}
-
-	private:
-		uint8_t _new_badges_discovered : 5;
-		uint8_t _message_received_count : 5;
-		bool _send_ours_on_next_send_complete : 1;
-		uint8_t _direction : 1;
-		bool _done_after_sending_ours : 1;
-	};
-
 	class pairing_animator {
 	public:
 		pairing_animator();
@@ -187,11 +167,6 @@ private:
 
 	void set_focused_screen(display::screen& focused_screen) noexcept;
 
-	// Handle network events
-	enum class badge_discovered_result : uint8_t { NEW, ALREADY_KNOWN };
-	badge_discovered_result on_badge_discovered(const uint8_t *id) noexcept;
-	void on_badge_discovery_completed() noexcept;
-
 	network_app_state _network_app_state() const noexcept;
 	void _network_app_state(network_app_state) noexcept;
 
@@ -228,7 +203,7 @@ private:
 
 	// network
 	communication::network_handler _network_handler;
-	network_id_exchanger _id_exchanger;
+	communication::id_exchanger _id_exchanger;
 	pairing_animator _pairing_animator;
 	pairing_completed_animator _pairing_completed_animator;
 
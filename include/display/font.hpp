@@ -0,0 +1,67 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2023 Jérémie Galarneau <jeremie.galarneau@gmail.com>
+ */
+
+#ifndef NSEC_DISPLAY_FONT_HPP
+#define NSEC_DISPLAY_FONT_HPP
+
+#include "Adafruit_SSD1306.h"
+
+namespace nsec::display::font {
+
+/*
+ * Proportional font stored in program memory (see the fonts folder).
+ *
+ * Glyphs are pre-rendered in the SSD1306's page layout and packed side by
+ * side in an atlas: one row of glyph columns per page, each byte holding 8
+ * vertical pixels (LSB on top). This allows glyphs to be blitted a page byte
+ * at a time, provided they are drawn on a page boundary.
+ */
+struct descriptor {
+	// Characters covered by the font (inclusive range).
+	char first_character;
+	char last_character;
+	// Glyph height, in pages.
+	uint8_t page_count;
+	// Blank columns drawn after each glyph.
+	uint8_t spacing;
+	// Columns in each page of the atlas.
+	uint16_t atlas_width;
+	// Atlas column of each glyph, followed by the atlas width.
+	const uint16_t *glyph_offsets;
+	const uint8_t *atlas;
+};
+
+// Descriptors live in program memory.
+extern const descriptor small PROGMEM;
+extern const descriptor large PROGMEM;
+
+uint8_t page_count(const descriptor& font) noexcept;
+
+// Horizontal advance of a character, including spacing.
+uint8_t character_width(const descriptor& font, char character) noexcept;
+
+uint16_t string_width(const descriptor& font, const char *str) noexcept;
+uint16_t string_width(const descriptor& font, const __FlashStringHelper *str) noexcept;
+
+/*
+ * Draw a character at column x (may be negative) of a page and return the
+ * position of the next character.
+ *
+ * The glyph box, spacing included, is overwritten: lit pixels are drawn in
+ * color and the rest in the opposite color. Columns outside of [0, clip_x)
+ * are left untouched.
+ */
+int16_t draw_character(Adafruit_SSD1306& canvas,
+		       const descriptor& font,
+		       char character,
+		       int16_t x,
+		       uint8_t page,
+		       uint8_t color,
+		       int16_t clip_x) noexcept;
+
+} // namespace nsec::display::font
+
+#endif // NSEC_DISPLAY_FONT_HPP
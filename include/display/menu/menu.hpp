@@ -67,11 +67,13 @@ public:
 	void button_event(button::id id, button::event event) noexcept override;
 	void _render(scheduling::absolute_time_ms current_time_ms,
 		    Adafruit_SSD1306& canvas) noexcept override;
+	void focused() noexcept override;
 
 	void set_choices(const choices& new_choices) noexcept
 	{
 		_choices = &new_choices;
 		_layout_constraints_initialized = false;
+		_full_redraw_needed = true;
 		_active_choice_idx = 0;
 		_first_drawn_choice_index = 0;
 	}
@@ -80,8 +82,22 @@ private:
 	void _initialize_layout_constraints(Adafruit_SSD1306& canvas) noexcept;
 	bool _is_choice_offscreen(unsigned int choice) const noexcept;
 
+	// One bit per line of the screen, the top line being the LSB.
+	using line_mask = uint8_t;
+
+	line_mask _line_mask_of_choice(unsigned int choice) const noexcept;
+	void _shift_lines(Adafruit_SSD1306& canvas, int line_count) const noexcept;
+	void _render_line(Adafruit_SSD1306& canvas,
+			  uint8_t line,
+			  bool reserve_indicator_column) const noexcept;
+	void _flush_lines(Adafruit_SSD1306& canvas, line_mask lines) const noexcept;
+
 	const choices *_choices = nullptr;
 	bool _layout_constraints_initialized : 1;
+	// Set when the content on screen can't be reused (focus change, new choices).
+	bool _full_redraw_needed : 1;
+	// Whether the scroll indicators' column was reserved during the last render.
+	bool _drawn_with_indicators : 1;
 	struct {
 		struct {
 			unsigned int width : 5;
@@ -92,6 +108,9 @@ private:
 	} _layout_constraints;
 	unsigned int _active_choice_idx : 7;
 	unsigned int _first_drawn_choice_index:7;
+	// State of the content currently on screen, used to find damaged lines.
+	unsigned int _drawn_active_choice_idx : 7;
+	unsigned int _drawn_first_choice_index : 7;
 };
 } // namespace nsec::display
 
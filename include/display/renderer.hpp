@@ -28,6 +28,15 @@ public:
 
 	void setup() noexcept;
 
+	// Refresh period governor inputs.
+	void network_activity(bool active) noexcept;
+
+	/*
+	 * Signal user activity, turning the display back on if needed. Returns
+	 * true if the display was off; the last frame is shown again.
+	 */
+	bool wake() noexcept;
+
 protected:
 	void run(scheduling::absolute_time_ms current_time_ms) noexcept override;
 
@@ -37,9 +46,37 @@ private:
 		return **_focused_screen;
 	}
 
+	struct refresh_period_bounds {
+		scheduling::relative_time_ms min;
+		scheduling::relative_time_ms max;
+	};
+
+	refresh_period_bounds _refresh_period_bounds() const noexcept;
+	void _govern_refresh_period() noexcept;
+
+	// The display is dimmed, then turned off, after a period of inactivity.
+	enum class power_state : uint8_t {
+		ON,
+		DIMMED,
+		OFF,
+	};
+
+	power_state _power_state() const noexcept
+	{
+		return static_cast<power_state>(_current_power_state);
+	}
+
+	void _update_power_state(scheduling::absolute_time_ms current_time_ms) noexcept;
+
 	uint8_t _frameBuffer[SCREEN_WIDTH * ((SCREEN_HEIGHT + 7) / 8)];
 	Adafruit_SSD1306 _display;
-	uint8_t _render_time_sampling_counter;
+	// Moving average of the time spent rendering and flushing during a tick.
+	uint16_t _average_render_time_us;
+	bool _network_activity : 1;
+	uint8_t _current_power_state : 2;
+	// Activity was signaled since the last tick.
+	bool _activity_pending : 1;
+	scheduling::absolute_time_ms _last_activity_time_ms;
 
 	screen **const _focused_screen;
 };
@@ -59,6 +59,19 @@ public:
 		return _cleared_on_every_frame;
 	}
 
+	// Kind of content shown by the screen, used to pick the renderer's refresh period.
+	enum class content_type : uint8_t {
+		// Only changes in reaction to events (e.g. button presses).
+		STATIC,
+		// Continuously scrolling content.
+		SCROLLING,
+	};
+
+	content_type content() const noexcept
+	{
+		return static_cast<content_type>(_content_type);
+	}
+
 protected:
 	// Rendering method implemented by derived classes
 	virtual void _render(scheduling::absolute_time_ms current_time_ms,
@@ -85,6 +98,7 @@ protected:
 	// A screen is only redrawn if it is damaged
 	bool _is_damaged : 1;
 	bool _cleared_on_every_frame : 1;
+	uint8_t _content_type : 2;
 };
 } // namespace nsec::display
 
@@ -33,7 +33,9 @@ public:
 	void focused() noexcept override;
 
 private:
-	void _initialize_layout(Adafruit_SSD1306& canvas) noexcept;
+	int16_t _draw_property(Adafruit_SSD1306& canvas, int16_t x, uint8_t page) const noexcept;
+	int16_t _draw_separator(Adafruit_SSD1306& canvas, int16_t x, uint8_t page) const noexcept;
+	uint16_t _separator_rendered_width() const noexcept;
 
 	struct {
 		union {
@@ -41,41 +43,13 @@ private:
 			const __FlashStringHelper *flash_value;
 		};
 		bool is_value_in_ram : 1;
-		uint8_t renderable_character_count : 7;
+		// Width of the property when rendered with the scroll font.
+		uint16_t rendered_width : 15;
 	} _property;
 
-	enum class render_state {
-		FRAME_SETUP = 0,
-		FIRST_VISIBLE_CHARACTER_RENDERING = 1,
-		VISIBLE_CHARACTER_CHUNK_RENDERING = 2,
-		SEPARATOR_RENDERING = 3,
-	};
-
-	render_state _render_state() const noexcept
-	{
-		return static_cast<render_state>(_frame_render_state);
-	}
-
-	void _render_state(render_state state) noexcept
-	{
-		_frame_render_state = static_cast<uint8_t>(state);
-		if (state == render_state::FRAME_SETUP ||
-		    state == render_state::SEPARATOR_RENDERING) {
-			_current_character_offset = 0;
-		}
-	}
-
-	char _property_character_at_offset(uint8_t offset) const noexcept;
-	void _render_current_property_character(Adafruit_SSD1306& canvas) const noexcept;
-	void _render_separator(Adafruit_SSD1306& canvas) noexcept;
-	uint16_t _separator_rendered_width() const noexcept;
-
-	bool _layout_initialized : 1;
-	unsigned int _scroll_character_width : 5;
-	unsigned int _scroll_character_y_offset : 5;
-	uint8_t _frame_render_state : 2;
-	bool _closely_repeat_string = false;
-	uint8_t _current_character_offset;
+	bool _closely_repeat_string : 1;
+	// Set when the pages around the text must be cleared and pushed to the display.
+	bool _full_flush_needed : 1;
 };
 } // namespace nsec::display
 
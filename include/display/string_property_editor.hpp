@@ -68,7 +68,6 @@ private:
 	uint8_t _focused_character;
 	uint8_t _first_drawn_character;
 	bool _layout_initialized : 1;
-	unsigned int _prompt_characters_per_screen : 5;
 	unsigned int _edit_characters_per_screen : 5;
 	unsigned int _edit_character_width : 5;
 	unsigned int _edit_character_height : 5;
@@ -8,24 +8,31 @@
 #define NSEC_DISPLAY_UTILS_HPP
 
 #include "Adafruit_SSD1306.h"
+#include "display/font.hpp"
 
 namespace nsec::display::utils {
 
 /*
- * Assumes the cursor position is already set.
- * Hand-rolled since the canvas Print interface does not allow us to bound the
- * printed length of a string stored in program memory.
+ * Draw a string with a proportional font starting at the cursor position (the
+ * cursor's y coordinate is rounded down to a page boundary) and advance the
+ * cursor.
+ *
+ * The string is clipped to max_width pixels. When it doesn't fit and an
+ * ellipsis is requested, the characters that don't fit are replaced by "...".
  */
 void draw_string(Adafruit_SSD1306& canvas,
+		 const font::descriptor& font,
 		 const char *str,
-		 uint8_t max_char_count,
+		 uint8_t max_width,
+		 uint8_t color = SSD1306_WHITE,
 		 bool draw_ellipsis_if_too_long = true) noexcept;
 void draw_string(Adafruit_SSD1306& canvas,
+		 const font::descriptor& font,
 		 const __FlashStringHelper *str,
-		 uint8_t max_char_count,
+		 uint8_t max_width,
+		 uint8_t color = SSD1306_WHITE,
 		 bool draw_ellipsis_if_too_long = true) noexcept;
 
-
 enum class arrow_glyph_direction { UP, DOWN, LEFT, RIGHT };
 
 /*
@@ -40,6 +47,18 @@ void draw_arrow_glyph(Adafruit_SSD1306& canvas,
 		      uint8_t glyph_color,
 		      arrow_glyph_direction direction);
 
+/*
+ * Decode a PackBits-compressed bitmap produced by the asset compiler (see the
+ * logo folder) directly into the canvas' frame buffer.
+ *
+ * The bitmap is placed at column x of the given page (8-pixel row), and
+ * overwrites the area it covers. Caller must ensure it fits on the canvas.
+ */
+void draw_packed_bitmap(Adafruit_SSD1306& canvas,
+			uint8_t x,
+			uint8_t page,
+			const uint8_t *packed_bitmap) noexcept;
+
 } // namespace nsec::display
 
 #endif // NSEC_DISPLAY_UTILS_SCREEN_HPP
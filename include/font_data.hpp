@@ -0,0 +1,232 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2023 Jérémie Galarneau <jeremie.galarneau@gmail.com>
+ *
+ * This header was auto-generated; see the fonts folder.
+ */
+
+#include "display/font.hpp"
+
+// small: 95 glyphs, 8 px high, 421 atlas bytes, 192 offset bytes
+const uint16_t PROGMEM nsec_font_small_glyph_offsets[] = {
+	0x0000, 0x0002, 0x0003, 0x0006, 0x000b, 0x0010, 0x0015, 0x001a,
+	0x001c, 0x001f, 0x0022, 0x0027, 0x002c, 0x002e, 0x0033, 0x0035,
+	0x003a, 0x003f, 0x0042, 0x0047, 0x004c, 0x0051, 0x0056, 0x005b,
+	0x0060, 0x0065, 0x006a, 0x006c, 0x006e, 0x0072, 0x0077, 0x007b,
+	0x0080, 0x0085, 0x008a, 0x008f, 0x0094, 0x0099, 0x009e, 0x00a3,
+	0x00a8, 0x00ad, 0x00b0, 0x00b5, 0x00ba, 0x00bf, 0x00c4, 0x00c9,
+	0x00ce, 0x00d3, 0x00d8, 0x00dd, 0x00e2, 0x00e7, 0x00ec, 0x00f1,
+	0x00f6, 0x00fb, 0x0100, 0x0105, 0x0108, 0x010d, 0x0110, 0x0115,
+	0x011a, 0x011d, 0x0122, 0x0127, 0x012c, 0x0131, 0x0136, 0x013b,
+	0x0140, 0x0145, 0x0148, 0x014c, 0x0150, 0x0153, 0x0158, 0x015d,
+	0x0162, 0x0167, 0x016c, 0x0171, 0x0176, 0x017b, 0x0180, 0x0185,
+	0x018a, 0x018f, 0x0194, 0x0199, 0x019c, 0x019d, 0x01a0, 0x01a5,
+};
+
+const uint8_t PROGMEM nsec_font_small_atlas[] = {
+	0x00, 0x00, 0x5f, 0x07, 0x00, 0x07, 0x14, 0x7f, 0x14, 0x7f, 0x14, 0x24,
+	0x2a, 0x7f, 0x2a, 0x12, 0x23, 0x13, 0x08, 0x64, 0x62, 0x36, 0x49, 0x55,
+	0x22, 0x50, 0x05, 0x03, 0x1c, 0x22, 0x41, 0x41, 0x22, 0x1c, 0x08, 0x2a,
+	0x1c, 0x2a, 0x08, 0x08, 0x08, 0x3e, 0x08, 0x08, 0x50, 0x30, 0x08, 0x08,
+	0x08, 0x08, 0x08, 0x60, 0x60, 0x20, 0x10, 0x08, 0x04, 0x02, 0x3e, 0x51,
+	0x49, 0x45, 0x3e, 0x42, 0x7f, 0x40, 0x42, 0x61, 0x51, 0x49, 0x46, 0x21,
+	0x41, 0x45, 0x4b, 0x31, 0x18, 0x14, 0x12, 0x7f, 0x10, 0x27, 0x45, 0x45,
+	0x45, 0x39, 0x3c, 0x4a, 0x49, 0x49, 0x30, 0x01, 0x71, 0x09, 0x05, 0x03,
+	0x36, 0x49, 0x49, 0x49, 0x36, 0x06, 0x49, 0x49, 0x29, 0x1e, 0x36, 0x36,
+	0x56, 0x36, 0x08, 0x14, 0x22, 0x41, 0x14, 0x14, 0x14, 0x14, 0x14, 0x41,
+	0x22, 0x14, 0x08, 0x02, 0x01, 0x51, 0x09, 0x06, 0x32, 0x49, 0x79, 0x41,
+	0x3e, 0x7e, 0x11, 0x11, 0x11, 0x7e, 0x7f, 0x49, 0x49, 0x49, 0x36, 0x3e,
+	0x41, 0x41, 0x41, 0x22, 0x7f, 0x41, 0x41, 0x22, 0x1c, 0x7f, 0x49, 0x49,
+	0x49, 0x41, 0x7f, 0x09, 0x09, 0x09, 0x01, 0x3e, 0x41, 0x49, 0x49, 0x7a,
+	0x7f, 0x08, 0x08, 0x08, 0x7f, 0x41, 0x7f, 0x41, 0x20, 0x40, 0x41, 0x3f,
+	0x01, 0x7f, 0x08, 0x14, 0x22, 0x41, 0x7f, 0x40, 0x40, 0x40, 0x40, 0x7f,
+	0x02, 0x0c, 0x02, 0x7f, 0x7f, 0x04, 0x08, 0x10, 0x7f, 0x3e, 0x41, 0x41,
+	0x41, 0x3e, 0x7f, 0x09, 0x09, 0x09, 0x06, 0x3e, 0x41, 0x51, 0x21, 0x5e,
+	0x7f, 0x09, 0x19, 0x29, 0x46, 0x46, 0x49, 0x49, 0x49, 0x31, 0x01, 0x01,
+	0x7f, 0x01, 0x01, 0x3f, 0x40, 0x40, 0x40, 0x3f, 0x1f, 0x20, 0x40, 0x20,
+	0x1f, 0x3f, 0x40, 0x38, 0x40, 0x3f, 0x63, 0x14, 0x08, 0x14, 0x63, 0x07,
+	0x08, 0x70, 0x08, 0x07, 0x61, 0x51, 0x49, 0x45, 0x43, 0x7f, 0x41, 0x41,
+	0x02, 0x04, 0x08, 0x10, 0x20, 0x41, 0x41, 0x7f, 0x04, 0x02, 0x01, 0x02,
+	0x04, 0x40, 0x40, 0x40, 0x40, 0x40, 0x01, 0x02, 0x04, 0x20, 0x54, 0x54,
+	0x54, 0x78, 0x7f, 0x48, 0x44, 0x44, 0x38, 0x38, 0x44, 0x44, 0x44, 0x20,
+	0x38, 0x44, 0x44, 0x48, 0x7f, 0x38, 0x54, 0x54, 0x54, 0x18, 0x08, 0x7e,
+	0x09, 0x01, 0x02, 0x0c, 0x52, 0x52, 0x52, 0x3e, 0x7f, 0x08, 0x04, 0x04,
+	0x78, 0x44, 0x7d, 0x40, 0x20, 0x40, 0x44, 0x3d, 0x7f, 0x10, 0x28, 0x44,
+	0x41, 0x7f, 0x40, 0x7c, 0x04, 0x18, 0x04, 0x78, 0x7c, 0x08, 0x04, 0x04,
+	0x78, 0x38, 0x44, 0x44, 0x44, 0x38, 0x7c, 0x14, 0x14, 0x14, 0x08, 0x08,
+	0x14, 0x14, 0x18, 0x7c, 0x7c, 0x08, 0x04, 0x04, 0x08, 0x48, 0x54, 0x54,
+	0x54, 0x20, 0x04, 0x3f, 0x44, 0x40, 0x20, 0x3c, 0x40, 0x40, 0x20, 0x7c,
+	0x1c, 0x20, 0x40, 0x20, 0x1c, 0x3c, 0x40, 0x30, 0x40, 0x3c, 0x44, 0x28,
+	0x10, 0x28, 0x44, 0x0c, 0x50, 0x50, 0x50, 0x3c, 0x44, 0x64, 0x54, 0x4c,
+	0x44, 0x08, 0x36, 0x41, 0x7f, 0x41, 0x36, 0x08, 0x08, 0x04, 0x08, 0x10,
+	0x08,
+};
+
+const nsec::display::font::descriptor nsec::display::font::small PROGMEM = {
+	' ', '~', 1, 1, 421, nsec_font_small_glyph_offsets, nsec_font_small_atlas
+};
+
+// large: 95 glyphs, 16 px high, 1684 atlas bytes, 192 offset bytes
+const uint16_t PROGMEM nsec_font_large_glyph_offsets[] = {
+	0x0000, 0x0004, 0x0006, 0x000c, 0x0016, 0x0020, 0x002a, 0x0034,
+	0x0038, 0x003e, 0x0044, 0x004e, 0x0058, 0x005c, 0x0066, 0x006a,
+	0x0074, 0x007e, 0x0084, 0x008e, 0x0098, 0x00a2, 0x00ac, 0x00b6,
+	0x00c0, 0x00ca, 0x00d4, 0x00d8, 0x00dc, 0x00e4, 0x00ee, 0x00f6,
+	0x0100, 0x010a, 0x0114, 0x011e, 0x0128, 0x0132, 0x013c, 0x0146,
+	0x0150, 0x015a, 0x0160, 0x016a, 0x0174, 0x017e, 0x0188, 0x0192,
+	0x019c, 0x01a6, 0x01b0, 0x01ba, 0x01c4, 0x01ce, 0x01d8, 0x01e2,
+	0x01ec, 0x01f6, 0x0200, 0x020a, 0x0210, 0x021a, 0x0220, 0x022a,
+	0x0234, 0x023a, 0x0244, 0x024e, 0x0258, 0x0262, 0x026c, 0x0276,
+	0x0280, 0x028a, 0x0290, 0x0298, 0x02a0, 0x02a6, 0x02b0, 0x02ba,
+	0x02c4, 0x02ce, 0x02d8, 0x02e2, 0x02ec, 0x02f6, 0x0300, 0x030a,
+	0x0314, 0x031e, 0x0328, 0x0332, 0x0338, 0x033a, 0x0340, 0x034a,
+};
+
+const uint8_t PROGMEM nsec_font_large_atlas[] = {
+	0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0x3f, 0x3f, 0x00, 0x00, 0x3f, 0x3f,
+	0x30, 0x38, 0xff, 0xff, 0x30, 0x30, 0xff, 0xff, 0x38, 0x30, 0x30, 0x78,
+	0xcc, 0xce, 0xff, 0xff, 0xce, 0xcc, 0x8c, 0x0c, 0x06, 0x0f, 0x0f, 0x86,
+	0xc0, 0xe0, 0x70, 0x38, 0x1c, 0x0c, 0x3c, 0x3e, 0xc7, 0xc3, 0x33, 0x33,
+	0x1e, 0x0c, 0x00, 0x00, 0x33, 0x33, 0x1f, 0x0e, 0xf0, 0xf8, 0x1c, 0x0e,
+	0x07, 0x03, 0x03, 0x07, 0x0e, 0x1c, 0xf8, 0xf0, 0xc0, 0xc0, 0xcc, 0xcc,
+	0xf0, 0xf0, 0xcc, 0xcc, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xe0, 0xfc, 0xfc,
+	0xe0, 0xc0, 0xc0, 0xc0, 0x00, 0x00, 0x00, 0x00, 0xc0, 0xc0, 0xc0, 0xc0,
+	0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x80, 0xc0, 0xe0, 0x70, 0x38, 0x1c, 0x0c, 0xfc, 0xfe, 0x07, 0x03,
+	0xc3, 0xe3, 0x33, 0x33, 0xfe, 0xfc, 0x0c, 0x1e, 0xff, 0xff, 0x00, 0x00,
+	0x0c, 0x0e, 0x07, 0x03, 0x03, 0x83, 0xc3, 0xe7, 0x7e, 0x3c, 0x03, 0x03,
+	0x03, 0x03, 0x33, 0x73, 0xcf, 0xcf, 0x87, 0x03, 0xc0, 0xe0, 0x30, 0x38,
+	0x0c, 0x8e, 0xff, 0xff, 0x80, 0x00, 0x1e, 0x3f, 0x33, 0x33, 0x33, 0x33,
+	0x33, 0x73, 0xe3, 0xc3, 0xf0, 0xf8, 0xcc, 0xce, 0xc7, 0xc3, 0xc3, 0xc3,
+	0x80, 0x00, 0x03, 0x03, 0x03, 0x83, 0xc3, 0xe3, 0x73, 0x33, 0x1f, 0x0e,
+	0x3c, 0x3e, 0xe7, 0xc3, 0xc3, 0xc3, 0xc3, 0xe7, 0x3e, 0x3c, 0x3c, 0x7e,
+	0xe7, 0xc3, 0xc3, 0xc3, 0xc3, 0xe7, 0xfe, 0xfc, 0x18, 0x3c, 0x3c, 0x18,
+	0x18, 0x3c, 0x3c, 0x18, 0xc0, 0xe0, 0x30, 0x38, 0x1c, 0x0e, 0x07, 0x03,
+	0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x03, 0x07,
+	0x0e, 0x1c, 0x38, 0x30, 0xe0, 0xc0, 0x0c, 0x0e, 0x07, 0x03, 0x03, 0x83,
+	0xc3, 0xe7, 0x7e, 0x3c, 0x0c, 0x8e, 0xc7, 0xc3, 0xc3, 0x83, 0x03, 0x07,
+	0xfe, 0xfc, 0xfc, 0xfe, 0x87, 0x03, 0x03, 0x03, 0x03, 0x87, 0xfe, 0xfc,
+	0xfe, 0xff, 0xe7, 0xc3, 0xc3, 0xc3, 0xc3, 0xe7, 0x3e, 0x3c, 0xfc, 0xfe,
+	0x07, 0x03, 0x03, 0x03, 0x03, 0x07, 0x0e, 0x0c, 0xfe, 0xff, 0x07, 0x03,
+	0x03, 0x07, 0x0e, 0x1c, 0xf8, 0xf0, 0xfe, 0xff, 0xe7, 0xc3, 0xc3, 0xc3,
+	0xc3, 0xc3, 0x03, 0x03, 0xfe, 0xff, 0xe7, 0xc3, 0xc3, 0xc3, 0xc3, 0xc3,
+	0x03, 0x03, 0xfc, 0xfe, 0x07, 0x03, 0xc3, 0xc3, 0xc3, 0xc7, 0xce, 0x8c,
+	0xff, 0xff, 0xe0, 0xc0, 0xc0, 0xc0, 0xc0, 0xe0, 0xff, 0xff, 0x03, 0x07,
+	0xff, 0xff, 0x07, 0x03, 0x00, 0x00, 0x00, 0x00, 0x03, 0x07, 0xff, 0xff,
+	0x07, 0x03, 0xff, 0xff, 0xc0, 0xc0, 0x30, 0x38, 0x1c, 0x0e, 0x07, 0x03,
+	0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff,
+	0x0e, 0x0c, 0xf0, 0xf0, 0x0c, 0x0e, 0xff, 0xff, 0xff, 0xff, 0x38, 0x30,
+	0xe0, 0xc0, 0x00, 0x00, 0xff, 0xff, 0xfc, 0xfe, 0x07, 0x03, 0x03, 0x03,
+	0x03, 0x07, 0xfe, 0xfc, 0xfe, 0xff, 0xe7, 0xc3, 0xc3, 0xc3, 0xc3, 0xe7,
+	0x7e, 0x3c, 0xfc, 0xfe, 0x07, 0x03, 0x03, 0x03, 0x03, 0x07, 0xfe, 0xfc,
+	0xfe, 0xff, 0xe7, 0xc3, 0xc3, 0xc3, 0xc3, 0xe7, 0x7e, 0x3c, 0x3c, 0x7e,
+	0xe7, 0xc3, 0xc3, 0xc3, 0xc3, 0xc3, 0x83, 0x03, 0x03, 0x03, 0x03, 0x07,
+	0xff, 0xff, 0x07, 0x03, 0x03, 0x03, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0xc0, 0xc0, 0x00, 0x00, 0xff, 0xff,
+	0x0f, 0x1f, 0x38, 0x30, 0xc0, 0xc0, 0x30, 0x38, 0x1f, 0x0f, 0x3f, 0x7f,
+	0xe0, 0xc0, 0x00, 0x00, 0xc0, 0xe0, 0x7f, 0x3f, 0x03, 0x03, 0x03, 0x83,
+	0xc3, 0xe3, 0x73, 0x33, 0x1f, 0x0e, 0xfe, 0xff, 0x07, 0x03, 0x03, 0x03,
+	0x0c, 0x1c, 0x38, 0x70, 0xe0, 0xc0, 0x80, 0x00, 0x00, 0x00, 0x03, 0x03,
+	0x03, 0x07, 0xff, 0xfe, 0x30, 0x38, 0x1c, 0x0e, 0x03, 0x03, 0x0e, 0x1c,
+	0x38, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x03, 0x07, 0x0e, 0x1c, 0x38, 0x30, 0x00, 0x00, 0x30, 0x30, 0x30, 0x30,
+	0x30, 0x30, 0xe0, 0xc0, 0xff, 0xff, 0xc0, 0xc0, 0x70, 0x30, 0x30, 0x70,
+	0xe0, 0xc0, 0xc0, 0xe0, 0x70, 0x30, 0x30, 0x30, 0x30, 0x30, 0x00, 0x00,
+	0xc0, 0xe0, 0x70, 0x30, 0x30, 0x70, 0xc0, 0xc0, 0xff, 0xff, 0xc0, 0xe0,
+	0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0xe0, 0xc0, 0xc0, 0xe0, 0xfc, 0xfe,
+	0xe7, 0xc3, 0x03, 0x07, 0x0e, 0x0c, 0xf0, 0xf8, 0x9c, 0x0c, 0x0c, 0x0c,
+	0x0c, 0x9c, 0xfc, 0xf8, 0xff, 0xff, 0xc0, 0xc0, 0x70, 0x30, 0x30, 0x70,
+	0xe0, 0xc0, 0x30, 0x70, 0xf3, 0xe3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x30, 0x70, 0xf3, 0xe3, 0xff, 0xff, 0x00, 0x00, 0xc0, 0xe0, 0x70, 0x30,
+	0x03, 0x07, 0xff, 0xfe, 0x00, 0x00, 0xe0, 0xf0, 0x30, 0x30, 0xc0, 0xc0,
+	0x30, 0x30, 0xe0, 0xc0, 0xf0, 0xf0, 0xc0, 0xc0, 0x70, 0x30, 0x30, 0x70,
+	0xe0, 0xc0, 0xc0, 0xe0, 0x70, 0x30, 0x30, 0x30, 0x30, 0x70, 0xe0, 0xc0,
+	0xe0, 0xf0, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0xe0, 0xc0, 0xc0, 0xe0,
+	0x30, 0x30, 0x30, 0x30, 0x80, 0xc0, 0xf0, 0xf0, 0xf0, 0xf0, 0xc0, 0xc0,
+	0x70, 0x30, 0x30, 0x70, 0xe0, 0xc0, 0xc0, 0xe0, 0x30, 0x30, 0x30, 0x30,
+	0x30, 0x30, 0x00, 0x00, 0x30, 0x78, 0xff, 0xff, 0x78, 0x30, 0x00, 0x00,
+	0x00, 0x00, 0xf0, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf0, 0xf0,
+	0xf0, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf0, 0xf0, 0xf0, 0xf0,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf0, 0xf0, 0x30, 0x70, 0xe0, 0xc0,
+	0x00, 0x00, 0xc0, 0xe0, 0x70, 0x30, 0xf0, 0xf0, 0x80, 0x00, 0x00, 0x00,
+	0x00, 0x80, 0xf0, 0xf0, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0xf0, 0xf0,
+	0x70, 0x30, 0xc0, 0xe0, 0x3c, 0x3e, 0x07, 0x03, 0xff, 0xff, 0x03, 0x07,
+	0x3e, 0x3c, 0xe0, 0xc0, 0xc0, 0xe0, 0x30, 0x30, 0xe0, 0xc0, 0x00, 0x00,
+	0xc0, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x03, 0x07, 0x3f, 0x3f, 0x03, 0x03, 0x3f, 0x3f, 0x07, 0x03,
+	0x0c, 0x0c, 0x0c, 0x1c, 0x3f, 0x3f, 0x1c, 0x0c, 0x07, 0x03, 0x0c, 0x0e,
+	0x07, 0x03, 0x01, 0x00, 0x18, 0x3c, 0x3c, 0x18, 0x0f, 0x1f, 0x38, 0x30,
+	0x33, 0x33, 0x0c, 0x0c, 0x33, 0x33, 0x00, 0x00, 0x00, 0x00, 0x03, 0x07,
+	0x0e, 0x1c, 0x38, 0x30, 0x30, 0x38, 0x1c, 0x0e, 0x07, 0x03, 0x00, 0x00,
+	0x0c, 0x0c, 0x03, 0x03, 0x0c, 0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+	0x0f, 0x0f, 0x01, 0x00, 0x00, 0x00, 0x33, 0x33, 0x1f, 0x0e, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x3c, 0x3c, 0x18,
+	0x0c, 0x0e, 0x07, 0x03, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0f, 0x1f,
+	0x33, 0x33, 0x31, 0x30, 0x30, 0x38, 0x1f, 0x0f, 0x30, 0x38, 0x3f, 0x3f,
+	0x38, 0x30, 0x30, 0x38, 0x3c, 0x3e, 0x33, 0x33, 0x31, 0x30, 0x30, 0x30,
+	0x0c, 0x1c, 0x38, 0x30, 0x30, 0x30, 0x30, 0x39, 0x1f, 0x0f, 0x01, 0x03,
+	0x03, 0x03, 0x03, 0x07, 0x3f, 0x3f, 0x07, 0x03, 0x0c, 0x1c, 0x38, 0x30,
+	0x30, 0x30, 0x30, 0x38, 0x1f, 0x0f, 0x0f, 0x1f, 0x39, 0x30, 0x30, 0x30,
+	0x30, 0x39, 0x1f, 0x0f, 0x00, 0x00, 0x3f, 0x3f, 0x01, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x0f, 0x1f, 0x39, 0x30, 0x30, 0x30, 0x30, 0x39, 0x1f, 0x0f,
+	0x00, 0x00, 0x30, 0x30, 0x30, 0x38, 0x1c, 0x0c, 0x07, 0x03, 0x06, 0x0f,
+	0x0f, 0x06, 0x33, 0x33, 0x1f, 0x0e, 0x00, 0x01, 0x03, 0x07, 0x0e, 0x1c,
+	0x38, 0x30, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+	0x30, 0x38, 0x1c, 0x0e, 0x07, 0x03, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x33, 0x33, 0x01, 0x00, 0x00, 0x00, 0x0f, 0x1f, 0x30, 0x30, 0x3f, 0x3f,
+	0x30, 0x30, 0x1f, 0x0f, 0x3f, 0x3f, 0x07, 0x03, 0x03, 0x03, 0x03, 0x07,
+	0x3f, 0x3f, 0x1f, 0x3f, 0x39, 0x30, 0x30, 0x30, 0x30, 0x39, 0x1f, 0x0f,
+	0x0f, 0x1f, 0x38, 0x30, 0x30, 0x30, 0x30, 0x38, 0x1c, 0x0c, 0x1f, 0x3f,
+	0x38, 0x30, 0x30, 0x38, 0x1c, 0x0e, 0x07, 0x03, 0x1f, 0x3f, 0x39, 0x30,
+	0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x3f, 0x3f, 0x01, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x0f, 0x1f, 0x38, 0x30, 0x30, 0x30, 0x30, 0x39,
+	0x3f, 0x1f, 0x3f, 0x3f, 0x01, 0x00, 0x00, 0x00, 0x00, 0x01, 0x3f, 0x3f,
+	0x30, 0x38, 0x3f, 0x3f, 0x38, 0x30, 0x0c, 0x1c, 0x38, 0x30, 0x30, 0x38,
+	0x1f, 0x0f, 0x00, 0x00, 0x3f, 0x3f, 0x00, 0x00, 0x03, 0x07, 0x0e, 0x1c,
+	0x38, 0x30, 0x1f, 0x3f, 0x38, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30,
+	0x3f, 0x3f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3f, 0x3f, 0x3f, 0x3f,
+	0x00, 0x00, 0x00, 0x01, 0x03, 0x07, 0x3f, 0x3f, 0x0f, 0x1f, 0x38, 0x30,
+	0x30, 0x30, 0x30, 0x38, 0x1f, 0x0f, 0x3f, 0x3f, 0x01, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x0f, 0x1f, 0x38, 0x30, 0x33, 0x33, 0x0c, 0x0c,
+	0x33, 0x33, 0x3f, 0x3f, 0x00, 0x00, 0x03, 0x07, 0x0c, 0x1c, 0x38, 0x30,
+	0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x39, 0x1f, 0x0f, 0x00, 0x00,
+	0x00, 0x00, 0x3f, 0x3f, 0x00, 0x00, 0x00, 0x00, 0x0f, 0x1f, 0x38, 0x30,
+	0x30, 0x30, 0x30, 0x38, 0x1f, 0x0f, 0x03, 0x07, 0x0e, 0x1c, 0x30, 0x30,
+	0x1c, 0x0e, 0x07, 0x03, 0x0f, 0x1f, 0x30, 0x30, 0x0f, 0x0f, 0x30, 0x30,
+	0x1f, 0x0f, 0x3c, 0x3e, 0x07, 0x03, 0x00, 0x00, 0x03, 0x07, 0x3e, 0x3c,
+	0x00, 0x00, 0x00, 0x01, 0x3f, 0x3f, 0x01, 0x00, 0x00, 0x00, 0x1c, 0x3e,
+	0x33, 0x33, 0x31, 0x30, 0x30, 0x30, 0x30, 0x30, 0x1f, 0x3f, 0x38, 0x30,
+	0x30, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x03, 0x07, 0x0e, 0x0c,
+	0x30, 0x30, 0x30, 0x38, 0x3f, 0x1f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30,
+	0x30, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x1e, 0x33, 0x33,
+	0x33, 0x33, 0x33, 0x33, 0x3f, 0x1f, 0x1f, 0x3f, 0x39, 0x30, 0x30, 0x30,
+	0x30, 0x38, 0x1f, 0x0f, 0x0f, 0x1f, 0x38, 0x30, 0x30, 0x30, 0x30, 0x38,
+	0x1c, 0x0c, 0x0f, 0x1f, 0x38, 0x30, 0x30, 0x30, 0x30, 0x39, 0x3f, 0x1f,
+	0x0f, 0x1f, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x03, 0x01, 0x00, 0x01,
+	0x3f, 0x3f, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x33, 0x33,
+	0x33, 0x33, 0x33, 0x33, 0x1f, 0x0f, 0x3f, 0x3f, 0x01, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x3f, 0x3f, 0x30, 0x38, 0x3f, 0x3f, 0x38, 0x30, 0x0c, 0x1c,
+	0x38, 0x30, 0x30, 0x38, 0x1f, 0x0f, 0x3f, 0x3f, 0x03, 0x03, 0x0c, 0x1c,
+	0x38, 0x30, 0x30, 0x38, 0x3f, 0x3f, 0x38, 0x30, 0x3f, 0x3f, 0x00, 0x00,
+	0x03, 0x03, 0x00, 0x00, 0x3f, 0x3f, 0x3f, 0x3f, 0x01, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x3f, 0x3f, 0x0f, 0x1f, 0x38, 0x30, 0x30, 0x30, 0x30, 0x38,
+	0x1f, 0x0f, 0x3f, 0x3f, 0x07, 0x03, 0x03, 0x03, 0x03, 0x03, 0x01, 0x00,
+	0x00, 0x01, 0x03, 0x03, 0x03, 0x03, 0x03, 0x07, 0x3f, 0x3f, 0x3f, 0x3f,
+	0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0x31, 0x33, 0x33,
+	0x33, 0x33, 0x33, 0x33, 0x1e, 0x0c, 0x00, 0x00, 0x0f, 0x1f, 0x38, 0x30,
+	0x30, 0x38, 0x1c, 0x0c, 0x0f, 0x1f, 0x38, 0x30, 0x30, 0x38, 0x0c, 0x0e,
+	0x3f, 0x3f, 0x03, 0x07, 0x0e, 0x1c, 0x30, 0x30, 0x1c, 0x0e, 0x07, 0x03,
+	0x0f, 0x1f, 0x30, 0x30, 0x0f, 0x0f, 0x30, 0x30, 0x1f, 0x0f, 0x30, 0x38,
+	0x1c, 0x0c, 0x03, 0x03, 0x0c, 0x1c, 0x38, 0x30, 0x00, 0x01, 0x33, 0x33,
+	0x33, 0x33, 0x33, 0x33, 0x1f, 0x0f, 0x30, 0x38, 0x3c, 0x3e, 0x33, 0x33,
+	0x31, 0x30, 0x30, 0x30, 0x00, 0x01, 0x0f, 0x1f, 0x38, 0x30, 0x3f, 0x3f,
+	0x30, 0x38, 0x1f, 0x0f, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+	0x03, 0x03, 0x01, 0x00,
+};
+
+const nsec::display::font::descriptor nsec::display::font::large PROGMEM = {
+	' ', '~', 2, 2, 842, nsec_font_large_glyph_offsets, nsec_font_large_atlas
+};
@@ -0,0 +1,46 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2023 Jérémie Galarneau <jeremie.galarneau@gmail.com>
+ */
+
+#ifndef NSEC_LED_ANIMATION_HPP
+#define NSEC_LED_ANIMATION_HPP
+
+#include <stdint.h>
+
+namespace nsec::led::animation {
+
+/*
+ * Keyframe of an animation stored in program memory (see the animations
+ * folder).
+ *
+ * Colors are indices in a palette shared by all animations and times are
+ * steps since the previous keyframe. Keyframe sequences are shared between
+ * animations that encode to the same bytes.
+ */
+struct packed_keyframe {
+	// Index of the keyframe's color in the palette.
+	uint8_t color;
+	// Time since the previous keyframe, in units of the animation's time scale.
+	uint8_t time_step;
+};
+
+// Space in which the colors of consecutive keyframes are interpolated.
+enum class color_space : uint8_t {
+	RGB,
+	// Along the color wheel, see nsec::led::interpolation::hsv_color.
+	HSV,
+};
+
+struct descriptor {
+	const packed_keyframe *keyframes;
+	uint8_t keyframe_count;
+	// Duration of a time step, in ms.
+	uint8_t time_scale;
+	color_space interpolation_space;
+};
+
+} // namespace nsec::led::animation
+
+#endif // NSEC_LED_ANIMATION_HPP
@@ -0,0 +1,152 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2023 Jérémie Galarneau <jeremie.galarneau@gmail.com>
+ */
+
+#ifndef NSEC_LED_INTERPOLATION_HPP
+#define NSEC_LED_INTERPOLATION_HPP
+
+#include <stdint.h>
+
+/*
+ * Division-free linear interpolation between keyframes.
+ *
+ * The progress through a keyframe segment is a phase in 0.16 fixed point. The
+ * rate of a segment, its phase increment per ms, is computed once when its
+ * keyframe is decoded. The phase at any time of the segment then only takes a
+ * multiplication, and interpolating a component an 8x16-bit multiplication.
+ */
+namespace nsec::led::interpolation {
+
+using phase = uint16_t;
+// Phase increment per ms, with 8 extra fractional bits.
+using phase_rate = uint32_t;
+
+inline phase_rate rate(uint16_t duration_ms) noexcept
+{
+	return duration_ms ? (uint32_t(1) << 24) / duration_ms : 0;
+}
+
+// Phase at elapsed_ms into a segment (elapsed_ms < its duration).
+inline phase phase_at(uint16_t elapsed_ms, phase_rate segment_rate) noexcept
+{
+	return (elapsed_ms * segment_rate) >> 8;
+}
+
+/*
+ * Rounds toward the origin like the truncating division it replaces. The phase
+ * is rounded down, so results can be one step closer to the origin.
+ */
+inline uint8_t component(uint8_t origin, uint8_t destination, phase progress) noexcept
+{
+	if (destination >= origin) {
+		return origin + uint8_t((uint32_t(uint8_t(destination - origin)) * progress) >> 16);
+	} else {
+		return origin - uint8_t((uint32_t(uint8_t(origin - destination)) * progress) >> 16);
+	}
+}
+
+/*
+ * Interpolation in HSV space. Linear interpolation in RGB fades complementary
+ * colors through grey; interpolating the hue along the shortest arc of the color
+ * wheel keeps them saturated. Keyframe colors are converted by the animation
+ * compiler, so only the conversion back to RGB is done per LED.
+ *
+ * Each of the color wheel's 6 sectors, from a primary to a secondary color or
+ * back, spans 256 hues.
+ */
+constexpr uint16_t hue_sector_size = 256;
+constexpr uint16_t hue_range = 6 * hue_sector_size;
+
+struct hsv_color {
+	// In [0, hue_range[, 0 is red.
+	uint16_t hue;
+	uint8_t saturation;
+	uint8_t value;
+};
+
+struct rgb_color {
+	uint8_t red;
+	uint8_t green;
+	uint8_t blue;
+};
+
+// value * factor / 255, within 1. Factors of 0 and 255 are exact.
+inline uint8_t scale(uint8_t value, uint8_t factor) noexcept
+{
+	return (uint16_t(value) * factor + value) >> 8;
+}
+
+// Hue along the shortest arc between two hues, rounded toward the origin.
+inline uint16_t hue(uint16_t origin, uint16_t destination, phase progress) noexcept
+{
+	const uint16_t forward_distance =
+		destination >= origin ? destination - origin : destination + hue_range - origin;
+
+	if (forward_distance <= hue_range / 2) {
+		const uint16_t forward_hue =
+			origin + ((uint32_t(forward_distance) * progress) >> 16);
+
+		return forward_hue < hue_range ? forward_hue : forward_hue - hue_range;
+	}
+
+	const uint16_t step = (uint32_t(hue_range - forward_distance) * progress) >> 16;
+
+	return origin >= step ? origin - step : origin + hue_range - step;
+}
+
+/*
+ * Black has no hue nor saturation and greys have no hue: fading from or to
+ * them keeps those of the other color.
+ */
+inline hsv_color hsv(hsv_color origin, hsv_color destination, phase progress) noexcept
+{
+	if (!origin.value) {
+		origin.hue = destination.hue;
+		origin.saturation = destination.saturation;
+	} else if (!origin.saturation) {
+		origin.hue = destination.hue;
+	}
+
+	if (!destination.value) {
+		destination.hue = origin.hue;
+		destination.saturation = origin.saturation;
+	} else if (!destination.saturation) {
+		destination.hue = origin.hue;
+	}
+
+	return { hue(origin.hue, destination.hue, progress),
+		 component(origin.saturation, destination.saturation, progress),
+		 component(origin.value, destination.value, progress) };
+}
+
+inline rgb_color rgb(const hsv_color& color) noexcept
+{
+	const uint8_t sector = color.hue / hue_sector_size;
+	const uint8_t fraction = color.hue % hue_sector_size;
+	const uint8_t max = color.value;
+	const uint8_t chroma = scale(max, color.saturation);
+	const uint8_t min = max - chroma;
+	const uint8_t rising = min + scale(chroma, fraction);
+	const uint8_t falling = min + scale(chroma, ~fraction);
+
+	switch (sector) {
+	case 0: // Red to yellow
+		return { max, rising, min };
+	case 1: // Yellow to green
+		return { falling, max, min };
+	case 2: // Green to cyan
+		return { min, max, rising };
+	case 3: // Cyan to blue
+		return { min, falling, max };
+	case 4: // Blue to magenta
+		return { rising, min, max };
+	default: // Magenta to red
+		return { max, min, falling };
+	}
+}
+
+} // namespace nsec::led::interpolation
+
+#endif // NSEC_LED_INTERPOLATION_HPP
@@ -0,0 +1,59 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2023 Jérémie Galarneau <jeremie.galarneau@gmail.com>
+ */
+
+#ifndef NSEC_LED_POWER_HPP
+#define NSEC_LED_POWER_HPP
+
+#include <stdint.h>
+
+/*
+ * Power model of the LED strip.
+ *
+ * The current drawn by a frame is estimated from the sum of its pixel
+ * components, as sent to the LEDs: each component draws a current proportional
+ * to its PWM duty cycle. Frames over the budget are scaled down through a soft
+ * knee, so brightening animations are compressed smoothly instead of clipping
+ * at the budget.
+ */
+namespace nsec::led::power {
+
+// Frame scale, in 1/256th.
+using scale = uint16_t;
+constexpr scale unity_scale = 256;
+
+// Current drawn by pixel components summing to component_sum, rounded up.
+inline uint16_t components_current_ma(uint16_t component_sum, uint8_t full_component_ma) noexcept
+{
+	return (uint32_t(component_sum) * full_component_ma + 254) / 255;
+}
+
+/*
+ * Scale bringing a frame's current within a budget, of up to 4 A. Currents up
+ * to 3/4 of the budget are kept, the excess over this knee is compressed so the
+ * scaled current approaches the budget without reaching it.
+ */
+inline scale limit_scale(uint16_t current_ma, uint16_t budget_ma) noexcept
+{
+	const uint16_t knee_ma = budget_ma - budget_ma / 4;
+
+	if (current_ma <= knee_ma) {
+		return unity_scale;
+	}
+
+	// knee + range * excess / (excess + range), with 8 fractional bits.
+	const uint32_t range_ma = budget_ma - knee_ma;
+	const uint32_t excess_ma = current_ma - knee_ma;
+	const uint32_t limited_ma = (uint32_t(budget_ma) << 8) -
+		((range_ma * range_ma) << 8) / (excess_ma + range_ma);
+	const scale limited_scale = limited_ma / current_ma;
+
+	// Never black out a frame, its current must still be measurable to recover.
+	return limited_scale ? limited_scale : 1;
+}
+
+} // namespace nsec::led::power
+
+#endif // NSEC_LED_POWER_HPP
@@ -0,0 +1,98 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2023 Jérémie Galarneau <jeremie.galarneau@gmail.com>
+ */
+
+#ifndef NSEC_LED_PROGRAM_HPP
+#define NSEC_LED_PROGRAM_HPP
+
+#include <stdint.h>
+
+/*
+ * Bytecode of the LED programs run by the strip animator. Programs are
+ * assembled on the host (see the animations folder) and stored in program
+ * memory.
+ *
+ * An instruction is an opcode byte, (operation << 2) | register, followed by
+ * its operands. A program drives the keyframed animation engine: it selects
+ * keyframes, starts and stops LEDs, offsets their phase and sets the
+ * brightness, waiting a number of ticks between changes.
+ */
+namespace nsec::led::program {
+
+enum class operation : uint8_t {
+	// Stop the program, LEDs keep animating.
+	END,
+	// Suspend the program for <ticks> ticks.
+	WAIT,
+	// Repeat the instructions up to the matching NEXT <count> times, forever if 0.
+	LOOP,
+	NEXT,
+	// r = <value>
+	SET,
+	// r += <value>, wraps around.
+	ADD,
+	// r = random value in [0, <bound>[, with a bound of 256 when 0.
+	RANDOM,
+	// Restart the animation of LED r (modulo 16).
+	START,
+	// Freeze LED r (modulo 16) on its current keyframe.
+	STOP,
+	// Move LED r (modulo 16) <ticks> ticks into the animation.
+	PHASE,
+	// Move each LED i * <ticks> ticks into the animation.
+	SPREAD,
+	// Set the mask of animated LEDs: <low byte> <high byte>.
+	ACTIVATE,
+	// Animate keyframes of an animation, restarting all LEDs:
+	// <animation index> <(first keyframe << 4) | keyframe count> <loop point>.
+	KEYFRAMES,
+	// Set the brightness to <value>, ending a fade.
+	BRIGHTNESS,
+	// Move the brightness linearly: <target> <ticks>.
+	FADE,
+	// Set the tick period: <ms>.
+	PERIOD,
+};
+
+constexpr uint8_t register_count = 4;
+constexpr uint8_t max_loop_depth = 2;
+
+constexpr uint8_t opcode(operation op, uint8_t register_index = 0) noexcept
+{
+	return (uint8_t(op) << 2) | (register_index & (register_count - 1));
+}
+
+constexpr operation opcode_operation(uint8_t opcode) noexcept
+{
+	return operation(opcode >> 2);
+}
+
+constexpr uint8_t opcode_register(uint8_t opcode) noexcept
+{
+	return opcode & (register_count - 1);
+}
+
+// Size of the operands following an opcode, in bytes.
+constexpr uint8_t operand_size(operation op) noexcept
+{
+	switch (op) {
+	case operation::END:
+	case operation::NEXT:
+	case operation::START:
+	case operation::STOP:
+		return 0;
+	case operation::ACTIVATE:
+	case operation::FADE:
+		return 2;
+	case operation::KEYFRAMES:
+		return 3;
+	default:
+		return 1;
+	}
+}
+
+} // namespace nsec::led::program
+
+#endif // NSEC_LED_PROGRAM_HPP
@@ -7,6 +7,11 @@
 #ifndef NSEC_LED_STRIP_ANIMATOR_HPP
 #define NSEC_LED_STRIP_ANIMATOR_HPP
 
+#include "config.hpp"
+#include "led/animation.hpp"
+#include "led/interpolation.hpp"
+#include "led/power.hpp"
+#include "led/program.hpp"
 #include "scheduler.hpp"
 
 #include <Adafruit_NeoPixel.h>
@@ -26,8 +31,21 @@ public:
 
 	void setup() noexcept;
 
+	// Send a frame held back until the pairing links are quiet, if any and they are.
+	void flush_deferred_frame() noexcept;
+
+	// Set the base layer's animation, hiding the overlay. An unchanged animation keeps running.
 	void set_idle_animation(uint8_t id) noexcept;
 
+	/*
+	 * Idle animations of chained badges run on the network time, our time plus
+	 * the offset measured by the network handler, and span the chain: shooting
+	 * stars leave the last LED of a badge for the first LED of the next peer.
+	 */
+	void set_chain_position(uint8_t peer_id, uint8_t peer_count) noexcept;
+	void set_network_time_offset(uint32_t offset_ms) noexcept;
+
+	// The following animations are shown in the overlay, over the idle animation.
 
 	void set_red_to_green_led_progress_bar(uint8_t led_count) noexcept;
 
@@ -61,6 +79,8 @@ public:
 		{
 		}
 
+		led_color& operator=(const led_color&) = default;
+
 		constexpr const uint8_t& r() const noexcept
 		{
 			return components[np_red_offset];
@@ -86,6 +106,48 @@ public:
 		static const uint8_t np_blue_offset = NEO_GRB & 0b11;
 	};
 
+	// Keyframe cache counters (wrap around), for profiling.
+	uint16_t keyframe_cache_hits() const noexcept
+	{
+		return _keyframe_cache.hits;
+	}
+
+	uint16_t keyframe_cache_misses() const noexcept
+	{
+		return _keyframe_cache.misses;
+	}
+
+	// Frames sent to the LEDs and frames skipped since they were unchanged (wrap around).
+	uint16_t emitted_frame_count() const noexcept
+	{
+		return _emitted_frame_count;
+	}
+
+	uint16_t skipped_frame_count() const noexcept
+	{
+		return _skipped_frame_count;
+	}
+
+	/*
+	 * Ticks during which a frame was held back while the pairing links were busy,
+	 * and frames sent anyway once the deferral bound was reached (wrap around).
+	 */
+	uint16_t deferred_frame_count() const noexcept
+	{
+		return _deferred_frame_count;
+	}
+
+	uint16_t forced_frame_count() const noexcept
+	{
+		return _forced_frame_count;
+	}
+
+	// Frames dimmed by the power limiter (wraps around).
+	uint16_t power_limited_frame_count() const noexcept
+	{
+		return _power_limited_frame_count;
+	}
+
 	struct keyframe {
 		keyframe() = default;
 		constexpr keyframe(const led_color& in_color, uint16_t at_time) :
@@ -102,25 +164,71 @@ protected:
 	void run(scheduling::absolute_time_ms current_time_ms) noexcept override;
 
 private:
-	enum class animation_type : uint8_t {
-		LEGACY,
-		KEYFRAMED,
-	};
+	// Checks the animation state on the host (see test/native/test_strip_animator_simulation).
+	friend class strip_animator_simulator;
 
 	enum class keyframed_animation : uint8_t {
 		PROGRESS_BAR,
 		SHOOTING_STAR, // Shooting star running accross the LEDs
 		SPARKS, // Random sparks appearing
 		CYCLE,
+		PROGRAM, // Driven by a bytecode program (see led/program.hpp)
 	};
 
-	void _legacy_animation_tick() noexcept;
-	void _keyframe_animation_tick(const scheduling::absolute_time_ms& current_time_ms) noexcept;
+	/*
+	 * Set the visible LEDs of the layers in the pixel buffer, ticking their
+	 * animations. Only the LEDs that animate or are stale are evaluated, the
+	 * others keep their pixels.
+	 */
+	void _render_layers() noexcept;
+	// Animation-specific work of the current layer, once per tick.
+	void _layer_tick() noexcept;
+	// Color of an LED in the current layer at _time_ms, advancing its keyframes.
+	led_color _layer_led_color(uint8_t led_id) noexcept;
+	// Run the program's instructions until it waits, ends or exhausts its budget.
+	void _program_tick() noexcept;
 	led_color _color(uint8_t led_id) const noexcept;
+	// Set a pixel's color, gamma corrected and scaled, noting if the frame changed.
+	void _set_pixel_color(uint8_t led_id, const led_color& color, uint8_t brightness) noexcept;
+	/*
+	 * Estimate the current drawn by the frame in the pixel buffer. Over the
+	 * budget, dim it right away and lower the brightness of the next frames;
+	 * under it, raise their brightness back gradually.
+	 */
+	void _limit_power() noexcept;
+	void _show() noexcept;
 	void _reset_keyframed_animation_state() noexcept;
+	// xorshift16, never 0.
+	uint16_t _random() noexcept;
+	// Random value in [0, bound[.
+	uint16_t _random(uint16_t bound) noexcept;
 
 	Adafruit_NeoPixel _pixels;
-	animation_type _current_animation_type;
+	// A pixel changed since the last frame was sent to the LEDs.
+	bool _frame_changed : 1;
+	// The current frame is held until the pairing links are quiet.
+	bool _frame_deferred : 1;
+	scheduling::absolute_time_ms _deferral_start_time_ms;
+	uint16_t _emitted_frame_count;
+	uint16_t _skipped_frame_count;
+	uint16_t _deferred_frame_count;
+	uint16_t _forced_frame_count;
+	uint16_t _power_limited_frame_count;
+
+	// Scale applied to the animations' brightness by the power limiter.
+	power::scale _power_scale;
+	/*
+	 * Accumulated fractional part of each pixel component, in 1/16th: two
+	 * components per byte, even ones (led_id * 3 + component) in the low nibble.
+	 */
+	uint8_t _dithering_error[16 * 3 / 2];
+	/*
+	 * LEDs to evaluate on the next tick even if no layer animates them, as the
+	 * keyframes or masks they are shown with changed, or their dithering carries a
+	 * fraction.
+	 */
+	uint16_t _stale_leds;
+	uint16_t _random_state;
 
 	// Keyframe indices of 4-bits each, use helpers to access.
 	struct indice_storage_element {
@@ -128,61 +236,176 @@ private:
 		uint8_t odd : 4;
 	};
 
-	union {
-		struct {
-			uint8_t level;
-		} legacy;
+	/*
+	 * Layers are stacked bottom to top: the base layer runs the idle animation
+	 * and the overlay shows status (pairing progress, level) over some of its
+	 * LEDs. Each layer keeps its own animation state and brightness, and an LED
+	 * is only evaluated in the top-most layer showing it.
+	 */
+	static constexpr uint8_t _base_layer = 0;
+	static constexpr uint8_t _overlay_layer = 1;
+	static constexpr uint8_t _layer_count = 2;
+	static constexpr uint8_t _max_spark_count = 4;
+
+	struct layer {
 		struct {
 			union {
 				struct {
-					uint8_t ticks_before_advance;
+					uint16_t advance_interval_ms;
 					uint8_t star_count;
 				} shooting_star;
+				struct {
+					// Mean interval between the spawns of a spark.
+					uint16_t spawn_interval_ms;
+					uint8_t spark_count;
+				} sparks;
+				struct {
+					const uint8_t *bytecode;
+				} program;
 			};
 			uint8_t keyframe_count : 4;
 			uint8_t loop_point_index : 4;
 			keyframed_animation _animation;
-			const keyframe *keyframes;
-			// 1-bit per led. When inactive, the origin keyframe is repeated.
+			const animation::packed_keyframe *keyframes;
+			uint8_t time_scale;
+			animation::color_space interpolation_space;
+			/*
+			 * 1-bit per led, use _set_active_leds(). When inactive, the origin
+			 * keyframe is repeated. LEDs holding their last keyframe are
+			 * deactivated since their color no longer changes.
+			 */
 			uint16_t active;
 			uint8_t brightness;
-		} keyframed;
-	} _config;
-	union {
-		struct {
-			uint8_t start_position;
-		} legacy;
+			uint8_t period_ms;
+			// 1-bit per led, the layer is hidden when empty.
+			uint16_t mask;
+		} config;
 		struct {
 			union {
 				struct {
-					uint8_t position : 4;
-					uint8_t ticks_in_position;
+					uint16_t last_advance_time_ms;
 				} shooting_star;
+				struct {
+					uint16_t next_spawn_time_ms[_max_spark_count];
+				} sparks;
+				struct {
+					uint8_t pc;
+					uint8_t registers[led::program::register_count];
+					uint8_t ticks_to_wait;
+					uint8_t loop_depth;
+					struct {
+						uint8_t start_pc;
+						// 0 when looping forever.
+						uint8_t iterations_left;
+					} loops[led::program::max_loop_depth];
+					uint8_t fade_target;
+					uint8_t fade_ticks_left;
+				} program;
 			};
 
 			indice_storage_element origin_keyframe_index[8];
 			indice_storage_element destination_keyframe_index[8];
-			uint8_t ticks_since_start_of_animation[16];
-		} keyframed;
-	} _state;
+			/*
+			 * Time at which each active LED's animation started, on the low 16
+			 * bits of the clock. An LED's animation time is _time_ms - led_time_ms;
+			 * it is moved back when the animation loops, so it never grows past
+			 * the animation's length. Inactive LEDs hold their animation time
+			 * instead, which needs no update while they aren't evaluated.
+			 */
+			uint16_t led_time_ms[16];
+			/*
+			 * Times are stored as steps from the previous keyframe: keyframe cache
+			 * misses are decoded by moving a cursor from the last decoded keyframe.
+			 */
+			uint8_t keyframe_cursor_index;
+			uint16_t keyframe_cursor_time;
+			/*
+			 * Brightness the layer's LEDs were last set at, after the power limiter.
+			 * Pixels are written to the NeoPixel buffer as-is, bypassing its own
+			 * brightness scaling.
+			 */
+			uint8_t output_brightness;
+		} state;
+	};
+
+	layer _layers[_layer_count];
+	// Layer being configured or ticked, see _select_layer().
+	layer *_layer;
+	uint8_t _layer_id;
+	// Idle animation of the base layer, 0xff before the first one is set.
+	uint8_t _idle_animation_id;
+	// Network time of the current tick or animation change.
+	scheduling::absolute_time_ms _network_time_ms;
+	// Low 16 bits of _network_time_ms.
+	uint16_t _time_ms;
+	uint32_t _network_time_offset_ms;
+	uint8_t _peer_id;
+	uint8_t _peer_count;
+
+	/*
+	 * Direct-mapped cache of decoded keyframes, indexed by keyframe index and
+	 * shared by the layers. LEDs mostly share a few segments, which saves
+	 * reading them from flash for every LED on every tick.
+	 */
+	struct {
+		keyframe keyframes[config::led::keyframe_cache_size];
+		// Phase rate of the segment ending at each keyframe.
+		interpolation::phase_rate segment_rates[config::led::keyframe_cache_size];
+		// Keyframe colors in HSV, only decoded for animations interpolated in HSV.
+		interpolation::hsv_color hsv_colors[config::led::keyframe_cache_size];
+		// (layer << 4) | keyframe index held by each slot, 0xff when empty.
+		uint8_t indices[config::led::keyframe_cache_size];
+		// Hit-rate counters, wrap around.
+		uint16_t hits;
+		uint16_t misses;
+	} _keyframe_cache;
+
+	void _select_layer(uint8_t layer_id) noexcept;
+	// Start an idle animation in the base layer.
+	void _set_idle_animation(uint8_t id) noexcept;
+	// Show the current layer on the LEDs of a mask, over the layers below it.
+	void _set_layer_mask(uint16_t mask) noexcept;
+	// Run the strip at the period of the top-most visible layer.
+	void _update_period() noexcept;
 
 	uint8_t _get_keyframe_index(const indice_storage_element *indices,
 				    uint8_t led_id) const noexcept;
 	void _set_keyframe_index(indice_storage_element *indices,
 				 uint8_t led_id,
 				 uint8_t index) noexcept;
+	// Set the keyframes of the current animation, invalidating the keyframe cache.
+	void _set_keyframes(const animation::descriptor& animation) noexcept;
+	void _set_keyframe_range(const animation::descriptor& animation,
+				 uint8_t first_keyframe_index,
+				 uint8_t keyframe_count) noexcept;
+	// Cache slot holding a decoded keyframe of the current animation.
+	uint8_t _keyframe_slot(uint8_t index) noexcept;
+	keyframe _keyframe(uint8_t index) noexcept;
+
+	// Restart an LED's animation, time_ms into it. The animation's loop applies.
+	void _set_led_time(uint8_t led_id, uint16_t time_ms) noexcept;
+	// Fold a time into the current animation's loop, as the LEDs do when it loops.
+	uint16_t _loop_time(uint32_t time_ms) noexcept;
+	// Set the current layer's active LEDs, converting the times of those that toggle.
+	void _set_active_leds(uint16_t active) noexcept;
 
 	void _set_shooting_star_animation(uint8_t star_count,
 					  unsigned int advance_interval_ms,
-					  const keyframe *keyframe,
-					  uint8_t keyframe_count) noexcept;
+					  const animation::descriptor& animation) noexcept;
+
+	void _set_sparks_animation(uint8_t spark_count,
+				   uint16_t spawn_interval_ms,
+				   const animation::descriptor& animation) noexcept;
 
-	void _set_keyframed_cycle_animation(const keyframe *keyframe,
-					    uint8_t keyframe_count,
+	void _set_keyframed_cycle_animation(const animation::descriptor& animation,
 					    uint8_t loop_point_index,
 					    uint16_t active_mask,
 					    uint8_t cycle_offset_between_frames,
 					    uint8_t refresh_rate) noexcept;
+
+	void _set_program_animation(const uint8_t *bytecode) noexcept;
+	// Set the current layer's tick period.
+	void _set_period(uint8_t period_ms) noexcept;
 };
 } // namespace nsec::led
 #endif // NSEC_LED_STRIP_ANIMATOR_HPP
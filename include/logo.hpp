@@ -8,79 +8,29 @@
 
 #include <Arduino.h>
 
+/*
+ * nsec_logo_data: 128x32, 512 bytes raw, 186 bytes packed (36%)
+ * decode: 184 flash reads (44 control, 113 literal, 27 run values),
+ *         512 byte stores (399 from runs)
+ * drawBitmap() equivalent: 512 flash reads, 4096 writePixel() calls
+ */
 const uint8_t PROGMEM nsec_logo_data[] = {
-	0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111,
-	0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111,
-	0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111,
-	0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111,
-	0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111,
-	0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111,
-	0b11111111, 0b10000000, 0b01111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111,
-	0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111,
-	0b11111111, 0b11111111, 0b11111111, 0b00000000, 0b00011111, 0b11111111, 0b11111111,
-	0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111,
-	0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111110, 0b00000000, 0b00011111,
-	0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111,
-	0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111110,
-	0b00011110, 0b00001111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111,
-	0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111,
-	0b11111111, 0b11111100, 0b00111111, 0b10001111, 0b11111111, 0b11111111, 0b11111111,
-	0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111,
-	0b11111111, 0b11111111, 0b11111111, 0b11111100, 0b00111111, 0b10000111, 0b11111111,
-	0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b00111110,
-	0b01111111, 0b11100000, 0b00000111, 0b11111111, 0b00111111, 0b11111100, 0b01110001,
-	0b10000111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111,
-	0b11111100, 0b00110000, 0b00001111, 0b11000000, 0b00000001, 0b11111000, 0b00000011,
-	0b11111100, 0b00000000, 0b00000111, 0b11111111, 0b11111111, 0b11111111, 0b11111111,
-	0b11111111, 0b11111111, 0b11110000, 0b00100000, 0b00000011, 0b10000000, 0b00000000,
-	0b11100000, 0b00000000, 0b11111100, 0b00000000, 0b00000111, 0b11111111, 0b11111111,
-	0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11110000, 0b00000000, 0b00000011,
-	0b00000000, 0b00000000, 0b11000000, 0b00000000, 0b01111100, 0b00000000, 0b00000011,
-	0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11110000,
-	0b00000000, 0b00000001, 0b00000000, 0b00000001, 0b10000000, 0b00000000, 0b00111000,
-	0b00000000, 0b00000011, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111,
-	0b11111111, 0b11110000, 0b00000000, 0b00000001, 0b10000111, 0b11100001, 0b00000000,
-	0b11000000, 0b00110000, 0b00000000, 0b00000111, 0b11111111, 0b11111111, 0b11111111,
-	0b11111111, 0b11111111, 0b11111111, 0b11110000, 0b00001111, 0b00000001, 0b10000111,
-	0b11111011, 0b00000011, 0b11110000, 0b00000000, 0b00011111, 0b10001111, 0b11111111,
-	0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11110000, 0b00011111,
-	0b10000000, 0b10000011, 0b11111110, 0b00000111, 0b11111000, 0b00000000, 0b00111111,
-	0b11011111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111,
-	0b11110000, 0b00111111, 0b10000000, 0b10000000, 0b11111110, 0b00000111, 0b11111100,
-	0b00000000, 0b01111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111,
-	0b11111111, 0b11111111, 0b11110000, 0b00111111, 0b10000000, 0b10000000, 0b00011110,
-	0b00000111, 0b11111100, 0b00000000, 0b01111111, 0b11111111, 0b11111111, 0b11111111,
-	0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11110000, 0b00111111, 0b10000000,
-	0b10000000, 0b00000100, 0b00000000, 0b00000000, 0b00000000, 0b11111111, 0b11111111,
-	0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11110000,
-	0b00111111, 0b10000000, 0b10000000, 0b00000000, 0b00000000, 0b00000000, 0b00000000,
-	0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111,
-	0b11111111, 0b11110000, 0b00111111, 0b10000000, 0b11000000, 0b00000000, 0b00000000,
-	0b00000000, 0b00000000, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111,
-	0b11111111, 0b11111111, 0b11111111, 0b11110000, 0b00111111, 0b10000000, 0b11111000,
-	0b00000000, 0b00000000, 0b00000000, 0b00000000, 0b01111111, 0b11111111, 0b11111111,
-	0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11110000, 0b00111111,
-	0b10000000, 0b11111111, 0b00000000, 0b00000111, 0b11111111, 0b11000000, 0b01111111,
-	0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111,
-	0b11110000, 0b00111111, 0b10000000, 0b11111111, 0b11000000, 0b00000111, 0b11111111,
-	0b11100000, 0b01111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111,
-	0b11111111, 0b11111111, 0b11110000, 0b00111111, 0b10000000, 0b10111111, 0b11100000,
-	0b00000011, 0b11111110, 0b11100000, 0b00111111, 0b11001111, 0b11111111, 0b11111111,
-	0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11110000, 0b00111111, 0b10000000,
-	0b10001111, 0b11100000, 0b00000001, 0b11111000, 0b01110000, 0b00001111, 0b00000111,
-	0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11110000,
-	0b00111111, 0b10000000, 0b10000000, 0b00000000, 0b00000000, 0b00000000, 0b00110000,
-	0b00000000, 0b00000011, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111,
-	0b11111111, 0b11110000, 0b00111111, 0b10000000, 0b10000000, 0b00000000, 0b10000000,
-	0b00000000, 0b00111000, 0b00000000, 0b00000011, 0b11111111, 0b11111111, 0b11111111,
-	0b11111111, 0b11111111, 0b11111111, 0b11110000, 0b00111111, 0b10000000, 0b10000000,
-	0b00000000, 0b11000000, 0b00000000, 0b01111100, 0b00000000, 0b00000111, 0b11111111,
-	0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11110000, 0b00111111,
-	0b10000000, 0b10000000, 0b00000001, 0b11110000, 0b00000000, 0b11111110, 0b00000000,
-	0b00001111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111,
-	0b11110000, 0b00111111, 0b10000000, 0b11000000, 0b00000111, 0b11111100, 0b00000011,
-	0b11111111, 0b11000000, 0b00111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111,
-	0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111,
-	0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111, 0b11111111,
-	0b11111111,
+	// Width, page count.
+	128, 4,
+	0xab, 0xff, 0x04, 0x3f, 0x0f, 0x07, 0x03, 0xc3, 0xfd, 0xe3, 0x05, 0xc3,
+	0xc3, 0x07, 0x07, 0x1f, 0x7f, 0xca, 0xff, 0x07, 0x03, 0x03, 0x01, 0x01,
+	0x00, 0x00, 0x07, 0x83, 0xfe, 0xc1, 0x01, 0xc0, 0x80, 0xfe, 0x01, 0x09,
+	0x03, 0x03, 0x0f, 0x7f, 0xe7, 0x03, 0x01, 0x00, 0x00, 0x60, 0xfc, 0xe0,
+	0x1a, 0xc0, 0xc0, 0x81, 0xc1, 0x73, 0x1f, 0x0f, 0x07, 0x03, 0x03, 0x81,
+	0xc1, 0xc1, 0xe0, 0xe0, 0xc1, 0xc1, 0x81, 0x01, 0x03, 0x03, 0x07, 0x0f,
+	0x3f, 0x3f, 0x1f, 0x0f, 0xfe, 0x00, 0x02, 0x01, 0x81, 0xc1, 0xfe, 0xc0,
+	0x06, 0xc1, 0xc1, 0x80, 0x00, 0x80, 0xc0, 0xe7, 0xcb, 0xff, 0xfb, 0x00,
+	0xfa, 0xff, 0xfa, 0x00, 0x01, 0xff, 0xf0, 0xfe, 0xe0, 0xfe, 0xc0, 0x06,
+	0x81, 0x81, 0x01, 0x03, 0x03, 0x07, 0x03, 0xfb, 0x00, 0xf8, 0xc3, 0xfd,
+	0xc0, 0x00, 0x80, 0xfc, 0x00, 0x00, 0x1c, 0xbe, 0xff, 0xfb, 0x80, 0xfa,
+	0xff, 0xfa, 0x80, 0x03, 0xff, 0xc0, 0x81, 0x81, 0xfa, 0x83, 0x0b, 0x80,
+	0x80, 0xc0, 0xc0, 0xe0, 0xf8, 0xf0, 0xe0, 0xe0, 0xc0, 0xc0, 0x81, 0xfb,
+	0x83, 0x09, 0x81, 0xc1, 0xc0, 0xe1, 0xf3, 0xff, 0xfe, 0xf8, 0xf0, 0xe0,
+	0xfe, 0xc0, 0x01, 0x81, 0x81, 0xfd, 0x83, 0x05, 0x81, 0x81, 0xc0, 0xc0,
+	0xe1, 0xf3, 0xe7, 0xff,
 };
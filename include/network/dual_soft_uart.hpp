@@ -0,0 +1,108 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2023 Jérémie Galarneau <jeremie.galarneau@gmail.com>
+ */
+
+#ifndef NSEC_NETWORK_DUAL_SOFT_UART_HPP
+#define NSEC_NETWORK_DUAL_SOFT_UART_HPP
+
+#include "config.hpp"
+#include "network/soft_uart.hpp"
+
+#include <stdint.h>
+
+/*
+ * Interrupt-driven software serial ports of both sides of the badge.
+ *
+ * Unlike SoftwareSerial, both receivers run at the same time: the start bits
+ * are caught by pin interrupts (INT0 for the left RX pin, PD2, and PCINT22 for
+ * the right one, PD6) and each side samples its bits on its own compare
+ * channel of Timer1 (A for the left, B for the right). Each side queues its
+ * bytes in its own buffer.
+ *
+ * Transmission is queued as well: each side drives its TX pin from its own
+ * compare channel of Timer3 (A for the left, B for the right), so the CPU
+ * doesn't wait while bytes go out. The handlers only delay each other by a
+ * fraction of a bit, well within the receivers' margin.
+ *
+ * The lines use inverted logic, as the badges always did: they idle low.
+ */
+namespace nsec::communication::dual_soft_uart {
+
+using receiver = soft_uart::receiver<nsec::config::communication::serial_receive_buffer_size>;
+using transmitter =
+	soft_uart::transmitter<nsec::config::communication::serial_transmit_buffer_size>;
+
+enum class side : uint8_t { LEFT, RIGHT };
+
+// Start Timer1, Timer3 and the reception on both sides.
+void begin() noexcept;
+
+class port {
+public:
+	explicit port(side port_side) noexcept;
+
+	/* Deactivate copy and assignment. */
+	port(const port&) = delete;
+	port(port&&) = delete;
+	port& operator=(const port&) = delete;
+	port& operator=(port&&) = delete;
+	~port() = default;
+
+	// Drive the TX pin, after dual_soft_uart::begin().
+	void begin() noexcept;
+
+	// Switch both directions to speed (bauds), once the queued bytes are sent.
+	void speed(uint32_t speed) noexcept;
+
+	uint8_t available() const noexcept
+	{
+		return _receiver.available();
+	}
+
+	// Byte offset bytes from the front, only valid when available() is greater than offset.
+	uint8_t peek(uint8_t offset = 0) const noexcept
+	{
+		return _receiver.peek(offset);
+	}
+
+	uint8_t read() noexcept
+	{
+		return _receiver.read();
+	}
+
+	// Read size bytes, which must be available.
+	void read(uint8_t *data, uint8_t size) noexcept;
+
+	// Drop the received bytes.
+	void flush() noexcept
+	{
+		_receiver.flush();
+	}
+
+	// A byte is being received.
+	bool is_receiving() const noexcept
+	{
+		return _receiver.is_receiving();
+	}
+
+	// Bytes are queued or being sent.
+	bool is_transmitting() const noexcept
+	{
+		return _transmitter.is_transmitting();
+	}
+
+	// Queue bytes, only waits when the transmit buffer is full.
+	void write(uint8_t value) noexcept;
+	void write(const uint8_t *data, uint8_t size) noexcept;
+
+private:
+	receiver& _receiver;
+	transmitter& _transmitter;
+	const side _side;
+};
+
+} // namespace nsec::communication::dual_soft_uart
+
+#endif // NSEC_NETWORK_DUAL_SOFT_UART_HPP
@@ -0,0 +1,62 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2023 Jérémie Galarneau <jeremie.galarneau@gmail.com>
+ */
+
+#ifndef NSEC_NETWORK_ID_EXCHANGER_HPP
+#define NSEC_NETWORK_ID_EXCHANGER_HPP
+
+#include "network/network_handler.hpp"
+#include "network_messages.hpp"
+
+#include <stdint.h>
+
+namespace nsec::communication {
+
+/*
+ * Exchanges the badges' IDs once the chain is paired. The badge is notified of
+ * each ID it receives and of the end of the exchange.
+ */
+class id_exchanger {
+public:
+	id_exchanger() = default;
+
+	/* Deactivate copy and assignment. */
+	id_exchanger(const id_exchanger&) = delete;
+	id_exchanger(id_exchanger&&) = delete;
+	id_exchanger& operator=(const id_exchanger&) = delete;
+	id_exchanger& operator=(id_exchanger&&) = delete;
+	~id_exchanger() = default;
+
+	void start(network_handler& handler) noexcept;
+	network_handler::application_message_action new_message(network_handler& handler,
+								message::type msg_type,
+								const uint8_t *payload) noexcept;
+	// Retry sending a fragment the network handler had no room for.
+	void tick(network_handler& handler) noexcept;
+	void reset() noexcept;
+	uint8_t new_badges_discovered() const noexcept
+	{
+		return uint8_t(_new_badges_discovered);
+	}
+
+private:
+	bool _send_ours(network_handler& handler, peer_relative_position direction) noexcept;
+	bool _send(network_handler& handler,
+		   peer_relative_position direction,
+		   const message::badge_id_vector& fragment) noexcept;
+	void _send_pending_fragment(network_handler& handler) noexcept;
+	void _check_completion(const network_handler& handler) noexcept;
+
+	message::badge_id_vector _pending_fragment;
+	uint8_t _new_badges_discovered : 5;
+	uint8_t _badge_id_received_count : 5;
+	bool _has_pending_fragment : 1;
+	// Storage for peer_relative_position
+	uint8_t _pending_fragment_direction : 1;
+};
+
+} // namespace nsec::communication
+
+#endif // NSEC_NETWORK_ID_EXCHANGER_HPP
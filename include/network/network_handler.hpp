@@ -9,11 +9,10 @@
 
 #include "callback.hpp"
 #include "config.hpp"
+#include "network/dual_soft_uart.hpp"
 #include "network_messages.hpp"
 #include "scheduler.hpp"
 
-#include <SoftwareSerial.h>
-
 namespace nsec::communication {
 
 enum class peer_relative_position : uint8_t {
@@ -65,11 +64,42 @@ public:
 	};
 	link_position position() const noexcept;
 
+	/*
+	 * Offset of the network time, peer 0's clock, from our clock. It is
+	 * measured on the MONITOR messages received from the left.
+	 */
+	uint32_t network_time_offset_ms() const noexcept
+	{
+		return _network_time_offset_ms;
+	}
+
+	/*
+	 * Messages are sent in order, per direction, when the wave front passes:
+	 * those queued fill a window and go out back to back. FULL is returned when
+	 * the queue has no room left for the message.
+	 */
 	enum class enqueue_message_result : uint8_t { QUEUED, UNCONNECTED, FULL };
 	enqueue_message_result enqueue_app_message(peer_relative_position direction,
 						   uint8_t msg_type,
 						   const uint8_t *msg_payload);
 
+	/*
+	 * True when no byte is expected from our peers. Masking interrupts (e.g. to
+	 * drive the LEDs) is then harmless to serial reception.
+	 */
+	bool is_line_quiet() noexcept;
+
+	// Link error counters (wrap around), for profiling.
+	uint16_t corrupted_message_count() const noexcept
+	{
+		return _corrupted_message_count;
+	}
+
+	uint16_t retransmission_count() const noexcept
+	{
+		return _retransmission_count;
+	}
+
 protected:
 	void run(scheduling::absolute_time_ms current_time_ms) noexcept override;
 
@@ -82,21 +112,17 @@ private:
 		/* Discover left neighbours. */
 		DISCOVERY_RECEIVE_ANNOUNCE,
 		DISCOVERY_RECEIVE_MONITOR_AFTER_ANNOUNCE,
+		/* Send ANNOUNCE and MONITOR at once, confirmed together. */
 		DISCOVERY_SEND_ANNOUNCE,
-		DISCOVERY_CONFIRM_ANNOUNCE,
-		DISCOVERY_SEND_MONITOR_AFTER_ANNOUNCE,
 		DISCOVERY_CONFIRM_MONITOR_AFTER_ANNOUNCE,
 		DISCOVERY_RECEIVE_ANNOUNCE_REPLY,
 		DISCOVERY_RECEIVE_MONITOR_AFTER_ANNOUNCE_REPLY,
 		DISCOVERY_SEND_ANNOUNCE_REPLY,
-		DISCOVERY_CONFIRM_ANNOUNCE_REPLY,
-		DISCOVERY_SEND_MONITOR_AFTER_ANNOUNCE_REPLY,
 		DISCOVERY_CONFIRM_MONITOR_AFTER_ANNOUNCE_REPLY,
 		/* Waiting for application and protocol (MONITOR and RESET) messages. */
 		RUNNING_RECEIVE_MESSAGE,
+		/* Send the queued application messages, if any, followed by MONITOR. */
 		RUNNING_SEND_APP_MESSAGE,
-		RUNNING_CONFIRM_APP_MESSAGE,
-		RUNNING_SEND_MONITOR,
 		RUNNING_CONFIRM_MONITOR
 
 	};
@@ -106,12 +132,6 @@ private:
 		RECEIVE_HEADER,
 		RECEIVE_PAYLOAD,
 	};
-	enum class message_transmission_state : uint8_t {
-		NONE,
-		ATTEMPT_SEND,
-		// On timeout, retransmit until timeout
-		WAIT_CONFIRMATION,
-	};
 
 	void _position(link_position new_role) noexcept;
 
@@ -123,29 +143,46 @@ private:
 	void _reverse_wave_front_direction() noexcept;
 
 	peer_relative_position _listening_side() const noexcept;
-	SoftwareSerial& _listening_side_serial() noexcept;
+	dual_soft_uart::port& _listening_side_serial() noexcept;
 	void _listening_side(peer_relative_position side) noexcept;
 	void _reverse_listening_side() noexcept;
+	dual_soft_uart::port& _serial(peer_relative_position side) noexcept;
+
+	// Link speeds, as indices in serial_speeds.
+	uint8_t _max_link_speed_index(peer_relative_position side) const noexcept;
+	void _link_speed(peer_relative_position side, uint8_t speed_index) noexcept;
+	bool _acknowledge(nsec::scheduling::absolute_time_ms current_time_ms,
+			  uint8_t negotiated_message_type) noexcept;
+	void _on_link_speed_offer(uint8_t speed_index) noexcept;
+
+	// Sequence numbers of our next new message to a side, and of the next one expected from it.
+	uint8_t _next_sequence(peer_relative_position side) const noexcept;
+	void _next_sequence(peer_relative_position side, uint8_t sequence) noexcept;
+	uint8_t _expected_sequence(peer_relative_position side) const noexcept;
+	void _expected_sequence(peer_relative_position side, uint8_t sequence) noexcept;
 
 	message_reception_state _message_reception_state() const noexcept;
 	void _message_reception_state(message_reception_state new_state) noexcept;
 
-	// Message tranmsmission state machine.
-	message_transmission_state _message_transmission_state() const noexcept;
-	void _message_transmission_state(message_transmission_state new_state) noexcept;
+	// Window of outgoing messages, see _handle_transmission().
 	peer_relative_position _outgoing_message_direction() const noexcept;
 	void _outgoing_message_direction(peer_relative_position) noexcept;
-	uint8_t _outgoing_message_size() const noexcept;
-	void _clear_outgoing_message() noexcept;
-	void _set_outgoing_message(nsec::scheduling::absolute_time_ms current_time_ms,
-				   uint8_t message_type,
-				   const uint8_t *message_payload = nullptr) noexcept;
-
-	// Message transmission request from an application.
-	peer_relative_position _pending_outgoing_app_message_direction() const noexcept;
-	uint8_t _pending_outgoing_app_message_size() const noexcept;
-	bool _has_pending_outgoing_app_message() const noexcept;
-	void _clear_pending_outgoing_app_message() noexcept;
+	void _clear_outgoing_messages() noexcept;
+	void _enqueue_outgoing_message(uint8_t message_type,
+				       const uint8_t *message_payload = nullptr) noexcept;
+	void _send_outgoing_messages(nsec::scheduling::absolute_time_ms current_time_ms) noexcept;
+	void _release_outgoing_messages(uint8_t count) noexcept;
+	void _on_acknowledgement(nsec::scheduling::absolute_time_ms current_time_ms,
+				 uint8_t message_type,
+				 uint8_t sequence,
+				 const uint8_t *message_payload) noexcept;
+
+	// Side our messages go to: our only peer, or the wave front's direction.
+	peer_relative_position _sending_side() const noexcept;
+
+	// Queues of the messages enqueued by the application, see enqueue_app_message().
+	bool _dequeue_app_message(peer_relative_position direction) noexcept;
+	void _clear_app_messages() noexcept;
 
 	enum class check_connections_result : uint8_t {
 		NO_CHANGE,
@@ -154,6 +191,9 @@ private:
 	check_connections_result _check_connections() noexcept;
 
 	void _detect_and_set_position() noexcept;
+	void _network_time_offset(uint32_t offset_ms) noexcept;
+	void _synchronize_network_time(uint32_t peer_network_time_ms,
+				       nsec::scheduling::absolute_time_ms current_time_ms) noexcept;
 	void _run_wire_protocol(nsec::scheduling::absolute_time_ms current_time_ms) noexcept;
 	void _reset() noexcept;
 
@@ -165,10 +205,14 @@ private:
 		INCOMPLETE,
 		COMPLETE,
 		CORRUPTED,
+		// Only acknowledgements were expected, the next message is left unread.
+		MESSAGE_PENDING,
 	};
-	handle_reception_result _handle_reception(SoftwareSerial&,
+	handle_reception_result _handle_reception(dual_soft_uart::port&,
 						  uint8_t& message_type,
-						  uint8_t *message_payload) noexcept;
+						  uint8_t& message_sequence,
+						  uint8_t *message_payload,
+						  bool acknowledgements_only = false) noexcept;
 
 	enum class handle_transmission_result : uint8_t {
 		COMPLETE,
@@ -181,14 +225,27 @@ private:
 	static bool _is_wire_protocol_in_a_running_state(wire_protocol_state state) noexcept;
 	static void _log_wire_protocol_state(wire_protocol_state state) noexcept;
 	static void _log_message_reception_state(message_reception_state state) noexcept;
-	static void _log_message_transmission_state(message_transmission_state state) noexcept;
 
-	SoftwareSerial _left_serial;
-	SoftwareSerial _right_serial;
+	dual_soft_uart::port _left_serial;
+	dual_soft_uart::port _right_serial;
 	nsec::scheduling::absolute_time_ms _last_message_received_time_ms;
+	nsec::scheduling::absolute_time_ms _last_ok_sent_time_ms;
+	uint32_t _network_time_offset_ms;
+	uint16_t _corrupted_message_count;
+	uint16_t _retransmission_count;
 
 	uint8_t _is_left_connected : 1;
 	uint8_t _is_right_connected : 1;
+	// The network time offset was measured since the last reset.
+	uint8_t _is_network_time_synchronized : 1;
+	// A link stalled at a negotiated speed, it stays at the base speed until unplugged.
+	uint8_t _is_left_link_speed_limited : 1;
+	uint8_t _is_right_link_speed_limited : 1;
+
+	// Speed of each link, and fastest speed accepted by the peer we announced ourselves to.
+	uint8_t _left_link_speed_index : 2;
+	uint8_t _right_link_speed_index : 2;
+	uint8_t _right_peer_max_speed_index : 2;
 
 	// Storage for a link_position enum
 	uint8_t _current_position : 2;
@@ -212,25 +269,39 @@ private:
 	// Number of bytes left to receive for the current message
 	uint8_t _payload_bytes_to_receive : 5;
 
-	// Storage for a message_transmission_state enum
-	uint8_t _current_message_transmission_state : 2;
-	uint8_t _current_message_being_sent_size : 5;
-	// Storage for a peer_relative_location enum
-	uint8_t _current_message_being_sent_direction : 1;
-	uint8_t _current_message_being_sent_type : 5;
+	// Sequence numbers (modulo 8) of our next new message to each side.
+	uint8_t _left_next_sequence : 3;
+	uint8_t _right_next_sequence : 3;
+	// Sequence numbers (modulo 8) of the next message expected from each side.
+	uint8_t _left_expected_sequence : 3;
+	uint8_t _right_expected_sequence : 3;
 
-	// App-level enqueued message
 	// Storage for a peer_relative_location enum
-	uint8_t _current_pending_outgoing_app_message_direction : 1;
-	uint8_t _current_pending_outgoing_app_message_size : 5;
-	// Enqueued outgoing application message type and payload.
-	uint8_t _current_pending_outgoing_app_message_type : 5;
-	uint8_t _current_pending_outgoing_app_message_payload
-		[nsec::config::communication::protocol_max_message_size];
-
-	// Message currently being sent and potentially retransmitted.
+	uint8_t _current_outgoing_message_direction : 1;
+	// Messages in the window, and how many of them were sent since the last timeout.
+	uint8_t _outgoing_message_count : 3;
+	uint8_t _sent_outgoing_message_count : 3;
+
+	/*
+	 * App-level enqueued messages, each stored as its type and payload. Both
+	 * directions share the arena: messages to the left fill it from its start
+	 * and messages to the right from its end, the oldest outermost.
+	 */
+	uint8_t _left_app_messages_size;
+	uint8_t _right_app_messages_size;
+	uint8_t _app_messages[nsec::config::communication::application_message_queue_size];
+
+	/*
+	 * Messages sent, and potentially retransmitted, until acknowledged: oldest
+	 * first, followed by those not sent yet.
+	 */
 	nsec::scheduling::absolute_time_ms _last_transmission_time_ms;
-	uint8_t _current_message_being_sent[nsec::config::communication::protocol_max_message_size];
+	struct outgoing_message {
+		uint8_t type;
+		// Largest payload, of the application's messages.
+		uint8_t payload[sizeof(nsec::communication::message::badge_id_vector)];
+	};
+	outgoing_message _outgoing_messages[nsec::config::communication::transmit_window_size];
 };
 } // namespace nsec::communication
 
@@ -8,23 +8,29 @@
 #define NSEC_NETWORK_MESSAGES_HPP
 
 #include "config.hpp"
-#include "unique_id.hpp"
 
 #include <stdint.h>
 
 namespace nsec::communication::message {
 
 enum class type : uint8_t {
-	ANNOUNCE_BADGE_ID =
-		nsec::config::communication::application_message_type_range_begin,
+	// Fragments of the badges' IDs, filled in from left to right.
+	COLLECT_BADGE_IDS = nsec::config::communication::application_message_type_range_begin,
+	// Fragments of the complete vector, sent back from right to left.
+	BROADCAST_BADGE_IDS,
 	PAIRING_ANIMATION_PART_1_DONE,
 	PAIRING_ANIMATION_PART_2_DONE,
 	PAIRING_ANIMATION_DONE,
 };
 
-struct announce_badge_id {
-	uint8_t peer_id;
-	uint8_t board_unique_id[UniqueIDsize];
+/*
+ * A fragment of the vector of the badges' IDs, indexed by peer id. A fragment
+ * only holds IDs from first_peer_id on; the ones past the last peer are unset.
+ */
+struct badge_id_vector {
+	uint8_t first_peer_id;
+	// Last 4 bytes of the boards' unique IDs.
+	uint32_t ids[nsec::config::communication::badge_id_vector_fragment_size];
 } __attribute__((packed));
 
 } // namespace nsec::communication::message
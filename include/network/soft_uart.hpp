@@ -0,0 +1,285 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2023 Jérémie Galarneau <jeremie.galarneau@gmail.com>
+ */
+
+#ifndef NSEC_NETWORK_SOFT_UART_HPP
+#define NSEC_NETWORK_SOFT_UART_HPP
+
+#include <stdint.h>
+
+/*
+ * Bit-level framing of a software UART (8N1), independent of the hardware.
+ * Both directions are driven by interrupts, the CPU never waits on the line.
+ *
+ * Levels are logical: a mark (1, the idle line) is true. A frame is made of a
+ * start bit (space), eight data bits, least significant first, and a stop bit
+ * (mark).
+ */
+namespace nsec::communication::soft_uart {
+
+constexpr uint8_t frame_bit_count = 10;
+
+// Level of the line during bit bit_index of the frame of value.
+constexpr bool frame_level(uint8_t value, uint8_t bit_index) noexcept
+{
+	if (bit_index == 0) {
+		return false;
+	}
+
+	if (bit_index == frame_bit_count - 1) {
+		return true;
+	}
+
+	return (value >> (bit_index - 1)) & 1;
+}
+
+/*
+ * Receiver of one line, timed by a free-running 16-bit timer.
+ *
+ * The leading edge of a start bit starts the reception; the line is then
+ * sampled in the middle of each bit, at the ticks the receiver schedules. A
+ * start bit that is gone by its middle is a glitch and is ignored, a frame
+ * without a stop bit is dropped.
+ *
+ * start() and sample() are called from interrupt handlers, the other methods
+ * from the application. Bytes are passed through a ring of buffer_size bytes,
+ * holding up to buffer_size - 1 of them: with a single producer and a single
+ * consumer, neither side needs to mask interrupts.
+ */
+template <uint8_t buffer_size>
+class receiver {
+	static_assert((buffer_size & (buffer_size - 1)) == 0, "buffer_size must be a power of two");
+
+public:
+	// Duration of a bit, in timer ticks.
+	void bit_ticks(uint16_t ticks) noexcept
+	{
+		_bit_ticks = ticks;
+	}
+
+	// Start bit beginning at edge_tick, returns the tick of the first sample.
+	uint16_t start(uint16_t edge_tick) noexcept
+	{
+		_bit_index = 0;
+		_next_sample_tick = edge_tick + _bit_ticks / 2;
+		return _next_sample_tick;
+	}
+
+	/*
+	 * Level of the line at the scheduled tick. Returns true if another sample
+	 * is due, at next_sample_tick(), and false once the frame is over: the
+	 * next start bit may then be awaited.
+	 */
+	bool sample(bool level) noexcept
+	{
+		const uint8_t bit_index = _bit_index;
+
+		if (bit_index == 0) {
+			if (level) {
+				// Glitch.
+				_bit_index = frame_bit_count;
+				return false;
+			}
+		} else if (bit_index < frame_bit_count - 1) {
+			_shift_register = (_shift_register >> 1) | (level ? 0x80 : 0);
+		} else {
+			_bit_index = frame_bit_count;
+
+			if (!level) {
+				_framing_error_count++;
+				return false;
+			}
+
+			_push(_shift_register);
+			return false;
+		}
+
+		_bit_index = bit_index + 1;
+		_next_sample_tick += _bit_ticks;
+		return true;
+	}
+
+	uint16_t next_sample_tick() const noexcept
+	{
+		return _next_sample_tick;
+	}
+
+	// A frame is being received.
+	bool is_receiving() const noexcept
+	{
+		return _bit_index != frame_bit_count;
+	}
+
+	uint8_t available() const noexcept
+	{
+		return uint8_t(_head - _tail) & (buffer_size - 1);
+	}
+
+	// Byte offset bytes from the front, only valid when available() is greater than offset.
+	uint8_t peek(uint8_t offset = 0) const noexcept
+	{
+		return _buffer[(_tail + offset) & (buffer_size - 1)];
+	}
+
+	uint8_t read() noexcept
+	{
+		const uint8_t tail = _tail;
+		const uint8_t value = _buffer[tail];
+
+		_tail = (tail + 1) & (buffer_size - 1);
+		return value;
+	}
+
+	// Drop the received bytes.
+	void flush() noexcept
+	{
+		_tail = _head;
+	}
+
+	// Error counters (wrap around), for profiling.
+	uint8_t framing_error_count() const noexcept
+	{
+		return _framing_error_count;
+	}
+
+	uint8_t overflow_count() const noexcept
+	{
+		return _overflow_count;
+	}
+
+private:
+	void _push(uint8_t value) noexcept
+	{
+		const uint8_t head = _head;
+		const uint8_t next_head = (head + 1) & (buffer_size - 1);
+
+		if (next_head == _tail) {
+			// The application is late, drop the byte.
+			_overflow_count++;
+			return;
+		}
+
+		_buffer[head] = value;
+		_head = next_head;
+	}
+
+	volatile uint8_t _buffer[buffer_size] = {};
+	// Written by the interrupt handlers.
+	volatile uint8_t _head = 0;
+	// Written by the application.
+	volatile uint8_t _tail = 0;
+	// Next bit to sample, frame_bit_count when waiting for a start bit.
+	volatile uint8_t _bit_index = frame_bit_count;
+	uint8_t _shift_register = 0;
+	volatile uint8_t _framing_error_count = 0;
+	volatile uint8_t _overflow_count = 0;
+	uint16_t _bit_ticks = 0;
+	uint16_t _next_sample_tick = 0;
+};
+
+/*
+ * Transmitter of one line, timed by a free-running 16-bit timer.
+ *
+ * The application queues bytes with push() and starts the transmission; the
+ * interrupt handler of the timer then calls edge() at each scheduled tick to
+ * get the level to drive, until all queued frames, up to their stop bit, are
+ * sent. Bytes are passed through a ring as in the receiver.
+ */
+template <uint8_t buffer_size>
+class transmitter {
+	static_assert((buffer_size & (buffer_size - 1)) == 0, "buffer_size must be a power of two");
+
+public:
+	// Duration of a bit, in timer ticks.
+	void bit_ticks(uint16_t ticks) noexcept
+	{
+		_bit_ticks = ticks;
+	}
+
+	// Queue a byte, returns false if the buffer is full.
+	bool push(uint8_t value) noexcept
+	{
+		const uint8_t head = _head;
+		const uint8_t next_head = (head + 1) & (buffer_size - 1);
+
+		if (next_head == _tail) {
+			return false;
+		}
+
+		_buffer[head] = value;
+		_head = next_head;
+		return true;
+	}
+
+	/*
+	 * Start sending the queued bytes, the first edge being at tick. Returns
+	 * false, and does nothing, if the transmission is already running. Must
+	 * not be interrupted by edge().
+	 */
+	bool start(uint16_t tick) noexcept
+	{
+		if (_is_transmitting) {
+			return false;
+		}
+
+		_is_transmitting = true;
+		_bit_index = frame_bit_count;
+		_next_edge_tick = tick;
+		return true;
+	}
+
+	/*
+	 * At the scheduled tick, returns true and the level to drive until
+	 * next_edge_tick(), or false once all frames are sent.
+	 */
+	bool edge(bool& level) noexcept
+	{
+		if (_bit_index == frame_bit_count) {
+			const uint8_t tail = _tail;
+
+			if (tail == _head) {
+				_is_transmitting = false;
+				return false;
+			}
+
+			_value = _buffer[tail];
+			_tail = (tail + 1) & (buffer_size - 1);
+			_bit_index = 0;
+		}
+
+		level = frame_level(_value, _bit_index);
+		_bit_index++;
+		_next_edge_tick += _bit_ticks;
+		return true;
+	}
+
+	uint16_t next_edge_tick() const noexcept
+	{
+		return _next_edge_tick;
+	}
+
+	// Bytes are queued or being sent.
+	bool is_transmitting() const noexcept
+	{
+		return _is_transmitting || _head != _tail;
+	}
+
+private:
+	volatile uint8_t _buffer[buffer_size] = {};
+	// Written by the application.
+	volatile uint8_t _head = 0;
+	// Written by the interrupt handler.
+	volatile uint8_t _tail = 0;
+	volatile bool _is_transmitting = false;
+	// Next bit to send, frame_bit_count between frames.
+	uint8_t _bit_index = frame_bit_count;
+	uint8_t _value = 0;
+	uint16_t _bit_ticks = 0;
+	uint16_t _next_edge_tick = 0;
+};
+
+} // namespace nsec::communication::soft_uart
+
+#endif // NSEC_NETWORK_SOFT_UART_HPP
@@ -0,0 +1,50 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2023 Jérémie Galarneau <jeremie.galarneau@gmail.com>
+ *
+ * This header was auto-generated; see the animations folder.
+ */
+
+#include "led/program.hpp"
+
+// 4 programs, 120 bytes
+
+// rain: 22 bytes
+const uint8_t PROGMEM nsec_program_rain[] = {
+	0x3c, 0x14, 0x34, 0x32, 0x30, 0x04, 0x04, 0x03,
+	0x2c, 0xff, 0xff, 0x28, 0x03, 0x08, 0x00, 0x18,
+	0x10, 0x1c, 0x04, 0x07, 0x0c, 0x00,
+};
+
+// rainbow_chase: 22 bytes
+const uint8_t PROGMEM nsec_program_rainbow_chase[] = {
+	0x3c, 0x14, 0x34, 0x00, 0x30, 0x21, 0x0e, 0x01,
+	0x38, 0x32, 0x32, 0x10, 0x00, 0x08, 0x10, 0x1c,
+	0x14, 0x01, 0x04, 0x05, 0x0c, 0x00,
+};
+
+// breathing_wave: 43 bytes
+const uint8_t PROGMEM nsec_program_breathing_wave[] = {
+	0x3c, 0x14, 0x34, 0x00, 0x2c, 0xff, 0xff, 0x08,
+	0x00, 0x30, 0x12, 0x04, 0x01, 0x28, 0x06, 0x38,
+	0x32, 0x19, 0x04, 0xfa, 0x38, 0x00, 0x19, 0x04,
+	0x19, 0x30, 0x14, 0x04, 0x01, 0x28, 0x06, 0x38,
+	0x32, 0x19, 0x04, 0xfa, 0x38, 0x00, 0x19, 0x04,
+	0x19, 0x0c, 0x00,
+};
+
+// sparkle: 25 bytes
+const uint8_t PROGMEM nsec_program_sparkle[] = {
+	0x3c, 0x14, 0x34, 0x32, 0x30, 0x24, 0x14, 0x03,
+	0x2c, 0xff, 0xff, 0x28, 0x04, 0x08, 0x00, 0x18,
+	0x10, 0x1c, 0x19, 0x10, 0x1d, 0x04, 0x04, 0x0c,
+	0x00,
+};
+
+const uint8_t *const PROGMEM nsec_programs[] = {
+	nsec_program_rain,
+	nsec_program_rainbow_chase,
+	nsec_program_breathing_wave,
+	nsec_program_sparkle,
+};
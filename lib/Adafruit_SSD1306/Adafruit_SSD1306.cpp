@@ -769,14 +769,29 @@ uint8_t *Adafruit_SSD1306::getBuffer(void) { return buffer; }
             called. Call after each graphics command, or after a whole set
             of graphics commands, as best needed by one's own application.
 */
-void Adafruit_SSD1306::display(void) {
+void Adafruit_SSD1306::display(void) { display(0, ((HEIGHT + 7) / 8) - 1); }
+
+/*!
+    @brief  Push a range of pages (8-pixel rows) currently in RAM to the
+            SSD1306 display.
+    @param  first_page
+            First page to transfer.
+    @param  last_page
+            Last page to transfer (inclusive).
+    @return None (void).
+    @note   Only the pages in the range are sent over the bus, which is
+            significantly cheaper than a full display() when only part of
+            the screen changed.
+*/
+void Adafruit_SSD1306::display(uint8_t first_page, uint8_t last_page) {
   TRANSACTION_START
-  static const uint8_t PROGMEM dlist1[] = {
-      SSD1306_PAGEADDR,
-      0,                      // Page start address
-      0xFF,                   // Page end (not really, but works here)
-      SSD1306_COLUMNADDR, 0}; // Column start address
+  static const uint8_t PROGMEM dlist1[] = {SSD1306_PAGEADDR};
   ssd1306_commandList(dlist1, sizeof(dlist1));
+  ssd1306_command1(first_page); // Page start address
+  ssd1306_command1(last_page);  // Page end address
+  static const uint8_t PROGMEM dlist2[] = {SSD1306_COLUMNADDR,
+                                           0}; // Column start address
+  ssd1306_commandList(dlist2, sizeof(dlist2));
   ssd1306_command1(WIDTH - 1); // Column end address
 
 #if defined(ESP8266)
@@ -788,8 +803,8 @@ void Adafruit_SSD1306::display(void) {
   // 32-byte transfer condition below.
   yield();
 #endif
-  uint16_t count = WIDTH * ((HEIGHT + 7) / 8);
-  uint8_t *ptr = buffer;
+  uint16_t count = WIDTH * (last_page - first_page + 1);
+  uint8_t *ptr = buffer + (WIDTH * first_page);
     wire->beginTransmission(i2caddr);
     WIRE_WRITE((uint8_t)0x40);
     uint16_t bytesOut = 1;
@@ -140,6 +140,7 @@ public:
              bool reset = true, bool periphBegin = true,
              uint8_t *staticBuffer = nullptr);
   void display(void);
+  void display(uint8_t first_page, uint8_t last_page);
   void clearDisplay(void);
   void invertDisplay(bool i);
   void dim(bool dim);
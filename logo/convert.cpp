@@ -4,11 +4,234 @@
  * Copyright 2023 Jérémie Galarneau <jeremie.galarneau@gmail.com>
  */
 
+/*
+ * Asset compiler for the badge's bitmaps.
+ *
+ * Converts 1bpp images to PackBits-compressed assets laid out in the SSD1306's
+ * native page/column order: each byte holds a column of 8 vertical pixels (LSB
+ * on top) and pages of 8 pixel rows follow each other. This is the layout of
+ * the renderer's frame buffer, which allows the firmware to stream decoded
+ * bytes straight into it (see nsec::display::utils::draw_packed_bitmap).
+ *
+ * The NorthSec logo is always emitted from the GIMP header. Additional assets
+ * can be provided as PBM (P1 or P4) files; their symbol is derived from their
+ * file name. Set pixels are lit.
+ *
+ * Usage:
+ *   g++ -std=c++17 -o convert convert.cpp
+ *   ./convert [asset.pbm...] > ../include/logo.hpp
+ *
+ * A size and decoding cost report is printed on stderr and in the generated
+ * header.
+ */
+
 #include "gimp_logo.h"
 
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+struct bitmap {
+	std::string name;
+	unsigned int width;
+	unsigned int height;
+	// Row-major, true when the pixel is lit.
+	std::vector<bool> pixels;
+};
+
+struct packbits_stats {
+	unsigned int control_bytes = 0;
+	unsigned int literal_bytes = 0;
+	unsigned int run_count = 0;
+	unsigned int run_bytes = 0;
+};
+
+bitmap bitmap_from_gimp_header()
+{
+	bitmap logo{ "nsec_logo_data", width, height, {} };
+
+	for (const auto pixel : header_data) {
+		logo.pixels.push_back(pixel != 0);
+	}
+
+	return logo;
+}
+
+std::string symbol_from_path(const std::string& path)
+{
+	auto stem = path.substr(path.find_last_of('/') + 1);
+
+	stem = stem.substr(0, stem.find_last_of('.'));
+	for (auto& c : stem) {
+		if (!isalnum(static_cast<unsigned char>(c))) {
+			c = '_';
+		}
+	}
+
+	return stem + "_data";
+}
 
-int main(int argc [[maybe_unused]], const char **argv [[maybe_unused]])
+bool bitmap_from_pbm(const std::string& path, bitmap& out)
+{
+	std::ifstream file(path, std::ios::binary);
+	std::string magic;
+
+	if (!(file >> magic) || (magic != "P1" && magic != "P4")) {
+		std::cerr << path << ": not a PBM file" << std::endl;
+		return false;
+	}
+
+	const auto skip_comments = [&file]() {
+		while (file >> std::ws && file.peek() == '#') {
+			std::string comment;
+			std::getline(file, comment);
+		}
+	};
+
+	skip_comments();
+	file >> out.width;
+	skip_comments();
+	file >> out.height;
+	if (!file || out.width == 0 || out.width > 255 || out.height == 0 ||
+	    out.height > 255) {
+		std::cerr << path << ": invalid dimensions" << std::endl;
+		return false;
+	}
+
+	out.name = symbol_from_path(path);
+	out.pixels.clear();
+
+	if (magic == "P1") {
+		for (unsigned int i = 0; i < out.width * out.height; i++) {
+			char value;
+
+			if (!(file >> value)) {
+				std::cerr << path << ": truncated pixel data" << std::endl;
+				return false;
+			}
+
+			out.pixels.push_back(value == '1');
+		}
+	} else {
+		// Single whitespace, then packed rows padded to a byte boundary.
+		file.get();
+
+		const auto row_size = (out.width + 7) / 8;
+		std::vector<char> row(row_size);
+
+		for (unsigned int y = 0; y < out.height; y++) {
+			if (!file.read(row.data(), row_size)) {
+				std::cerr << path << ": truncated pixel data" << std::endl;
+				return false;
+			}
+
+			for (unsigned int x = 0; x < out.width; x++) {
+				out.pixels.push_back((row[x / 8] >> (7 - (x % 8))) & 1);
+			}
+		}
+	}
+
+	return true;
+}
+
+std::vector<uint8_t> to_page_layout(const bitmap& image)
+{
+	const auto page_count = (image.height + 7) / 8;
+	std::vector<uint8_t> pages(image.width * page_count, 0);
+
+	for (unsigned int y = 0; y < image.height; y++) {
+		for (unsigned int x = 0; x < image.width; x++) {
+			if (image.pixels[y * image.width + x]) {
+				pages[(y / 8) * image.width + x] |= 1 << (y % 8);
+			}
+		}
+	}
+
+	return pages;
+}
+
+/*
+ * PackBits: a control byte n in [0, 127] is followed by n + 1 literal bytes, a
+ * control byte n in [-127, -1] is followed by one byte to repeat 1 - n times.
+ * -128 is never emitted.
+ */
+std::vector<uint8_t> packbits(const std::vector<uint8_t>& input, packbits_stats& stats)
+{
+	constexpr size_t max_chunk = 128;
+	// Shorter runs are cheaper to emit as part of a literal chunk.
+	constexpr size_t min_run = 3;
+
+	std::vector<uint8_t> output;
+	size_t i = 0;
+
+	const auto run_length_at = [&input](size_t pos) {
+		size_t length = 1;
+
+		while (pos + length < input.size() && length < max_chunk &&
+		       input[pos + length] == input[pos]) {
+			length++;
+		}
+
+		return length;
+	};
+
+	while (i < input.size()) {
+		const auto run_length = run_length_at(i);
+
+		if (run_length >= min_run) {
+			output.push_back(uint8_t(int8_t(1 - int(run_length))));
+			output.push_back(input[i]);
+			stats.control_bytes++;
+			stats.run_count++;
+			stats.run_bytes += run_length;
+			i += run_length;
+			continue;
+		}
+
+		const auto literal_start = i;
+		while (i < input.size() && i - literal_start < max_chunk &&
+		       run_length_at(i) < min_run) {
+			i++;
+		}
+
+		const auto literal_length = i - literal_start;
+		output.push_back(uint8_t(literal_length - 1));
+		output.insert(output.end(),
+			      input.begin() + literal_start,
+			      input.begin() + literal_start + literal_length);
+		stats.control_bytes++;
+		stats.literal_bytes += literal_length;
+	}
+
+	return output;
+}
+
+std::string report(const bitmap& image,
+		   std::size_t raw_size,
+		   std::size_t packed_size,
+		   const packbits_stats& stats)
+{
+	std::ostringstream out;
+
+	// Stored size includes the two-byte (width, page count) header.
+	out << image.name << ": " << image.width << "x" << image.height << ", " << raw_size
+	    << " bytes raw, " << packed_size + 2 << " bytes packed ("
+	    << (100 * (packed_size + 2)) / raw_size << "%)\n";
+	out << "decode: " << stats.control_bytes + stats.literal_bytes + stats.run_count
+	    << " flash reads (" << stats.control_bytes << " control, " << stats.literal_bytes
+	    << " literal, " << stats.run_count << " run values),\n";
+	out << "        " << raw_size << " byte stores (" << stats.run_bytes << " from runs)\n";
+	out << "drawBitmap() equivalent: " << raw_size << " flash reads, "
+	    << image.width * image.height << " writePixel() calls";
+	return out.str();
+}
+
+void emit_header_prologue()
 {
 	std::cout << "/*" << std::endl;
 	// Split the SPDX identifier to avoid confusing the reuse tool
@@ -17,27 +240,65 @@ int main(int argc [[maybe_unused]], const char **argv [[maybe_unused]])
 	std::cout << " *" << std::endl;
 	std::cout << " * Copyright 2023 Jérémie Galarneau <jeremie.galarneau@gmail.com>"
 		  << std::endl;
-	std::cout << " * " << std::endl;
+	std::cout << " *" << std::endl;
 	std::cout << " * This header was auto-generated; see the logo folder." << std::endl;
 	std::cout << " */" << std::endl << std::endl;
 
 	std::cout << "#include <Arduino.h>" << std::endl;
+}
 
-	std::cout << std::endl << "const uint8_t PROGMEM nsec_logo_data[] = { " << std::endl;
+void emit_asset(const bitmap& image)
+{
+	const auto pages = to_page_layout(image);
+	packbits_stats stats;
+	const auto packed = packbits(pages, stats);
+	const auto asset_report = report(image, pages.size(), packed.size(), stats);
 
-	unsigned int bit = 0;
-	for (const auto pixel : header_data) {
-		if (bit == 0) {
-			std::cout << "0b";
-		}
+	std::cerr << asset_report << std::endl;
+
+	std::cout << std::endl << "/*" << std::endl;
+	std::istringstream report_lines(asset_report);
+	for (std::string line; std::getline(report_lines, line);) {
+		std::cout << " * " << line << std::endl;
+	}
+	std::cout << " */" << std::endl;
+
+	std::cout << "const uint8_t PROGMEM " << image.name << "[] = {" << std::endl;
+	std::cout << "\t// Width, page count." << std::endl;
+	std::cout << "\t" << image.width << ", " << (image.height + 7) / 8 << "," << std::endl;
 
-		std::cout << (pixel ? "1" : "0");
-		if (bit++ == 7) {
-			std::cout << ", ";
-			bit = 0;
+	constexpr unsigned int bytes_per_line = 12;
+	for (std::size_t i = 0; i < packed.size(); i++) {
+		std::cout << (i % bytes_per_line == 0 ? "\t" : " ") << "0x" << std::hex
+			  << std::setw(2) << std::setfill('0') << unsigned(packed[i]) << std::dec
+			  << ",";
+		if (i % bytes_per_line == bytes_per_line - 1 || i == packed.size() - 1) {
+			std::cout << std::endl;
 		}
 	}
 
 	std::cout << "};" << std::endl;
+}
+} // anonymous namespace
+
+int main(int argc, const char **argv)
+{
+	std::vector<bitmap> assets = { bitmap_from_gimp_header() };
+
+	for (int i = 1; i < argc; i++) {
+		bitmap asset;
+
+		if (!bitmap_from_pbm(argv[i], asset)) {
+			return 1;
+		}
+
+		assets.push_back(asset);
+	}
+
+	emit_header_prologue();
+	for (const auto& asset : assets) {
+		emit_asset(asset);
+	}
+
 	return 0;
 }
@@ -190,6 +190,19 @@ uint8_t nr::badge::level() const noexcept
 	return _social_level;
 }
 
+/*
+ * Since the chips were all sources from the same supplier in one batch,
+ * their IDs are fairly close together. This makes the use of the last 4
+ * bytes as a "unique" ID acceptable in our context.
+ */
+uint32_t nr::badge::id() const noexcept
+{
+	const auto *id = _UniqueID.id;
+
+	return (uint32_t(id[6]) << 24) | (uint32_t(id[7]) << 16) | (uint32_t(id[8]) << 8) |
+		id[9];
+}
+
 bool nr::badge::is_connected() const noexcept
 {
 	return _network_app_state() != network_app_state::UNCONNECTED;
@@ -199,6 +212,11 @@ void nr::badge::on_button_event(nsec::button::id button, nsec::button::event eve
 {
 	const auto button_mask_position = static_cast<unsigned int>(button);
 
+	// The press that wakes the display up is not acted upon since the user couldn't see it.
+	if (_renderer.wake()) {
+		return;
+	}
+
 	if (_network_app_state() != network_app_state::UNCONNECTED &&
 	    _network_app_state() != network_app_state::IDLE) {
 		// Don't allow button press during "modal" states.
@@ -272,6 +290,7 @@ void nr::badge::relase_focus_current_screen() noexcept
 
 void nr::badge::on_disconnection() noexcept
 {
+	_strip_animator.set_chain_position(0, 1);
 	_network_app_state(network_app_state::UNCONNECTED);
 	// Clear the debug LED
 	digitalWrite(LED_DBG, LOW);
@@ -283,6 +302,7 @@ void nr::badge::on_pairing_begin() noexcept
 
 void nr::badge::on_pairing_end(nc::peer_id_t our_peer_id, uint8_t peer_count) noexcept
 {
+	_strip_animator.set_chain_position(our_peer_id, peer_count);
 	_network_app_state(network_app_state::ANIMATE_PAIRING);
 }
 
@@ -291,7 +311,7 @@ nr::badge::on_message_received(communication::message::type message_type,
 			       const uint8_t *message) noexcept
 {
 	if (_network_app_state() == network_app_state::EXCHANGING_IDS) {
-		_id_exchanger.new_message(*this, message_type, message);
+		return _id_exchanger.new_message(_network_handler, message_type, message);
 	} else if (_network_app_state() == network_app_state::ANIMATE_PAIRING) {
 		_pairing_animator.new_message(*this, message_type, message);
 	}
@@ -299,11 +319,19 @@ nr::badge::on_message_received(communication::message::type message_type,
 	return nc::network_handler::application_message_action::OK;
 }
 
-void nr::badge::on_app_message_sent() noexcept
+void nr::badge::on_network_quiet_window() noexcept
 {
-	if (_network_app_state() == network_app_state::EXCHANGING_IDS) {
-		_id_exchanger.message_sent(*this);
-	}
+	_strip_animator.flush_deferred_frame();
+}
+
+void nr::badge::on_network_time_offset_changed(uint32_t network_time_offset_ms) noexcept
+{
+	_strip_animator.set_network_time_offset(network_time_offset_ms);
+}
+
+bool nr::badge::is_network_line_quiet() noexcept
+{
+	return _network_handler.is_line_quiet();
 }
 
 void nr::badge::on_splash_complete() noexcept
@@ -342,12 +370,12 @@ void nr::badge::_network_app_state(nr::badge::network_app_state new_state) noexc
 		_scroll_screen.set_property(F("Pairing"));
 		set_focused_screen(_scroll_screen);
 
-		// Reduce the CPU time of the renderer to reduce network errors.
-		_renderer.period_ms(16);
+		// Yield CPU time to the network handler to reduce network errors.
+		_renderer.network_activity(true);
 		if (new_state == network_app_state::ANIMATE_PAIRING) {
 			_pairing_animator.start(*this);
 		} else {
-			_id_exchanger.start(*this);
+			_id_exchanger.start(_network_handler);
 		}
 
 		break;
@@ -358,22 +386,14 @@ void nr::badge::_network_app_state(nr::badge::network_app_state new_state) noexc
 	case network_app_state::UNCONNECTED:
 		_set_user_name_scroll_screen();
 		_strip_animator.set_idle_animation(_social_level);
-		_renderer.period_ms(nsec::config::display::refresh_period_ms);
+		_renderer.network_activity(false);
 		break;
 	}
 }
 
-nr::badge::badge_discovered_result nr::badge::on_badge_discovered(const uint8_t *id) noexcept
+nr::badge::badge_discovered_result nr::badge::on_badge_discovered(uint32_t id) noexcept
 {
-	/*
-	 * Since the chips were all sources from the same supplier in one batch,
-	 * their IDs are fairly close together. This makes the use of the last 4
-	 * bytes as a "unique" ID acceptable in our context.
-	 */
-	const uint32_t id_low = (uint32_t(id[6]) << 24) | (uint32_t(id[7]) << 16) |
-		(uint32_t(id[8]) << 8) | id[9];
-
-	const auto inserted = _id_buffer.insert(id_low);
+	const auto inserted = _id_buffer.insert(id);
 	return inserted ? badge_discovered_result::NEW : badge_discovered_result::ALREADY_KNOWN;
 }
 
@@ -383,122 +403,6 @@ void nr::badge::on_badge_discovery_completed() noexcept
 	_network_app_state(network_app_state::ANIMATE_PAIRING_COMPLETED);
 }
 
-void nr::badge::network_id_exchanger::start(nr::badge& badge) noexcept
-{
-	const auto our_id = badge._network_handler.peer_id();
-
-	if (our_id != 0) {
-		// Wait for messages from left neighbors.
-		return;
-	}
-
-	// Left-most peer initiates the exchange.
-	nc::message::announce_badge_id msg = { .peer_id = our_id };
-	memcpy(msg.board_unique_id, _UniqueID.id, UniqueIDsize);
-
-	badge._network_handler.enqueue_app_message(nc::peer_relative_position::RIGHT,
-						   uint8_t(nc::message::type::ANNOUNCE_BADGE_ID),
-						   reinterpret_cast<const uint8_t *>(&msg));
-}
-
-void nr::badge::network_id_exchanger::new_message(nr::badge& badge,
-						  nc::message::type msg_type,
-						  const uint8_t *payload) noexcept
-{
-	if (msg_type != nc::message::type::ANNOUNCE_BADGE_ID) {
-		return;
-	}
-
-	const auto *announce_badge_id =
-		reinterpret_cast<const nc::message::announce_badge_id *>(payload);
-
-	if (badge.on_badge_discovered(announce_badge_id->board_unique_id) ==
-	    badge_discovered_result::NEW) {
-		_new_badges_discovered++;
-	}
-
-	_message_received_count++;
-
-	const auto our_position = badge._network_handler.position();
-	const auto our_peer_id = badge._network_handler.peer_id();
-	const auto msg_origin_peer_id = announce_badge_id->peer_id;
-	const auto peer_count = badge._network_handler.peer_count();
-
-	switch (our_position) {
-	case nc::network_handler::link_position::LEFT_MOST:
-		if (_message_received_count == peer_count - 1) {
-			// Done!
-			badge.on_badge_discovery_completed();
-		}
-
-		break;
-	case nc::network_handler::link_position::RIGHT_MOST:
-		if (_message_received_count == peer_count - 1) {
-			nc::message::announce_badge_id msg = {
-				.peer_id = badge._network_handler.peer_id()
-			};
-			memcpy(msg.board_unique_id, _UniqueID.id, UniqueIDsize);
-
-			badge._network_handler.enqueue_app_message(
-				nc::peer_relative_position(_direction),
-				uint8_t(nc::message::type::ANNOUNCE_BADGE_ID),
-				reinterpret_cast<const uint8_t *>(&msg));
-
-			badge.on_badge_discovery_completed();
-		}
-
-		break;
-	case nc::network_handler::link_position::MIDDLE:
-	{
-		if (abs(our_peer_id - msg_origin_peer_id) == 1) {
-			_send_ours_on_next_send_complete = true;
-			_done_after_sending_ours = msg_origin_peer_id > our_peer_id;
-			_direction = msg_origin_peer_id < our_peer_id ?
-				uint8_t(nc::peer_relative_position::RIGHT) :
-				uint8_t(nc::peer_relative_position::LEFT);
-		}
-
-		// Forward messages from other badges.
-		badge._network_handler.enqueue_app_message(
-			msg_origin_peer_id < our_peer_id ? nc::peer_relative_position::RIGHT :
-							   nc::peer_relative_position::LEFT,
-			uint8_t(msg_type),
-			payload);
-	}
-	default:
-		// Unreachable.
-		return;
-	}
-}
-
-void nr::badge::network_id_exchanger::message_sent(nr::badge& badge) noexcept
-{
-	if (!_send_ours_on_next_send_complete) {
-		return;
-	}
-
-	nc::message::announce_badge_id msg = { .peer_id = badge._network_handler.peer_id() };
-	memcpy(msg.board_unique_id, _UniqueID.id, UniqueIDsize);
-
-	badge._network_handler.enqueue_app_message(nc::peer_relative_position(_direction),
-						   uint8_t(nc::message::type::ANNOUNCE_BADGE_ID),
-						   reinterpret_cast<const uint8_t *>(&msg));
-
-	_send_ours_on_next_send_complete = false;
-
-	if (_done_after_sending_ours) {
-		badge.on_badge_discovery_completed();
-	}
-}
-
-void nr::badge::network_id_exchanger::reset() noexcept
-{
-	_new_badges_discovered = 0;
-	_message_received_count = 0;
-	_send_ours_on_next_send_complete = false;
-	_done_after_sending_ours = false;
-}
-
 nr::badge::pairing_animator::pairing_animator()
 {
 	_animation_state(animation_state::DONE);
@@ -637,6 +541,9 @@ void nr::badge::tick(nsec::scheduling::absolute_time_ms current_time_ms) noexcep
 	case network_app_state::ANIMATE_PAIRING:
 		_pairing_animator.tick(current_time_ms);
 		break;
+	case network_app_state::EXCHANGING_IDS:
+		_id_exchanger.tick(_network_handler);
+		break;
 	case network_app_state::ANIMATE_PAIRING_COMPLETED:
 		_pairing_completed_animator.tick(*this, current_time_ms);
 		break;
@@ -50,8 +50,33 @@ static_assert(button_down_repeat_delay_ms % polling_period_ms == 0);
 namespace nsec::config::display {
 constexpr nsec::scheduling::relative_time_ms refresh_period_ms = 16;
 
+/*
+ * Bounds of the renderer's refresh period by kind of content shown by the
+ * focused screen. Static screens are refreshed at their upper bound since they
+ * are only redrawn when damaged; the period then only bounds input latency.
+ */
+constexpr nsec::scheduling::relative_time_ms static_content_min_refresh_period_ms = 16;
+constexpr nsec::scheduling::relative_time_ms static_content_max_refresh_period_ms = 50;
+constexpr nsec::scheduling::relative_time_ms scrolling_content_min_refresh_period_ms = 16;
+constexpr nsec::scheduling::relative_time_ms scrolling_content_max_refresh_period_ms = 40;
+
+// Lower bounds applied while network traffic is expected and while the display is dimmed or off.
+constexpr nsec::scheduling::relative_time_ms network_activity_min_refresh_period_ms = 32;
+constexpr nsec::scheduling::relative_time_ms low_power_min_refresh_period_ms = 40;
+
+// The renderer aims to use at most 1/N of the CPU time.
+constexpr uint8_t render_time_budget_divisor = 4;
+constexpr uint8_t network_activity_render_time_budget_divisor = 8;
+
+// Refresh period changes smaller than 1/N of the current period are ignored.
+constexpr uint8_t refresh_period_hysteresis_divisor = 8;
+
+// The display is dimmed, then turned off, when no button or network event occurs.
+constexpr nsec::scheduling::absolute_time_ms dim_after_inactivity_ms = 60000;
+constexpr nsec::scheduling::absolute_time_ms off_after_inactivity_ms = 600000;
+static_assert(off_after_inactivity_ms > dim_after_inactivity_ms);
+
 constexpr uint8_t menu_font_size = 1;
-constexpr uint8_t scroll_font_size = 3;
 constexpr uint8_t pairing_font_size = 3;
 
 // Default font.
@@ -66,7 +91,25 @@ constexpr uint8_t scroll_pixels_per_second = 80;
 namespace nsec::config::communication {
 // Size reserved for protocol messages
 constexpr size_t protocol_max_message_size = 16;
+// Speed of the links during discovery, and after a timeout at a faster one.
 constexpr unsigned int software_serial_speed = 38400;
+/*
+ * Link speeds (bauds), slowest first: after discovery, each pair of peers
+ * switches to the fastest both support. Each bit takes an interrupt on both
+ * ends; faster speeds leave too few cycles between them at 8 MHz.
+ */
+constexpr uint32_t serial_speeds[] = { software_serial_speed, 57600 };
+constexpr uint8_t serial_speed_count = sizeof(serial_speeds) / sizeof(serial_speeds[0]);
+// Bytes buffered by the receiver of each side, must be a power of two.
+constexpr uint8_t serial_receive_buffer_size = 32;
+static_assert((serial_receive_buffer_size & (serial_receive_buffer_size - 1)) == 0);
+/*
+ * Bytes queued for transmission on each side, must be a power of two. A batch of
+ * messages in flight fits in the peer's receive buffer, and so in this one too:
+ * queueing it never waits for the line.
+ */
+constexpr uint8_t serial_transmit_buffer_size = serial_receive_buffer_size;
+static_assert((serial_transmit_buffer_size & (serial_transmit_buffer_size - 1)) == 0);
 /*
 * Applications may define messages >= application_message_type_range_begin.
 * IDs under this range are reserved by the wire protocol.
@@ -85,9 +128,90 @@ constexpr nsec::scheduling::relative_time_ms network_handler_base_period_ms = 60
 constexpr nsec::scheduling::relative_time_ms network_handler_timeout_ms = 10000;
 constexpr nsec::scheduling::relative_time_ms network_handler_retransmit_timeout_ms =
 	6 * network_handler_base_period_ms;
+/*
+ * Messages sent on a link before waiting for their acknowledgement. They are
+ * numbered on 3 bits, which allows up to 7 in flight. Their bytes must also fit
+ * in the peer's receive buffer.
+ */
+constexpr uint8_t transmit_window_size = 4;
+static_assert(transmit_window_size < 8);
+/*
+ * Ticks a node holds the MONITOR message before passing it on, when it has no
+ * application message to send. This keeps the lines mostly quiet once paired
+ * (see network_handler::is_line_quiet()).
+ */
+constexpr uint8_t network_handler_idle_monitor_hold_ticks = 2;
+/*
+ * Bytes of the application's messages queued for transmission, in both
+ * directions. Each message takes a byte more than its payload. A badge
+ * forwarding fragments of the badges' IDs gets up to a window of them at once
+ * and may add its own.
+ */
+constexpr uint8_t application_message_queue_size = 48;
+/*
+ * Badge IDs carried by a fragment of the ID vector exchanged while pairing. At
+ * two, a fragment is sent in 15 bytes and two are in flight at once.
+ */
+constexpr uint8_t badge_id_vector_fragment_size = 2;
+/*
+ * Time after we acknowledge a message during which the peer is known not to
+ * transmit: it only sees our OK on its next tick and sends on a later one.
+ */
+constexpr nsec::scheduling::relative_time_ms network_handler_quiet_window_after_ok_ms =
+	network_handler_base_period_ms;
+
+/*
+ * Peers share a network time, peer 0's clock, to synchronize their animations.
+ * MONITOR messages carry the sender's network time. They are read on the
+ * receiver's next tick, on average half a period after their transmission. The
+ * transmission time depends on the link's speed, the network handler adds it.
+ */
+constexpr nsec::scheduling::relative_time_ms network_time_latency_ms =
+	network_handler_base_period_ms / 2;
+// Larger differences with the peer's network time are applied at once, smaller ones averaged.
+constexpr nsec::scheduling::relative_time_ms network_time_step_threshold_ms = 250;
+// Weight of each new measurement in the average, 1 / 2^shift.
+constexpr uint8_t network_time_smoothing_shift = 3;
 
 } // namespace nsec::communication
 
+namespace nsec::config::led {
+// Decoded keyframes kept in RAM by the strip animator, must be a power of two.
+constexpr uint8_t keyframe_cache_size = 8;
+static_assert((keyframe_cache_size & (keyframe_cache_size - 1)) == 0);
+/*
+ * Sending a frame to the LEDs masks interrupts, which corrupts bytes being
+ * received on the pairing links. Frames are held until the links are quiet,
+ * for at most max_output_deferral_ms.
+ */
+constexpr bool defer_output_to_quiet_line = true;
+constexpr nsec::scheduling::relative_time_ms max_output_deferral_ms = 200;
+/*
+ * Output pixels with 4 extra bits of precision by carrying each LED's rounding
+ * error over to the next frames. This smooths dim fades, where few 8-bit levels
+ * are left after gamma correction.
+ */
+constexpr bool temporal_dithering = true;
+// Instructions an LED program may run per tick, it resumes on the next tick when exhausted.
+constexpr uint8_t program_instruction_budget = 16;
+/*
+ * Power limiter (see led/power.hpp). A pixel component draws up to
+ * component_current_ma at full value and each LED idle_current_ma. The strip
+ * draws from the unregulated cells, which the MCU can't measure (its supply is
+ * regulated): the budget holds for their whole discharge.
+ */
+constexpr uint8_t component_current_ma = 20;
+constexpr uint8_t idle_current_ma = 1;
+constexpr uint16_t power_budget_ma = 300;
+// Scale, in 1/256th, regained per frame once frames fit in the budget again.
+constexpr uint8_t power_limit_release_step = 2;
+/*
+ * The scale only recovers up to a budget tighter by 1/(2^shift): frames hovering
+ * around the budget would have it cut and released on every frame otherwise.
+ */
+constexpr uint8_t power_limit_recovery_margin_shift = 3;
+} // namespace nsec::config::led
+
 namespace nsec::config::badge {
 constexpr unsigned int pairing_animation_time_per_led_progress_bar_ms = 1000;
 } // namespace nsec::badge
@@ -0,0 +1,134 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2023 Jérémie Galarneau <jeremie.galarneau@gmail.com>
+ */
+
+#include <Arduino.h>
+#include <display/font.hpp>
+#include <font_data.hpp>
+
+namespace nf = nsec::display::font;
+
+namespace {
+inline char to_char(const char *src)
+{
+	return *src;
+}
+
+inline char to_char(const __FlashStringHelper *src)
+{
+	return pgm_read_byte(reinterpret_cast<PGM_P>(src));
+}
+
+nf::descriptor descriptor_from_flash(const nf::descriptor& font) noexcept
+{
+	nf::descriptor local_copy;
+
+	memcpy_P(&local_copy, &font, sizeof(local_copy));
+	return local_copy;
+}
+
+// Characters that are not covered by the font are drawn as '?'.
+uint8_t glyph_index(const nf::descriptor& font, char character) noexcept
+{
+	if (character < font.first_character || character > font.last_character) {
+		character = '?';
+	}
+
+	return character - font.first_character;
+}
+
+uint16_t glyph_column(const nf::descriptor& font, uint8_t index) noexcept
+{
+	return pgm_read_word(&font.glyph_offsets[index]);
+}
+
+uint8_t glyph_width(const nf::descriptor& font, uint8_t index) noexcept
+{
+	return glyph_column(font, index + 1) - glyph_column(font, index);
+}
+
+template <typename StringType>
+uint16_t _string_width(const nf::descriptor& flash_font, const StringType *str) noexcept
+{
+	const auto font = descriptor_from_flash(flash_font);
+	auto current_ptr = reinterpret_cast<const char *>(str);
+	uint16_t width = 0;
+
+	for (char current_char;
+	     (current_char = to_char(reinterpret_cast<const StringType *>(current_ptr))) != '\0';
+	     current_ptr++) {
+		width += glyph_width(font, glyph_index(font, current_char)) + font.spacing;
+	}
+
+	return width;
+}
+} // anonymous namespace
+
+uint8_t nf::page_count(const nf::descriptor& font) noexcept
+{
+	return pgm_read_byte(&font.page_count);
+}
+
+uint8_t nf::character_width(const nf::descriptor& flash_font, char character) noexcept
+{
+	const auto font = descriptor_from_flash(flash_font);
+
+	return glyph_width(font, glyph_index(font, character)) + font.spacing;
+}
+
+uint16_t nf::string_width(const nf::descriptor& font, const char *str) noexcept
+{
+	return _string_width(font, str);
+}
+
+uint16_t nf::string_width(const nf::descriptor& font, const __FlashStringHelper *str) noexcept
+{
+	return _string_width(font, str);
+}
+
+int16_t nf::draw_character(Adafruit_SSD1306& canvas,
+			   const nf::descriptor& flash_font,
+			   char character,
+			   int16_t x,
+			   uint8_t page,
+			   uint8_t color,
+			   int16_t clip_x) noexcept
+{
+	const auto font = descriptor_from_flash(flash_font);
+	const auto index = glyph_index(font, character);
+	const auto width = glyph_width(font, index);
+	const int16_t next_x = x + width + font.spacing;
+	const int16_t canvas_width = canvas.width();
+	const int16_t first_drawn_x = max(x, int16_t(0));
+	const int16_t end_x = min(next_x, min(clip_x, canvas_width));
+
+	if (first_drawn_x >= end_x) {
+		return next_x;
+	}
+
+	// Unlit pixels (and spacing) are drawn in the background color.
+	const uint8_t invert_mask = color == SSD1306_WHITE ? 0x00 : 0xff;
+	const uint8_t last_page = min(page + font.page_count, (canvas.height() + 7) / 8);
+	const uint8_t first_column = first_drawn_x - x;
+	const uint8_t drawn_glyph_columns =
+		first_column < width ? min(width, uint8_t(end_x - x)) - first_column : 0;
+	const uint8_t drawn_spacing_columns = (end_x - first_drawn_x) - drawn_glyph_columns;
+
+	const uint8_t *source = font.atlas + glyph_column(font, index) + first_column;
+	uint8_t *destination = canvas.getBuffer() + (page * canvas_width) + first_drawn_x;
+
+	for (uint8_t current_page = page; current_page < last_page; current_page++) {
+		for (uint8_t i = 0; i < drawn_glyph_columns; i++) {
+			destination[i] = pgm_read_byte(source + i) ^ invert_mask;
+		}
+
+		memset(destination + drawn_glyph_columns, invert_mask, drawn_spacing_columns);
+
+		source += font.atlas_width;
+		destination += canvas_width;
+	}
+
+	return next_x;
+}
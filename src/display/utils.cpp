@@ -8,6 +8,7 @@
 #include <display/utils.hpp>
 
 namespace ndu = nsec::display::utils;
+namespace nf = nsec::display::font;
 
 namespace {
 inline char to_char(const char *src)
@@ -20,62 +21,64 @@ inline char to_char(const __FlashStringHelper *src)
 	return pgm_read_byte(reinterpret_cast<PGM_P>(src));
 }
 
-// Assumes the cursor position is already set.
-// Hand-rolled since the canvas Print interface does not allow us to bound the printed length of
-// a string stored in program memory.
 template <typename StringType>
 void _draw_string(Adafruit_SSD1306& canvas,
+		  const nf::descriptor& font,
 		  const StringType *str,
-		  uint8_t max_char_count,
+		  uint8_t max_width,
+		  uint8_t color,
 		  bool draw_ellipsis_if_too_long) noexcept
 {
-	auto current_ptr = reinterpret_cast<const char *>(str);
-	auto limit_ptr = reinterpret_cast<const char *>(str) + max_char_count;
-
-	// First pass to determine if an ellipsis is needed
-	bool draw_elipsis = draw_ellipsis_if_too_long;
-	if (draw_ellipsis_if_too_long) {
-		while (current_ptr != limit_ptr) {
-			if (to_char(reinterpret_cast<const StringType *>(current_ptr)) == '\0') {
-				draw_elipsis = false;
-				break;
-			}
-
-			current_ptr++;
-		}
-	}
+	const uint8_t page = canvas.getCursorY() / 8;
+	const int16_t clip_x = canvas.getCursorX() + max_width;
+	const bool draw_ellipsis =
+		draw_ellipsis_if_too_long && nf::string_width(font, str) > max_width;
+	// Characters must fit before the ellipsis; otherwise they are clipped.
+	const int16_t text_clip_x =
+		draw_ellipsis ? clip_x - (3 * nf::character_width(font, '.')) : clip_x;
 
-	current_ptr = reinterpret_cast<const char *>(str);
-	while (current_ptr != limit_ptr) {
-		auto current_char = to_char(reinterpret_cast<const StringType *>(current_ptr));
+	auto current_ptr = reinterpret_cast<const char *>(str);
+	int16_t x = canvas.getCursorX();
 
-		if (current_char == '\0') {
-			return;
-		}
+	while (x < text_clip_x) {
+		const auto current_char = to_char(reinterpret_cast<const StringType *>(current_ptr));
 
-		if ((limit_ptr - current_ptr) <= 3 && draw_elipsis) {
-			current_char = '.';
+		if (current_char == '\0' ||
+		    (draw_ellipsis && x + nf::character_width(font, current_char) > text_clip_x)) {
+			break;
 		}
 
-		canvas.write(current_char);
+		x = nf::draw_character(canvas, font, current_char, x, page, color, text_clip_x);
 		current_ptr++;
 	}
+
+	if (draw_ellipsis) {
+		for (uint8_t i = 0; i < 3; i++) {
+			x = nf::draw_character(canvas, font, '.', x, page, color, clip_x);
+		}
+	}
+
+	canvas.setCursor(min(x, clip_x), canvas.getCursorY());
 }
 } // anonymous namespace
 
 void ndu::draw_string(Adafruit_SSD1306& canvas,
+		      const nf::descriptor& font,
 		      const char *str,
-		      uint8_t max_char_count,
+		      uint8_t max_width,
+		      uint8_t color,
 		      bool draw_ellipsis_if_too_long) noexcept
 {
-	_draw_string(canvas, str, max_char_count, draw_ellipsis_if_too_long);
+	_draw_string(canvas, font, str, max_width, color, draw_ellipsis_if_too_long);
 }
 void ndu::draw_string(Adafruit_SSD1306& canvas,
+		      const nf::descriptor& font,
 		      const __FlashStringHelper *str,
-		      uint8_t max_char_count,
+		      uint8_t max_width,
+		      uint8_t color,
 		      bool draw_ellipsis_if_too_long) noexcept
 {
-	_draw_string(canvas, str, max_char_count, draw_ellipsis_if_too_long);
+	_draw_string(canvas, font, str, max_width, color, draw_ellipsis_if_too_long);
 }
 
 void ndu::draw_arrow_glyph(Adafruit_SSD1306& canvas,
@@ -145,4 +148,46 @@ void ndu::draw_arrow_glyph(Adafruit_SSD1306& canvas,
 		current_segment_length += 2;
 		segment_being_drawn += line_draw_direction;
 	}
-}
\ No newline at end of file
+}
+
+void ndu::draw_packed_bitmap(Adafruit_SSD1306& canvas,
+			     uint8_t x,
+			     uint8_t page,
+			     const uint8_t *packed_bitmap) noexcept
+{
+	const uint8_t bitmap_width = pgm_read_byte(packed_bitmap++);
+	const uint8_t bitmap_page_count = pgm_read_byte(packed_bitmap++);
+	const uint8_t canvas_width = canvas.width();
+	// Bytes to skip to reach the bitmap's first column on the next page.
+	const uint8_t page_stride_skip = canvas_width - bitmap_width;
+
+	uint8_t *destination = canvas.getBuffer() + (page * canvas_width) + x;
+	uint16_t bytes_left = bitmap_width * bitmap_page_count;
+	uint8_t column = 0;
+
+	while (bytes_left) {
+		const auto control = int8_t(pgm_read_byte(packed_bitmap++));
+
+		if (control == -128) {
+			// No-op, never emitted by the asset compiler.
+			continue;
+		}
+
+		const bool is_run = control < 0;
+		uint8_t count = is_run ? uint8_t(1 - control) : uint8_t(control + 1);
+		uint8_t value = is_run ? pgm_read_byte(packed_bitmap++) : 0;
+
+		bytes_left -= count;
+		while (count--) {
+			if (!is_run) {
+				value = pgm_read_byte(packed_bitmap++);
+			}
+
+			*destination++ = value;
+			if (++column == bitmap_width) {
+				column = 0;
+				destination += page_stride_skip;
+			}
+		}
+	}
+}
@@ -0,0 +1,234 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2023 Jérémie Galarneau <jeremie.galarneau@gmail.com>
+ */
+
+#include "network/dual_soft_uart.hpp"
+
+#include <Arduino.h>
+#include <avr/interrupt.h>
+
+namespace ndsu = nsec::communication::dual_soft_uart;
+
+/*
+ * The interrupt sources are tied to the pins: INT0 is PD2 (Arduino pin 2) and
+ * PCINT22 is PD6 (Arduino pin 6). The transmitters' handlers write to PD3 and
+ * PD5 (Arduino pins 3 and 5).
+ */
+static_assert(nsec::config::communication::serial_rx_pin_left == 2);
+static_assert(nsec::config::communication::serial_rx_pin_right == 6);
+static_assert(nsec::config::communication::serial_tx_pin_left == 3);
+static_assert(nsec::config::communication::serial_tx_pin_right == 5);
+
+namespace {
+/*
+ * Timer1 ticks (CPU cycles) from a start bit's edge to the read of TCNT1 in
+ * its interrupt handler: interrupt response and the handler's prologue.
+ */
+constexpr uint8_t edge_latency_ticks = 32;
+// Timer3 ticks from the start of a transmission to its first edge.
+constexpr uint8_t transmission_lead_ticks = 32;
+
+ndsu::receiver left_receiver;
+ndsu::receiver right_receiver;
+ndsu::transmitter left_transmitter;
+ndsu::transmitter right_transmitter;
+
+// The line idles low: a space (logical 0) is a high level.
+bool left_level() noexcept
+{
+	return !(PIND & _BV(PIND2));
+}
+
+bool right_level() noexcept
+{
+	return !(PIND & _BV(PIND6));
+}
+} // anonymous namespace
+
+void ndsu::begin() noexcept
+{
+	pinMode(nsec::config::communication::serial_rx_pin_left, INPUT);
+	pinMode(nsec::config::communication::serial_rx_pin_right, INPUT);
+
+	const uint8_t sreg = SREG;
+	cli();
+
+	// Both free-running at the CPU clock.
+	TCCR1A = 0;
+	TCCR1B = _BV(CS10);
+	TIMSK1 = 0;
+	TCCR3A = 0;
+	TCCR3B = _BV(CS30);
+	TIMSK3 = 0;
+
+	// Left: rising edges of INT0.
+	EICRA = (EICRA & ~(_BV(ISC01) | _BV(ISC00))) | _BV(ISC01) | _BV(ISC00);
+	EIFR = _BV(INTF0);
+	EIMSK |= _BV(INT0);
+
+	// Right: any change of PCINT22, the handler keeps the rising edges.
+	PCMSK2 = _BV(PCINT22);
+	PCIFR = _BV(PCIF2);
+	PCICR |= _BV(PCIE2);
+
+	SREG = sreg;
+}
+
+ndsu::port::port(side port_side) noexcept :
+	_receiver(port_side == side::LEFT ? left_receiver : right_receiver),
+	_transmitter(port_side == side::LEFT ? left_transmitter : right_transmitter),
+	_side(port_side)
+{
+}
+
+void ndsu::port::begin() noexcept
+{
+	const auto tx_pin = _side == side::LEFT ? nsec::config::communication::serial_tx_pin_left :
+						  nsec::config::communication::serial_tx_pin_right;
+
+	// Idle.
+	digitalWrite(tx_pin, LOW);
+	pinMode(tx_pin, OUTPUT);
+}
+
+void ndsu::port::speed(uint32_t speed) noexcept
+{
+	const uint16_t bit_ticks = (F_CPU + speed / 2) / speed;
+
+	// Changing the timing of a frame on the line would garble it.
+	while (_transmitter.is_transmitting()) {
+	}
+
+	const uint8_t sreg = SREG;
+	cli();
+	_receiver.bit_ticks(bit_ticks);
+	_transmitter.bit_ticks(bit_ticks);
+	SREG = sreg;
+}
+
+void ndsu::port::read(uint8_t *data, uint8_t size) noexcept
+{
+	for (uint8_t i = 0; i < size; i++) {
+		data[i] = _receiver.read();
+	}
+}
+
+void ndsu::port::write(uint8_t value) noexcept
+{
+	while (!_transmitter.push(value)) {
+		// Full, wait for the interrupt handler to send a byte.
+	}
+
+	const uint8_t sreg = SREG;
+	cli();
+
+	if (_transmitter.start(TCNT3 + transmission_lead_ticks)) {
+		if (_side == side::LEFT) {
+			OCR3A = _transmitter.next_edge_tick();
+			TIFR3 = _BV(OCF3A);
+			TIMSK3 |= _BV(OCIE3A);
+		} else {
+			OCR3B = _transmitter.next_edge_tick();
+			TIFR3 = _BV(OCF3B);
+			TIMSK3 |= _BV(OCIE3B);
+		}
+	}
+
+	SREG = sreg;
+}
+
+void ndsu::port::write(const uint8_t *data, uint8_t size) noexcept
+{
+	for (uint8_t i = 0; i < size; i++) {
+		write(data[i]);
+	}
+}
+
+ISR(INT0_vect)
+{
+	const uint16_t edge_tick = TCNT1 - edge_latency_ticks;
+
+	EIMSK &= ~_BV(INT0);
+	OCR1A = left_receiver.start(edge_tick);
+	TIFR1 = _BV(OCF1A);
+	TIMSK1 |= _BV(OCIE1A);
+}
+
+ISR(TIMER1_COMPA_vect)
+{
+	if (left_receiver.sample(left_level())) {
+		OCR1A = left_receiver.next_sample_tick();
+		return;
+	}
+
+	// Wait for the next start bit, ignoring the edges of this frame.
+	TIMSK1 &= ~_BV(OCIE1A);
+	EIFR = _BV(INTF0);
+	EIMSK |= _BV(INT0);
+}
+
+ISR(PCINT2_vect)
+{
+	const uint16_t edge_tick = TCNT1 - edge_latency_ticks;
+
+	if (right_level()) {
+		// Trailing edge of a frame or glitch.
+		return;
+	}
+
+	PCMSK2 &= ~_BV(PCINT22);
+	OCR1B = right_receiver.start(edge_tick);
+	TIFR1 = _BV(OCF1B);
+	TIMSK1 |= _BV(OCIE1B);
+}
+
+ISR(TIMER1_COMPB_vect)
+{
+	if (right_receiver.sample(right_level())) {
+		OCR1B = right_receiver.next_sample_tick();
+		return;
+	}
+
+	TIMSK1 &= ~_BV(OCIE1B);
+	PCIFR = _BV(PCIF2);
+	PCMSK2 |= _BV(PCINT22);
+}
+
+ISR(TIMER3_COMPA_vect)
+{
+	bool level;
+
+	if (!left_transmitter.edge(level)) {
+		TIMSK3 &= ~_BV(OCIE3A);
+		return;
+	}
+
+	// A mark is a low level.
+	if (level) {
+		PORTD &= ~_BV(PORTD3);
+	} else {
+		PORTD |= _BV(PORTD3);
+	}
+
+	OCR3A = left_transmitter.next_edge_tick();
+}
+
+ISR(TIMER3_COMPB_vect)
+{
+	bool level;
+
+	if (!right_transmitter.edge(level)) {
+		TIMSK3 &= ~_BV(OCIE3B);
+		return;
+	}
+
+	if (level) {
+		PORTD &= ~_BV(PORTD5);
+	} else {
+		PORTD |= _BV(PORTD5);
+	}
+
+	OCR3B = right_transmitter.next_edge_tick();
+}
@@ -0,0 +1,171 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2023 Jérémie Galarneau <jeremie.galarneau@gmail.com>
+ */
+
+#include "network/id_exchanger.hpp"
+#include "config.hpp"
+#include "globals.hpp"
+
+namespace nc = nsec::communication;
+namespace nr = nsec::runtime;
+namespace ng = nsec::g;
+
+void nc::id_exchanger::start(nc::network_handler& handler) noexcept
+{
+	if (handler.peer_id() != 0) {
+		// Wait for the vector from left neighbors.
+		return;
+	}
+
+	// Left-most peer initiates the exchange, nothing is pending yet.
+	_send_ours(handler, peer_relative_position::RIGHT);
+}
+
+/*
+ * The vector of IDs travels from left to right, each badge filling in its own
+ * as it forwards the fragments. The right-most badge sends the fragments back
+ * to the left, completed: each badge learns the IDs of its left neighbors on the
+ * way right and those of its right neighbors on the way back.
+ */
+nc::network_handler::application_message_action nc::id_exchanger::new_message(
+	nc::network_handler& handler, nc::message::type msg_type, const uint8_t *payload) noexcept
+{
+	if (msg_type != message::type::COLLECT_BADGE_IDS &&
+	    msg_type != message::type::BROADCAST_BADGE_IDS) {
+		return network_handler::application_message_action::OK;
+	}
+
+	auto fragment = *reinterpret_cast<const message::badge_id_vector *>(payload);
+	const bool is_collecting = msg_type == message::type::COLLECT_BADGE_IDS;
+	const auto our_position = handler.position();
+	const auto our_peer_id = handler.peer_id();
+	const auto peer_count = handler.peer_count();
+	bool is_sent = true;
+
+	for (uint8_t i = 0; i < nsec::config::communication::badge_id_vector_fragment_size; i++) {
+		const uint8_t peer_id = fragment.first_peer_id + i;
+
+		if (peer_id == our_peer_id) {
+			if (is_collecting) {
+				fragment.ids[i] = ng::the_badge.id();
+			}
+
+			continue;
+		}
+
+		// Past the last peer, or not filled in yet, or already known.
+		if (peer_id >= peer_count || (peer_id > our_peer_id) == is_collecting) {
+			continue;
+		}
+
+		if (ng::the_badge.on_badge_discovered(fragment.ids[i]) ==
+		    nr::badge::badge_discovered_result::NEW) {
+			_new_badges_discovered++;
+		}
+
+		_badge_id_received_count++;
+	}
+
+	if (is_collecting) {
+		// The right-most badge turns the vector around.
+		const auto direction = our_position == network_handler::link_position::RIGHT_MOST ?
+			peer_relative_position::LEFT :
+			peer_relative_position::RIGHT;
+
+		is_sent = _send(handler, direction, fragment);
+
+		// The fragment ends with our left neighbor's ID, ours starts the next one.
+		if (fragment.first_peer_id +
+			    nsec::config::communication::badge_id_vector_fragment_size ==
+		    our_peer_id) {
+			is_sent = is_sent && _send_ours(handler, direction);
+		}
+	} else if (our_position != network_handler::link_position::LEFT_MOST) {
+		is_sent = _send(handler, peer_relative_position::LEFT, fragment);
+	}
+
+	if (!is_sent) {
+		// Our neighbors would never complete the exchange, pair again.
+		return network_handler::application_message_action::ERROR;
+	}
+
+	_check_completion(handler);
+	return network_handler::application_message_action::OK;
+}
+
+void nc::id_exchanger::tick(nc::network_handler& handler) noexcept
+{
+	if (!_has_pending_fragment) {
+		return;
+	}
+
+	_send_pending_fragment(handler);
+	_check_completion(handler);
+}
+
+bool nc::id_exchanger::_send_ours(nc::network_handler& handler,
+				  nc::peer_relative_position direction) noexcept
+{
+	message::badge_id_vector fragment = { .first_peer_id = handler.peer_id(), .ids = {} };
+
+	fragment.ids[0] = ng::the_badge.id();
+	return _send(handler, direction, fragment);
+}
+
+/*
+ * Queue a fragment for the network handler. A fragment it has no room for is
+ * kept and sent on a later tick; false is returned if one is already pending.
+ */
+bool nc::id_exchanger::_send(nc::network_handler& handler,
+			     nc::peer_relative_position direction,
+			     const nc::message::badge_id_vector& fragment) noexcept
+{
+	const auto msg_type = direction == peer_relative_position::RIGHT ?
+		message::type::COLLECT_BADGE_IDS :
+		message::type::BROADCAST_BADGE_IDS;
+
+	_send_pending_fragment(handler);
+	if (_has_pending_fragment) {
+		return false;
+	}
+
+	if (handler.enqueue_app_message(direction,
+					uint8_t(msg_type),
+					reinterpret_cast<const uint8_t *>(&fragment)) ==
+	    network_handler::enqueue_message_result::FULL) {
+		_pending_fragment = fragment;
+		_pending_fragment_direction = uint8_t(direction);
+		_has_pending_fragment = true;
+	}
+
+	return true;
+}
+
+void nc::id_exchanger::_send_pending_fragment(nc::network_handler& handler) noexcept
+{
+	if (!_has_pending_fragment) {
+		return;
+	}
+
+	const auto direction = peer_relative_position(_pending_fragment_direction);
+
+	_has_pending_fragment = false;
+	_send(handler, direction, _pending_fragment);
+}
+
+void nc::id_exchanger::_check_completion(const nc::network_handler& handler) noexcept
+{
+	// Done once we know every other badge and forwarded all we received.
+	if (_badge_id_received_count == handler.peer_count() - 1 && !_has_pending_fragment) {
+		ng::the_badge.on_badge_discovery_completed();
+	}
+}
+
+void nc::id_exchanger::reset() noexcept
+{
+	_new_badges_discovered = 0;
+	_badge_id_received_count = 0;
+	_has_pending_fragment = false;
+}
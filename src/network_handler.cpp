@@ -23,6 +23,8 @@ enum class wire_msg_type : uint8_t {
 	ANNOUNCE = 5,
 	ANNOUNCE_REPLY = 6,
 	OK = 7,
+	// OK carrying the fastest link speed the sender accepts, since version 1.
+	OK_WITH_SPEED = 8,
 
 	// Application messages (forwarded to the application layer)
 	// ...
@@ -31,22 +33,38 @@ enum class wire_msg_type : uint8_t {
 
 namespace {
 
+/*
+ * Version of the frames' format, carried by the second magic byte. Peers
+ * running another version never sync on our frames: they don't pair with us,
+ * rather than counting each of our frames as corrupted. Version 1 added the
+ * network time to MONITOR, OK_WITH_SPEED, and the sequence numbers.
+ */
+constexpr uint8_t wire_protocol_version = 1;
 constexpr uint8_t wire_protocol_magic_1 = 0b10101111;
-constexpr uint8_t wire_protocol_magic_2 = 0b11111010;
+constexpr uint8_t wire_protocol_magic_2 = 0b11111010 ^ wire_protocol_version;
 
 struct wire_msg_header {
 	// Message start with a 16-bit magic number to re-sync on message frames.
 	uint8_t type;
 
+	/*
+	 * Sequence number of the message on its link, modulo 8. Acknowledgements
+	 * (OK messages) carry the sequence number of the next message expected:
+	 * they cover all the messages before it. RESET messages aren't numbered.
+	 */
+	uint8_t sequence;
+
 	/*
 	 * 16-bit fletcher checksum, see
 	 * https://en.wikipedia.org/wiki/Fletcher%27s_checksum#Fletcher-16
 	 *
-	 * Checksum includes: type and payload bytes
+	 * Checksum includes: type, sequence and payload bytes
 	 */
 	uint16_t checksum;
 } __attribute__((packed));
 
+constexpr uint8_t wire_sequence_mask = 0b111;
+
 struct wire_msg_announce {
 	uint8_t peer_id;
 } __attribute__((packed));
@@ -55,6 +73,22 @@ struct wire_msg_announce_reply {
 	uint8_t peer_count;
 } __attribute__((packed));
 
+// Speed indices are stored on 2 bits.
+static_assert(nsec::config::communication::serial_speed_count <= 4);
+// Counted in _ticks_in_wire_state, on 2 bits.
+static_assert(nsec::config::communication::network_handler_idle_monitor_hold_ticks < 4);
+
+struct wire_msg_ok_with_speed {
+	// Index in serial_speeds.
+	uint8_t speed_index;
+} __attribute__((packed));
+
+// Carries a payload since version 1 of the format.
+struct wire_msg_monitor {
+	// Sender's network time when the message was (re)transmitted.
+	uint32_t network_time_ms;
+} __attribute__((packed));
+
 uint8_t wire_msg_payload_size(uint8_t type)
 {
 	switch (wire_msg_type(type)) {
@@ -63,13 +97,17 @@ uint8_t wire_msg_payload_size(uint8_t type)
 	case wire_msg_type::ANNOUNCE_REPLY:
 		return sizeof(wire_msg_announce_reply);
 	case wire_msg_type::MONITOR:
+		return sizeof(wire_msg_monitor);
+	case wire_msg_type::OK_WITH_SPEED:
+		return sizeof(wire_msg_ok_with_speed);
 	case wire_msg_type::RESET:
 	case wire_msg_type::OK:
 		return 0;
 	default:
 		switch (nc::message::type(type)) {
-		case nc::message::type::ANNOUNCE_BADGE_ID:
-			return sizeof(nc::message::announce_badge_id);
+		case nc::message::type::COLLECT_BADGE_IDS:
+		case nc::message::type::BROADCAST_BADGE_IDS:
+			return sizeof(nc::message::badge_id_vector);
 		default:
 			break;
 		}
@@ -78,6 +116,18 @@ uint8_t wire_msg_payload_size(uint8_t type)
 	}
 }
 
+// Bytes of a message on the line.
+uint8_t wire_msg_size(uint8_t type)
+{
+	return 2 + sizeof(wire_msg_header) + wire_msg_payload_size(type);
+}
+
+bool is_wire_msg_acknowledgement(uint8_t type)
+{
+	return wire_msg_type(type) == wire_msg_type::OK ||
+		wire_msg_type(type) == wire_msg_type::OK_WITH_SPEED;
+}
+
 class fletcher16_checksumer {
 public:
 	void push(uint8_t value)
@@ -96,58 +146,86 @@ private:
 	uint8_t _sum_high = 0;
 };
 
-void send_wire_magic(SoftwareSerial& serial) noexcept
+void send_wire_magic(nc::dual_soft_uart::port& serial) noexcept
 {
 	serial.write(wire_protocol_magic_1);
 	serial.write(wire_protocol_magic_2);
 }
 
-void send_wire_header(SoftwareSerial& serial, uint8_t msg_type, uint16_t checksum) noexcept
+void send_wire_header(nc::dual_soft_uart::port& serial,
+		      uint8_t msg_type,
+		      uint8_t sequence,
+		      uint16_t checksum) noexcept
 {
-	const wire_msg_header header = { .type = msg_type, .checksum = checksum };
+	const wire_msg_header header = { .type = msg_type,
+					 .sequence = sequence,
+					 .checksum = checksum };
 
 	send_wire_magic(serial);
 	serial.write(reinterpret_cast<const uint8_t *>(&header), sizeof(header));
 }
 
-void send_wire_msg(SoftwareSerial& serial,
+void send_wire_msg(nc::dual_soft_uart::port& serial,
 		   uint8_t msg_type,
+		   uint8_t sequence,
 		   const uint8_t *msg = nullptr,
 		   uint8_t msg_payload_size = 0) noexcept
 {
 	fletcher16_checksumer checksummer;
 
 	checksummer.push(msg_type);
+	checksummer.push(sequence);
 	for (uint8_t i = 0; i < msg_payload_size; i++) {
 		checksummer.push(msg[i]);
 	}
 
-	send_wire_header(serial, msg_type, checksummer.checksum());
+	send_wire_header(serial, msg_type, sequence, checksummer.checksum());
 	serial.write(msg, msg_payload_size);
 }
 
-void send_wire_reset_msg(SoftwareSerial& serial) noexcept
+void send_wire_reset_msg(nc::dual_soft_uart::port& serial) noexcept
 {
-	send_wire_msg(serial, uint8_t(wire_msg_type::RESET));
+	send_wire_msg(serial, uint8_t(wire_msg_type::RESET), 0);
 }
 
-void send_wire_ok_msg(SoftwareSerial& serial) noexcept
+void send_wire_ok_msg(nc::dual_soft_uart::port& serial, uint8_t expected_sequence) noexcept
 {
-	send_wire_msg(serial, uint8_t(wire_msg_type::OK));
+	send_wire_msg(serial, uint8_t(wire_msg_type::OK), expected_sequence);
+}
+
+void send_wire_ok_with_speed_msg(nc::dual_soft_uart::port& serial,
+				 uint8_t expected_sequence,
+				 uint8_t speed_index) noexcept
+{
+	const wire_msg_ok_with_speed ok_msg = { .speed_index = speed_index };
+
+	send_wire_msg(serial,
+		      uint8_t(wire_msg_type::OK_WITH_SPEED),
+		      expected_sequence,
+		      reinterpret_cast<const uint8_t *>(&ok_msg),
+		      sizeof(ok_msg));
 }
 } /* namespace */
 
 nc::network_handler::network_handler() noexcept :
 	ns::periodic_task(nsec::config::communication::network_handler_base_period_ms),
-	_left_serial(nsec::config::communication::serial_rx_pin_left,
-		     nsec::config::communication::serial_tx_pin_left,
-		     true),
-	_right_serial(nsec::config::communication::serial_rx_pin_right,
-		      nsec::config::communication::serial_tx_pin_right,
-		      true),
+	_left_serial(dual_soft_uart::side::LEFT),
+	_right_serial(dual_soft_uart::side::RIGHT),
+	_last_ok_sent_time_ms{ 0 },
+	_network_time_offset_ms{ 0 },
+	_corrupted_message_count{ 0 },
+	_retransmission_count{ 0 },
 	_is_left_connected{ false },
 	_is_right_connected{ false },
-	_current_wire_protocol_state{ uint8_t(wire_protocol_state::UNCONNECTED) }
+	_is_network_time_synchronized{ false },
+	_is_left_link_speed_limited{ false },
+	_is_right_link_speed_limited{ false },
+	_left_link_speed_index{ 0 },
+	_right_link_speed_index{ 0 },
+	_right_peer_max_speed_index{ 0 },
+	_current_wire_protocol_state{ uint8_t(wire_protocol_state::UNCONNECTED) },
+	_outgoing_message_count{ 0 },
+	_sent_outgoing_message_count{ 0 }
 {
 	_reset();
 	ng::the_scheduler.schedule_task(*this);
@@ -156,14 +234,17 @@ nc::network_handler::network_handler() noexcept :
 void nc::network_handler::setup() noexcept
 {
 	// Init software serial for both sides of the badge.
+	dual_soft_uart::begin();
+	_left_serial.begin();
+	_right_serial.begin();
+	_link_speed(peer_relative_position::LEFT, 0);
+	_link_speed(peer_relative_position::RIGHT, 0);
+
 	pinMode(nsec::config::communication::connection_sense_pin_right, INPUT_PULLUP);
 	pinMode(nsec::config::communication::connection_sense_pin_left, OUTPUT);
 	digitalWrite(nsec::config::communication::connection_sense_pin_left, LOW);
 
 	pinMode(nsec::config::communication::serial_rx_pin_left, INPUT_PULLUP);
-
-	_left_serial.begin(nsec::config::communication::software_serial_speed);
-	_right_serial.begin(nsec::config::communication::software_serial_speed);
 }
 
 bool nc::network_handler::_sense_is_left_connected() const noexcept
@@ -214,7 +295,16 @@ nc::network_handler::check_connections_result nc::network_handler::_check_connec
 	if (!topology_changed) {
 		return check_connections_result::NO_CHANGE;
 	} else {
-		SoftwareSerial *destination_serial;
+		// A new peer gets to negotiate the link's speed again.
+		if (left_state_changed) {
+			_is_left_link_speed_limited = false;
+		}
+
+		if (right_state_changed) {
+			_is_right_link_speed_limited = false;
+		}
+
+		dual_soft_uart::port *destination_serial;
 		switch (position()) {
 		case link_position::LEFT_MOST:
 			destination_serial = &_right_serial;
@@ -271,15 +361,16 @@ nc::peer_relative_position nc::network_handler::_listening_side() const noexcept
 
 void nc::network_handler::_listening_side(peer_relative_position side) noexcept
 {
-	_current_listening_side = uint8_t(side);
-	switch (_listening_side()) {
-	case peer_relative_position::LEFT:
-		_left_serial.listen();
-		break;
-	case peer_relative_position::RIGHT:
-		_right_serial.listen();
-		break;
+	if (side == _listening_side()) {
+		return;
 	}
+
+	/*
+	 * Both sides keep receiving, only the messages' parsing switches sides.
+	 * Bytes received from the other side so far are kept for when we get to them.
+	 */
+	_current_listening_side = uint8_t(side);
+	_message_reception_state(message_reception_state::RECEIVE_MAGIC_BYTE_1);
 }
 
 void nc::network_handler::_reverse_listening_side() noexcept
@@ -316,25 +407,45 @@ void nc::network_handler::_wire_protocol_state(wire_protocol_state state) noexce
 	// Reset timeout timestamp.
 	_last_message_received_time_ms = millis();
 
+	if (state == wire_protocol_state::UNCONNECTED) {
+		// Back on our own clock, before the badge restarts its animations.
+		_is_network_time_synchronized = false;
+		_network_time_offset(0);
+	}
+
 	if (_is_wire_protocol_in_a_running_state(previous_protocol_state) &&
 	    state == wire_protocol_state::UNCONNECTED) {
 		nsec::g::the_badge.on_disconnection();
 	}
 
 	if (state == wire_protocol_state::UNCONNECTED) {
-		_current_pending_outgoing_app_message_size = 0;
 		// We are a sad and lonely node hacking together a network protocol.
 		_peer_count = 1;
 		// Unknown peer id.
 		_peer_id = 0;
 		_wave_front_direction(peer_relative_position::RIGHT);
 		_message_reception_state(message_reception_state::RECEIVE_MAGIC_BYTE_1);
-		_clear_outgoing_message();
-		_clear_pending_outgoing_app_message();
+		_clear_outgoing_messages();
+		_clear_app_messages();
+
+		// Both ends of a link start over.
+		_left_next_sequence = 0;
+		_right_next_sequence = 0;
+		_left_expected_sequence = 0;
+		_right_expected_sequence = 0;
+
+		_right_serial.flush();
+		_left_serial.flush();
+
+		// Discovery always starts at the base speed.
+		_right_peer_max_speed_index = 0;
+		if (_left_link_speed_index) {
+			_link_speed(peer_relative_position::LEFT, 0);
+		}
 
-		/* Empty the serial buffers by switching listening side. */
-		_right_serial.listen();
-		_left_serial.listen();
+		if (_right_link_speed_index) {
+			_link_speed(peer_relative_position::RIGHT, 0);
+		}
 	}
 
 	if (!_is_wire_protocol_in_a_running_state(previous_protocol_state) &&
@@ -354,103 +465,361 @@ void nc::network_handler::_wave_front_direction(peer_relative_position new_direc
 	_current_wave_front_direction = uint8_t(new_direction);
 }
 
-nc::network_handler::message_reception_state
-nc::network_handler::_message_reception_state() const noexcept
+void nc::network_handler::_network_time_offset(uint32_t offset_ms) noexcept
 {
-	return message_reception_state(_current_message_reception_state);
+	if (offset_ms == _network_time_offset_ms) {
+		return;
+	}
+
+	_network_time_offset_ms = offset_ms;
+	nsec::g::the_badge.on_network_time_offset_changed(offset_ms);
 }
 
-void nc::network_handler::_message_reception_state(message_reception_state new_state) noexcept
+void nc::network_handler::_synchronize_network_time(uint32_t peer_network_time_ms,
+						    ns::absolute_time_ms current_time_ms) noexcept
 {
-	_current_message_reception_state = uint8_t(new_state);
+	// 10 bits per byte, at the speed of the link to our left peer.
+	const uint32_t monitor_bits = wire_msg_size(uint8_t(wire_msg_type::MONITOR)) * 10;
+	const uint16_t transmission_time_ms = monitor_bits * 1000 /
+		nsec::config::communication::serial_speeds[_left_link_speed_index];
+	const uint32_t measured_offset_ms = peer_network_time_ms +
+		nsec::config::communication::network_time_latency_ms + transmission_time_ms -
+		current_time_ms;
+	const int32_t error_ms = measured_offset_ms - _network_time_offset_ms;
+
+	if (!_is_network_time_synchronized ||
+	    error_ms > int32_t(nsec::config::communication::network_time_step_threshold_ms) ||
+	    error_ms < -int32_t(nsec::config::communication::network_time_step_threshold_ms)) {
+		// First measurement, or our left peer's network time jumped.
+		_is_network_time_synchronized = true;
+		_network_time_offset(measured_offset_ms);
+		return;
+	}
+
+	/*
+	 * The reception delay depends on the phase of our ticks relative to the
+	 * peer's: average it out rather than shifting the animations on every message.
+	 */
+	const int32_t correction_ms =
+		error_ms / (1 << nsec::config::communication::network_time_smoothing_shift);
+
+	_network_time_offset(_network_time_offset_ms + correction_ms);
 }
 
-nc::network_handler::message_transmission_state
-nc::network_handler::_message_transmission_state() const noexcept
+nc::dual_soft_uart::port& nc::network_handler::_serial(peer_relative_position side) noexcept
 {
-	return message_transmission_state(_current_message_transmission_state);
+	return side == peer_relative_position::LEFT ? _left_serial : _right_serial;
 }
 
-void nc::network_handler::_message_transmission_state(message_transmission_state new_state) noexcept
+uint8_t nc::network_handler::_max_link_speed_index(peer_relative_position side) const noexcept
 {
-	_current_message_transmission_state = uint8_t(new_state);
+	const bool is_limited = side == peer_relative_position::LEFT ? _is_left_link_speed_limited :
+								       _is_right_link_speed_limited;
+
+	return is_limited ? 0 : nsec::config::communication::serial_speed_count - 1;
 }
 
-nc::peer_relative_position nc::network_handler::_outgoing_message_direction() const noexcept
+void nc::network_handler::_link_speed(peer_relative_position side, uint8_t speed_index) noexcept
 {
-	return peer_relative_position(_current_message_being_sent_direction);
+	if (side == peer_relative_position::LEFT) {
+		_left_link_speed_index = speed_index;
+	} else {
+		_right_link_speed_index = speed_index;
+	}
+
+	_serial(side).speed(nsec::config::communication::serial_speeds[speed_index]);
 }
 
-void nc::network_handler::_outgoing_message_direction(peer_relative_position direction) noexcept
+/*
+ * Links negotiate their speed during discovery, in the acknowledgements of the
+ * ANNOUNCE (left to right) and ANNOUNCE_REPLY (right to left) messages and
+ * the MONITOR message sent with them. Returns true if the link switched speed.
+ */
+bool nc::network_handler::_acknowledge(ns::absolute_time_ms current_time_ms,
+				       uint8_t negotiated_message_type) noexcept
+{
+	auto& serial = _listening_side_serial();
+	const auto expected_sequence = _expected_sequence(_listening_side());
+	bool switched_speed = false;
+
+	switch (wire_msg_type(negotiated_message_type)) {
+	case wire_msg_type::ANNOUNCE:
+		// Our left peer agrees on the speed after hearing from the rest of the chain.
+		send_wire_ok_with_speed_msg(
+			serial, expected_sequence, _max_link_speed_index(_listening_side()));
+		break;
+	case wire_msg_type::ANNOUNCE_REPLY:
+		if (_right_peer_max_speed_index) {
+			const uint8_t max_speed_index = _max_link_speed_index(_listening_side());
+			const auto speed_index = min(_right_peer_max_speed_index, max_speed_index);
+
+			// Our peer switches speed when it gets our reply, its next message uses it.
+			send_wire_ok_with_speed_msg(serial, expected_sequence, speed_index);
+			_link_speed(_listening_side(), speed_index);
+			switched_speed = speed_index != 0;
+			break;
+		}
+
+		send_wire_ok_msg(serial, expected_sequence);
+		break;
+	default:
+		send_wire_ok_msg(serial, expected_sequence);
+		break;
+	}
+
+	_last_ok_sent_time_ms = current_time_ms;
+	// The peer is silent until it processes our OK.
+	nsec::g::the_badge.on_network_quiet_window();
+	return switched_speed;
+}
+
+void nc::network_handler::_on_link_speed_offer(uint8_t speed_index) noexcept
+{
+	const auto side = _outgoing_message_direction();
+	const auto accepted_speed_index = min(speed_index, _max_link_speed_index(side));
+
+	switch (_wire_protocol_state()) {
+	case wire_protocol_state::DISCOVERY_CONFIRM_MONITOR_AFTER_ANNOUNCE:
+		// Agreed on when the peer sends its ANNOUNCE_REPLY.
+		_right_peer_max_speed_index = accepted_speed_index;
+		break;
+	case wire_protocol_state::DISCOVERY_CONFIRM_MONITOR_AFTER_ANNOUNCE_REPLY:
+		_link_speed(side, accepted_speed_index);
+		break;
+	default:
+		break;
+	}
+}
+
+uint8_t nc::network_handler::_next_sequence(peer_relative_position side) const noexcept
+{
+	return side == peer_relative_position::LEFT ? _left_next_sequence : _right_next_sequence;
+}
+
+void nc::network_handler::_next_sequence(peer_relative_position side, uint8_t sequence) noexcept
+{
+	if (side == peer_relative_position::LEFT) {
+		_left_next_sequence = sequence & wire_sequence_mask;
+	} else {
+		_right_next_sequence = sequence & wire_sequence_mask;
+	}
+}
+
+uint8_t nc::network_handler::_expected_sequence(peer_relative_position side) const noexcept
+{
+	return side == peer_relative_position::LEFT ? _left_expected_sequence :
+						      _right_expected_sequence;
+}
+
+void nc::network_handler::_expected_sequence(peer_relative_position side, uint8_t sequence) noexcept
+{
+	if (side == peer_relative_position::LEFT) {
+		_left_expected_sequence = sequence & wire_sequence_mask;
+	} else {
+		_right_expected_sequence = sequence & wire_sequence_mask;
+	}
+}
+
+nc::network_handler::message_reception_state
+nc::network_handler::_message_reception_state() const noexcept
 {
-	_current_message_being_sent_direction = uint8_t(direction);
+	return message_reception_state(_current_message_reception_state);
 }
 
-uint8_t nc::network_handler::_outgoing_message_size() const noexcept
+void nc::network_handler::_message_reception_state(message_reception_state new_state) noexcept
 {
-	return _current_message_being_sent_size;
+	_current_message_reception_state = uint8_t(new_state);
 }
 
-void nc::network_handler::_clear_outgoing_message() noexcept
+nc::peer_relative_position nc::network_handler::_outgoing_message_direction() const noexcept
 {
-	_current_message_being_sent_size = 0;
-	_message_transmission_state(message_transmission_state::NONE);
+	return peer_relative_position(_current_outgoing_message_direction);
 }
 
-void nc::network_handler::_set_outgoing_message(nsec::scheduling::absolute_time_ms current_time_ms,
-						uint8_t message_type,
-						const uint8_t *message_payload) noexcept
+void nc::network_handler::_outgoing_message_direction(peer_relative_position direction) noexcept
+{
+	_current_outgoing_message_direction = uint8_t(direction);
+}
+
+void nc::network_handler::_clear_outgoing_messages() noexcept
+{
+	_outgoing_message_count = 0;
+	_sent_outgoing_message_count = 0;
+}
+
+nc::peer_relative_position nc::network_handler::_sending_side() const noexcept
 {
-	_current_message_being_sent_size = wire_msg_payload_size(message_type);
-	memcpy(_current_message_being_sent, message_payload, _current_message_being_sent_size);
 	switch (position()) {
 	case link_position::LEFT_MOST:
-		_outgoing_message_direction(peer_relative_position::RIGHT);
-		break;
+		return peer_relative_position::RIGHT;
 	case link_position::RIGHT_MOST:
-		_outgoing_message_direction(peer_relative_position::LEFT);
-		break;
-	case link_position::MIDDLE:
-		_outgoing_message_direction(_wave_front_direction());
-		break;
+		return peer_relative_position::LEFT;
 	default:
+		return _wave_front_direction();
+	}
+}
+
+void nc::network_handler::_enqueue_outgoing_message(uint8_t message_type,
+						    const uint8_t *message_payload) noexcept
+{
+	if (position() == link_position::UNKNOWN) {
 		// Unreachable.
 		return;
 	}
 
-	_current_message_being_sent_type = message_type;
-	_message_transmission_state(message_transmission_state::ATTEMPT_SEND);
-	_last_transmission_time_ms = current_time_ms;
+	_outgoing_message_direction(_sending_side());
+	if (_outgoing_message_count == nsec::config::communication::transmit_window_size) {
+		// Unreachable: no state sends more messages at once.
+		return;
+	}
+
+	auto& message = _outgoing_messages[_outgoing_message_count++];
+
+	message.type = message_type;
+	if (message_payload) {
+		memcpy(message.payload, message_payload, wire_msg_payload_size(message_type));
+	}
+
+	_next_sequence(_outgoing_message_direction(),
+		       _next_sequence(_outgoing_message_direction()) + 1);
+}
+
+/*
+ * Send the messages of the window that weren't sent since the last timeout, as
+ * long as the bytes in flight fit in the peer's receive buffer: it only reads
+ * them on its next tick.
+ */
+void nc::network_handler::_send_outgoing_messages(ns::absolute_time_ms current_time_ms) noexcept
+{
+	const auto direction = _outgoing_message_direction();
+	auto& serial = _serial(direction);
+	const uint8_t first_sequence = _next_sequence(direction) - _outgoing_message_count;
+	uint8_t bytes_in_flight = 0;
+
+	for (uint8_t i = 0; i < _outgoing_message_count; i++) {
+		auto& message = _outgoing_messages[i];
+
+		bytes_in_flight += wire_msg_size(message.type);
+		if (i < _sent_outgoing_message_count) {
+			continue;
+		}
+
+		if (bytes_in_flight >= nsec::config::communication::serial_receive_buffer_size) {
+			// Sent once the peer acknowledges the messages before it.
+			break;
+		}
+
+		if (wire_msg_type(message.type) == wire_msg_type::MONITOR) {
+			// Stamped on every transmission, a retransmission is sent later.
+			const uint32_t network_time_ms = current_time_ms + _network_time_offset_ms;
+			const wire_msg_monitor monitor_msg = { .network_time_ms = network_time_ms };
+
+			memcpy(message.payload, &monitor_msg, sizeof(monitor_msg));
+		}
+
+		// Listen before send since the other side can reply OK immediately.
+		_listening_side(direction);
+		send_wire_msg(serial,
+			      message.type,
+			      (first_sequence + i) & wire_sequence_mask,
+			      message.payload,
+			      wire_msg_payload_size(message.type));
+		_sent_outgoing_message_count = i + 1;
+		_last_transmission_time_ms = current_time_ms;
+	}
 }
 
-nc::peer_relative_position
-nc::network_handler::_pending_outgoing_app_message_direction() const noexcept
+void nc::network_handler::_release_outgoing_messages(uint8_t count) noexcept
 {
-	return peer_relative_position(_current_pending_outgoing_app_message_direction);
+	_outgoing_message_count -= count;
+	_sent_outgoing_message_count -= count;
+	memmove(_outgoing_messages,
+		_outgoing_messages + count,
+		_outgoing_message_count * sizeof(_outgoing_messages[0]));
 }
 
-uint8_t nc::network_handler::_pending_outgoing_app_message_size() const noexcept
+void nc::network_handler::_on_acknowledgement(ns::absolute_time_ms current_time_ms,
+					      uint8_t message_type,
+					      uint8_t sequence,
+					      const uint8_t *message_payload) noexcept
 {
-	return _current_pending_outgoing_app_message_size;
+	const uint8_t first_sequence =
+		_next_sequence(_outgoing_message_direction()) - _outgoing_message_count;
+	const uint8_t acknowledged_count = (sequence - first_sequence) & wire_sequence_mask;
+
+	if (acknowledged_count == 0 || acknowledged_count > _sent_outgoing_message_count) {
+		// Repeated, or from before a timeout.
+		return;
+	}
+
+	_release_outgoing_messages(acknowledged_count);
+	// The peer is keeping up, give the remaining messages a full timeout.
+	_last_transmission_time_ms = current_time_ms;
+
+	if (_outgoing_message_count == 0 &&
+	    wire_msg_type(message_type) == wire_msg_type::OK_WITH_SPEED) {
+		const auto *ok_with_speed_msg =
+			reinterpret_cast<const wire_msg_ok_with_speed *>(message_payload);
+
+		_on_link_speed_offer(ok_with_speed_msg->speed_index);
+	}
 }
 
-bool nc::network_handler::_has_pending_outgoing_app_message() const noexcept
+/*
+ * Move the oldest message queued to a side to the outgoing window. Returns
+ * false when none is queued.
+ */
+bool nc::network_handler::_dequeue_app_message(peer_relative_position direction) noexcept
 {
-	return _current_pending_outgoing_app_message_type != 0;
+	constexpr auto queue_size = nsec::config::communication::application_message_queue_size;
+
+	if (direction == peer_relative_position::LEFT) {
+		if (_left_app_messages_size == 0) {
+			return false;
+		}
+
+		const auto message_type = _app_messages[0];
+		const uint8_t message_size = 1 + wire_msg_payload_size(message_type);
+
+		_enqueue_outgoing_message(message_type, _app_messages + 1);
+		_left_app_messages_size -= message_size;
+		memmove(_app_messages, _app_messages + message_size, _left_app_messages_size);
+	} else {
+		if (_right_app_messages_size == 0) {
+			return false;
+		}
+
+		// Stored backwards: the type follows the payload.
+		const auto message_type = _app_messages[queue_size - 1];
+		const uint8_t message_size = 1 + wire_msg_payload_size(message_type);
+		uint8_t *const right_messages =
+			_app_messages + queue_size - _right_app_messages_size;
+
+		_enqueue_outgoing_message(message_type, _app_messages + queue_size - message_size);
+		_right_app_messages_size -= message_size;
+		memmove(right_messages + message_size, right_messages, _right_app_messages_size);
+	}
+
+	return true;
 }
 
-void nc::network_handler::_clear_pending_outgoing_app_message() noexcept
+void nc::network_handler::_clear_app_messages() noexcept
 {
-	_current_pending_outgoing_app_message_type = 0;
+	_left_app_messages_size = 0;
+	_right_app_messages_size = 0;
 }
 
-SoftwareSerial& nc::network_handler::_listening_side_serial() noexcept
+nc::dual_soft_uart::port& nc::network_handler::_listening_side_serial() noexcept
 {
 	return _listening_side() == peer_relative_position::LEFT ? _left_serial : _right_serial;
 }
 
-nc::network_handler::handle_reception_result nc::network_handler::_handle_reception(
-	SoftwareSerial& serial, uint8_t& message_type, uint8_t *message_payload) noexcept
+nc::network_handler::handle_reception_result
+nc::network_handler::_handle_reception(nc::dual_soft_uart::port& serial,
+				       uint8_t& message_type,
+				       uint8_t& message_sequence,
+				       uint8_t *message_payload,
+				       bool acknowledgements_only) noexcept
 {
 	bool saw_data = false;
 
@@ -485,18 +854,23 @@ nc::network_handler::handle_reception_result nc::network_handler::_handle_recept
 				return handle_reception_result::INCOMPLETE;
 			}
 
-			const wire_msg_header header = { .type = uint8_t(serial.peek()) };
+			const uint8_t msg_type = serial.peek();
 
-			const auto msg_type = header.type;
+			if (acknowledgements_only && !is_wire_msg_acknowledgement(msg_type)) {
+				// Left for the reception states, the caller checks its sequence.
+				message_type = msg_type;
+				message_sequence = serial.peek(1);
+				return handle_reception_result::MESSAGE_PENDING;
+			}
 
 			const auto msg_payload_size = wire_msg_payload_size(msg_type);
 			_message_reception_state(message_reception_state::RECEIVE_PAYLOAD);
 			/*
-			 * Keep the payload and the header's type byte which will allow
-			 * us to dispatch the message, and the checksym, which will allow us
-			 * to validate the message.
+			 * Keep the payload and the header's type and sequence bytes which will
+			 * allow us to dispatch the message, and the checksum, which will allow
+			 * us to validate the message.
 			 */
-			_payload_bytes_to_receive = msg_payload_size + sizeof(header);
+			_payload_bytes_to_receive = msg_payload_size + sizeof(wire_msg_header);
 			break;
 		}
 		case message_reception_state::RECEIVE_PAYLOAD:
@@ -508,7 +882,8 @@ nc::network_handler::handle_reception_result nc::network_handler::_handle_recept
 			// Get ready to receive the beginning of the next message.
 			_message_reception_state(message_reception_state::RECEIVE_MAGIC_BYTE_1);
 
-			message_type = uint8_t(serial.read());
+			message_type = serial.read();
+			message_sequence = serial.read();
 			const uint16_t checksum = uint16_t(serial.read()) |
 				uint16_t(serial.read()) << 8;
 			const auto payload_size = wire_msg_payload_size(message_type);
@@ -519,12 +894,13 @@ nc::network_handler::handle_reception_result nc::network_handler::_handle_recept
 			}
 
 			if (payload_size != 0) {
-				serial.readBytes(message_payload, payload_size);
+				serial.read(message_payload, payload_size);
 			}
 
 			// Validate checksum.
 			fletcher16_checksumer checksummer;
 			checksummer.push(message_type);
+			checksummer.push(message_sequence);
 			for (uint8_t i = 0; i < payload_size; i++) {
 				checksummer.push(message_payload[i]);
 			}
@@ -539,77 +915,97 @@ nc::network_handler::handle_reception_result nc::network_handler::_handle_recept
 	return saw_data ? handle_reception_result::INCOMPLETE : handle_reception_result::NO_DATA;
 }
 
+/*
+ * Up to transmit_window_size messages are sent back to back and acknowledged
+ * together: the peer replies once per tick with the sequence number of the
+ * next message it expects. On a timeout, the messages not acknowledged are all
+ * sent again.
+ */
 nc::network_handler::handle_transmission_result nc::network_handler::_handle_transmission(
 	nsec::scheduling::absolute_time_ms current_time_ms) noexcept
 {
-	switch (_message_transmission_state()) {
-	case message_transmission_state::NONE:
-		return handle_transmission_result::COMPLETE;
-	case message_transmission_state::ATTEMPT_SEND:
-	{
-		auto& sending_serial = _outgoing_message_direction() ==
-				peer_relative_position::LEFT ?
-			_left_serial :
-			_right_serial;
+	auto& serial = _serial(_outgoing_message_direction());
+	uint8_t message_type, message_sequence;
+	uint8_t message_payload[nsec::config::communication::protocol_max_message_size -
+				sizeof(wire_msg_header)];
+	bool is_receiving = true;
 
-		// Listen before send since the other side can reply OK immediately.
-		_listening_side(_outgoing_message_direction());
-		send_wire_msg(sending_serial,
-			      _current_message_being_sent_type,
-			      _current_message_being_sent,
-			      _current_message_being_sent_size);
-		_last_transmission_time_ms = current_time_ms;
-		_message_transmission_state(message_transmission_state::WAIT_CONFIRMATION);
-		break;
-	}
-	case message_transmission_state::WAIT_CONFIRMATION:
-	{
-		uint8_t new_message_type;
-		auto& listening_serial = _outgoing_message_direction() ==
-				peer_relative_position::LEFT ?
-			_left_serial :
-			_right_serial;
+	while (is_receiving) {
+		switch (_handle_reception(
+			serial, message_type, message_sequence, message_payload, true)) {
+		case handle_reception_result::COMPLETE:
+			// Anything else is a repeated message, dropped below.
+			if (is_wire_msg_acknowledgement(message_type)) {
+				_on_acknowledgement(current_time_ms,
+						    message_type,
+						    message_sequence,
+						    message_payload);
+			}
 
-		const auto receive_result =
-			_handle_reception(listening_serial, new_message_type, nullptr);
+			break;
+		case handle_reception_result::CORRUPTED:
+			_corrupted_message_count++;
+			break;
+		case handle_reception_result::MESSAGE_PENDING:
+			if (wire_msg_type(message_type) == wire_msg_type::RESET) {
+				_reset();
+				return handle_transmission_result::INCOMPLETE;
+			}
 
-		switch (receive_result) {
-		case handle_reception_result::COMPLETE:
-		{
-			_clear_outgoing_message();
-			return handle_transmission_result::COMPLETE;
-		}
-		case handle_reception_result::NO_DATA:
-			if (current_time_ms - _last_transmission_time_ms >=
-			    nsec::config::communication::network_handler_retransmit_timeout_ms) {
+			if (message_sequence != _expected_sequence(_outgoing_message_direction())) {
+				/*
+				 * Repeated by the peer, which missed our acknowledgement: the
+				 * messages we are sending tell it to move on.
+				 */
+				if (_handle_reception(serial,
+						      message_type,
+						      message_sequence,
+						      message_payload) ==
+				    handle_reception_result::CORRUPTED) {
+					_corrupted_message_count++;
+				}
 
-				// Attempt a retransmission.
-				_message_transmission_state(
-					message_transmission_state::ATTEMPT_SEND);
+				break;
 			}
 
+			/*
+			 * The peer only sends once it got all our messages: its acknowledgement
+			 * was lost.
+			 */
+			_release_outgoing_messages(_sent_outgoing_message_count);
+			is_receiving = false;
 			break;
 		default:
-			// Assume the message was "OK".
-			_clear_outgoing_message();
-			return handle_transmission_result::COMPLETE;
+			is_receiving = false;
 			break;
 		}
+	}
 
-		break;
+	if (_outgoing_message_count == 0) {
+		return handle_transmission_result::COMPLETE;
 	}
+
+	if (_sent_outgoing_message_count != 0 &&
+	    current_time_ms - _last_transmission_time_ms >=
+		    nsec::config::communication::network_handler_retransmit_timeout_ms) {
+		// Attempt a retransmission.
+		_retransmission_count += _sent_outgoing_message_count;
+		_sent_outgoing_message_count = 0;
 	}
 
+	_send_outgoing_messages(current_time_ms);
 	return handle_transmission_result::INCOMPLETE;
 }
 
 nc::network_handler::enqueue_message_result nc::network_handler::enqueue_app_message(
 	peer_relative_position direction, uint8_t msg_type, const uint8_t *msg_payload)
 {
+	constexpr auto queue_size = nsec::config::communication::application_message_queue_size;
 	const auto payload_size = wire_msg_payload_size(msg_type);
+	const uint8_t message_size = 1 + payload_size;
 
-	if (_has_pending_outgoing_app_message() ||
-	    payload_size > sizeof(_current_pending_outgoing_app_message_payload)) {
+	if (payload_size > sizeof(_outgoing_messages[0].payload) ||
+	    _left_app_messages_size + _right_app_messages_size + message_size > queue_size) {
 		return enqueue_message_result::FULL;
 	}
 
@@ -622,13 +1018,56 @@ nc::network_handler::enqueue_message_result nc::network_handler::enqueue_app_mes
 		return enqueue_message_result::UNCONNECTED;
 	}
 
-	_current_pending_outgoing_app_message_direction = uint8_t(direction);
-	_current_pending_outgoing_app_message_size = payload_size;
-	_current_pending_outgoing_app_message_type = msg_type;
-	memcpy(_current_pending_outgoing_app_message_payload, msg_payload, payload_size);
+	if (direction == peer_relative_position::LEFT) {
+		uint8_t *const message = _app_messages + _left_app_messages_size;
+
+		message[0] = msg_type;
+		memcpy(message + 1, msg_payload, payload_size);
+		_left_app_messages_size += message_size;
+	} else {
+		_right_app_messages_size += message_size;
+
+		uint8_t *const message = _app_messages + queue_size - _right_app_messages_size;
+
+		memcpy(message, msg_payload, payload_size);
+		message[payload_size] = msg_type;
+	}
+
 	return enqueue_message_result::QUEUED;
 }
 
+bool nc::network_handler::is_line_quiet() noexcept
+{
+	if (_wire_protocol_state() == wire_protocol_state::UNCONNECTED) {
+		return true;
+	}
+
+	if (_message_reception_state() != message_reception_state::RECEIVE_MAGIC_BYTE_1 ||
+	    _left_serial.available() || _right_serial.available() ||
+	    _left_serial.is_receiving() || _right_serial.is_receiving()) {
+		// A message is being received.
+		return false;
+	}
+
+	if (_left_serial.is_transmitting() || _right_serial.is_transmitting()) {
+		// Our own bytes are going out.
+		return false;
+	}
+
+	if (_outgoing_message_count != 0) {
+		// The peer replies OK as soon as it gets our messages.
+		return false;
+	}
+
+	if (!_is_wire_protocol_in_a_reception_state(_wire_protocol_state())) {
+		// It is our turn to transmit, the peers are waiting on us.
+		return true;
+	}
+
+	return millis() - _last_ok_sent_time_ms <
+		nsec::config::communication::network_handler_quiet_window_after_ok_ms;
+}
+
 bool nc::network_handler::_is_wire_protocol_in_a_reception_state(wire_protocol_state state) noexcept
 {
 	return state == wire_protocol_state::DISCOVERY_RECEIVE_ANNOUNCE ||
@@ -645,229 +1084,283 @@ void nc::network_handler::_run_wire_protocol(ns::absolute_time_ms current_time_m
 		    nsec::config::communication::network_handler_timeout_ms &&
 	    _wire_protocol_state() != wire_protocol_state ::UNCONNECTED) {
 		// No activity for a while... reset.
+		if (_left_link_speed_index) {
+			// The link may not sustain the negotiated speed, stick to the base speed.
+			_is_left_link_speed_limited = true;
+		}
+
+		if (_right_link_speed_index) {
+			_is_right_link_speed_limited = true;
+		}
+
 		_reset();
 		return;
 	}
 
-	uint8_t message_type;
+	uint8_t message_type, message_sequence;
 	uint8_t message_payload[nsec::config::communication::protocol_max_message_size -
 				sizeof(wire_msg_header)];
+	// Messages received this tick are acknowledged together, once.
+	bool is_acknowledgement_due = false;
+	uint8_t negotiated_message_type = uint8_t(wire_msg_type::NONE);
 
-	if (_is_wire_protocol_in_a_reception_state(_wire_protocol_state())) {
-		const auto receive_result =
-			_handle_reception(_listening_side_serial(), message_type, message_payload);
+	/*
+	 * Handle as many messages as are available: a batch of messages received, or
+	 * sent, in a single tick.
+	 */
+	while (true) {
+		const auto state = _wire_protocol_state();
+
+		if (_is_wire_protocol_in_a_reception_state(state)) {
+			const auto receive_result = _handle_reception(_listening_side_serial(),
+								      message_type,
+								      message_sequence,
+								      message_payload);
+
+			if (receive_result != handle_reception_result::COMPLETE) {
+				/*
+				 * If the message is incomplete, we wait for the remaining data. If
+				 * the message is corrupted, we wait for a retransmission.
+				 */
+				if (receive_result == handle_reception_result::CORRUPTED) {
+					_corrupted_message_count++;
+				}
 
-		if (receive_result != handle_reception_result::COMPLETE) {
-			/*
-			 * If the message is incomplete, we wait for the remaining data. If the
-			 * message is corrupted, we wait for a retransmission.
-			 */
-			return;
-		}
+				break;
+			}
 
-		_last_message_received_time_ms = current_time_ms;
-		send_wire_ok_msg(_listening_side_serial());
+			if (is_wire_msg_acknowledgement(message_type)) {
+				// Repeated acknowledgement of messages we sent.
+				continue;
+			}
 
-		if (wire_msg_type(message_type) == wire_msg_type::RESET) {
-			_reset();
-			return;
-		}
-	}
+			if (wire_msg_type(message_type) == wire_msg_type::RESET) {
+				_reset();
+				return;
+			}
 
-	if (_message_transmission_state() != message_transmission_state::NONE) {
-		const auto transmit_result = _handle_transmission(current_time_ms);
-		if (transmit_result != handle_transmission_result::COMPLETE) {
-			return;
-		}
-	}
+			is_acknowledgement_due = true;
+			if (message_sequence != _expected_sequence(_listening_side())) {
+				// Repeated, or following a lost message: our acknowledgement tells.
+				continue;
+			}
 
-	switch (_wire_protocol_state()) {
-	case wire_protocol_state::UNCONNECTED:
-		// Nothing to do.
-		break;
-	case wire_protocol_state::WAIT_TO_INITIATE_DISCOVERY:
-		/*
-		 * State only reached by the left-most node.
-		 * Wait for the other boards to setup and expect our messages.
-		 */
-		if (_ticks_in_wire_state++ == 3) {
-			_wire_protocol_state(wire_protocol_state::DISCOVERY_SEND_ANNOUNCE);
-		}
+			_expected_sequence(_listening_side(), message_sequence + 1);
+			_last_message_received_time_ms = current_time_ms;
 
-		break;
-	case wire_protocol_state::DISCOVERY_RECEIVE_ANNOUNCE:
-	{
-		if (wire_msg_type(message_type) != wire_msg_type::ANNOUNCE) {
-			// Unexpected message: protocol error.
-			_reset();
-			return;
+			// Peer 0's time flows from the left-most node to the right.
+			if (wire_msg_type(message_type) == wire_msg_type::MONITOR &&
+			    _listening_side() == peer_relative_position::LEFT) {
+				const auto *monitor_msg =
+					reinterpret_cast<const wire_msg_monitor *>(message_payload);
+
+				_synchronize_network_time(monitor_msg->network_time_ms,
+							  current_time_ms);
+			}
+		} else {
+			if (is_acknowledgement_due) {
+				is_acknowledgement_due = false;
+				if (_acknowledge(current_time_ms, negotiated_message_type) &&
+				    _wave_front_direction() == _listening_side()) {
+					// Give the peer a tick to switch to the new speed.
+					return;
+				}
+			}
+
+			if (_outgoing_message_count != 0 &&
+			    _handle_transmission(current_time_ms) !=
+				    handle_transmission_result::COMPLETE) {
+				break;
+			}
 		}
 
-		/*
-		 * Our left neighbor announced themselves which allows us to allocate ourselves a
-		 * peer id.
-		 */
-		const auto *announce_msg =
-			reinterpret_cast<const wire_msg_announce *>(message_payload);
+		switch (_wire_protocol_state()) {
+		case wire_protocol_state::UNCONNECTED:
+			// Nothing to do.
+			break;
+		case wire_protocol_state::WAIT_TO_INITIATE_DISCOVERY:
+			/*
+			 * State only reached by the left-most node.
+			 * Wait for the other boards to setup and expect our messages.
+			 */
+			if (_ticks_in_wire_state++ == 3) {
+				_wire_protocol_state(wire_protocol_state::DISCOVERY_SEND_ANNOUNCE);
+			}
 
-		_peer_id = announce_msg->peer_id + 1;
+			break;
+		case wire_protocol_state::DISCOVERY_RECEIVE_ANNOUNCE:
+		{
+			if (wire_msg_type(message_type) != wire_msg_type::ANNOUNCE) {
+				// Unexpected message: protocol error.
+				_reset();
+				return;
+			}
 
-		/*
-		 * Only valid for the right-most node, otherwise it will be overwriten when
-		 * ANNOUNCE_REPLY is received.
-		 */
-		_peer_count = _peer_id + 1;
-		_wire_protocol_state(wire_protocol_state::DISCOVERY_RECEIVE_MONITOR_AFTER_ANNOUNCE);
-		break;
-	}
-	case wire_protocol_state::DISCOVERY_RECEIVE_MONITOR_AFTER_ANNOUNCE:
-		if (wire_msg_type(message_type) != wire_msg_type::MONITOR) {
-			// Unexpected message: protocol error.
-			_reset();
-			return;
-		}
+			/*
+			 * Our left neighbor announced themselves which allows us to allocate
+			 * ourselves a peer id.
+			 */
+			const auto *announce_msg =
+				reinterpret_cast<const wire_msg_announce *>(message_payload);
 
-		// It is our turn to transmit.
-		if (position() == link_position::MIDDLE) {
-			// Announce ourselves to the right-side neighbor.
-			_wire_protocol_state(wire_protocol_state::DISCOVERY_SEND_ANNOUNCE);
-		} else {
-			// We are the right-most node, initiate the announce reply.
-			_wire_protocol_state(wire_protocol_state::DISCOVERY_SEND_ANNOUNCE_REPLY);
+			_peer_id = announce_msg->peer_id + 1;
+
+			/*
+			 * Only valid for the right-most node, otherwise it will be overwriten
+			 * when ANNOUNCE_REPLY is received.
+			 */
+			_peer_count = _peer_id + 1;
+			_wire_protocol_state(
+				wire_protocol_state::DISCOVERY_RECEIVE_MONITOR_AFTER_ANNOUNCE);
+			break;
 		}
+		case wire_protocol_state::DISCOVERY_RECEIVE_MONITOR_AFTER_ANNOUNCE:
+			if (wire_msg_type(message_type) != wire_msg_type::MONITOR) {
+				// Unexpected message: protocol error.
+				_reset();
+				return;
+			}
 
-		break;
-	case wire_protocol_state::DISCOVERY_SEND_ANNOUNCE:
-	{
-		// Not reachable by the right-most node.
-		const wire_msg_announce our_annouce_msg = { .peer_id = _peer_id };
+			negotiated_message_type = uint8_t(wire_msg_type::ANNOUNCE);
 
-		_set_outgoing_message(current_time_ms,
-				      uint8_t(wire_msg_type::ANNOUNCE),
-				      reinterpret_cast<const uint8_t *>(&our_annouce_msg));
-		_wire_protocol_state(wire_protocol_state::DISCOVERY_CONFIRM_ANNOUNCE);
-		break;
-	}
-	case wire_protocol_state::DISCOVERY_CONFIRM_ANNOUNCE:
-		_wire_protocol_state(wire_protocol_state::DISCOVERY_SEND_MONITOR_AFTER_ANNOUNCE);
-		break;
-	case wire_protocol_state::DISCOVERY_SEND_MONITOR_AFTER_ANNOUNCE:
-		// Not reachable by the right-most node.
-		_set_outgoing_message(current_time_ms, uint8_t(wire_msg_type::MONITOR));
-		_wire_protocol_state(wire_protocol_state::DISCOVERY_CONFIRM_MONITOR_AFTER_ANNOUNCE);
-		break;
-	case wire_protocol_state::DISCOVERY_CONFIRM_MONITOR_AFTER_ANNOUNCE:
-		_wave_front_direction(peer_relative_position::LEFT);
+			// It is our turn to transmit.
+			if (position() == link_position::MIDDLE) {
+				// Announce ourselves to the right-side neighbor.
+				_wire_protocol_state(wire_protocol_state::DISCOVERY_SEND_ANNOUNCE);
+			} else {
+				// We are the right-most node, initiate the announce reply.
+				_wire_protocol_state(
+					wire_protocol_state::DISCOVERY_SEND_ANNOUNCE_REPLY);
+			}
 
-		// Next message (ANNOUNCE_REPLY) will come from our right neighbor.
-		_listening_side(peer_relative_position::RIGHT);
-		_wire_protocol_state(wire_protocol_state::DISCOVERY_RECEIVE_ANNOUNCE_REPLY);
-		break;
-	case wire_protocol_state::DISCOVERY_RECEIVE_ANNOUNCE_REPLY:
-	{
-		// Not reachable by the right-most node.
-		const auto *announce_reply_msg =
-			reinterpret_cast<const wire_msg_announce_reply *>(message_payload);
+			break;
+		case wire_protocol_state::DISCOVERY_SEND_ANNOUNCE:
+		{
+			// Not reachable by the right-most node.
+			const wire_msg_announce our_annouce_msg = { .peer_id = _peer_id };
+
+			_enqueue_outgoing_message(
+				uint8_t(wire_msg_type::ANNOUNCE),
+				reinterpret_cast<const uint8_t *>(&our_annouce_msg));
+			_enqueue_outgoing_message(uint8_t(wire_msg_type::MONITOR));
+			_wire_protocol_state(
+				wire_protocol_state::DISCOVERY_CONFIRM_MONITOR_AFTER_ANNOUNCE);
+			break;
+		}
+		case wire_protocol_state::DISCOVERY_CONFIRM_MONITOR_AFTER_ANNOUNCE:
+			_wave_front_direction(peer_relative_position::LEFT);
 
-		_peer_count = announce_reply_msg->peer_count;
-		_wire_protocol_state(
-			wire_protocol_state::DISCOVERY_RECEIVE_MONITOR_AFTER_ANNOUNCE_REPLY);
-		break;
-	}
-	case wire_protocol_state::DISCOVERY_RECEIVE_MONITOR_AFTER_ANNOUNCE_REPLY:
-		if (wire_msg_type(message_type) != wire_msg_type::MONITOR) {
-			// Unexpected message: protocol error.
-			_reset();
-			return;
+			// Next message (ANNOUNCE_REPLY) will come from our right neighbor.
+			_listening_side(peer_relative_position::RIGHT);
+			_wire_protocol_state(wire_protocol_state::DISCOVERY_RECEIVE_ANNOUNCE_REPLY);
+			break;
+		case wire_protocol_state::DISCOVERY_RECEIVE_ANNOUNCE_REPLY:
+		{
+			// Not reachable by the right-most node.
+			const auto *announce_reply_msg =
+				reinterpret_cast<const wire_msg_announce_reply *>(message_payload);
+
+			_peer_count = announce_reply_msg->peer_count;
+			_wire_protocol_state(
+				wire_protocol_state::DISCOVERY_RECEIVE_MONITOR_AFTER_ANNOUNCE_REPLY);
+			break;
 		}
+		case wire_protocol_state::DISCOVERY_RECEIVE_MONITOR_AFTER_ANNOUNCE_REPLY:
+			if (wire_msg_type(message_type) != wire_msg_type::MONITOR) {
+				// Unexpected message: protocol error.
+				_reset();
+				return;
+			}
 
-		if (position() == link_position::MIDDLE) {
-			_wire_protocol_state(wire_protocol_state::DISCOVERY_SEND_ANNOUNCE_REPLY);
-		} else {
-			// We are the left-most node.
+			negotiated_message_type = uint8_t(wire_msg_type::ANNOUNCE_REPLY);
+
+			if (position() == link_position::MIDDLE) {
+				_wire_protocol_state(
+					wire_protocol_state::DISCOVERY_SEND_ANNOUNCE_REPLY);
+			} else {
+				// We are the left-most node.
+				_wave_front_direction(peer_relative_position::RIGHT);
+				_wire_protocol_state(wire_protocol_state::RUNNING_SEND_APP_MESSAGE);
+			}
+
+			break;
+		case wire_protocol_state::DISCOVERY_SEND_ANNOUNCE_REPLY:
+		{
+			const wire_msg_announce_reply announce_reply_msg = { .peer_count =
+										     _peer_count };
+
+			_enqueue_outgoing_message(
+				uint8_t(wire_msg_type::ANNOUNCE_REPLY),
+				reinterpret_cast<const uint8_t *>(&announce_reply_msg));
+			_enqueue_outgoing_message(uint8_t(wire_msg_type::MONITOR));
+			_wire_protocol_state(
+				wire_protocol_state::DISCOVERY_CONFIRM_MONITOR_AFTER_ANNOUNCE_REPLY);
+			break;
+		}
+		case wire_protocol_state::DISCOVERY_CONFIRM_MONITOR_AFTER_ANNOUNCE_REPLY:
+			// Next message will come from the left.
+			_listening_side(peer_relative_position::LEFT);
 			_wave_front_direction(peer_relative_position::RIGHT);
-			_wire_protocol_state(wire_protocol_state::RUNNING_SEND_APP_MESSAGE);
+			_wire_protocol_state(wire_protocol_state::RUNNING_RECEIVE_MESSAGE);
+			break;
+		case wire_protocol_state::RUNNING_RECEIVE_MESSAGE:
+		{
+			if (message_type >=
+			    nsec::config::communication::application_message_type_range_begin) {
+				// Process app-level message
+				if (nsec::g::the_badge.on_message_received(
+					    nc::message::type(message_type), message_payload) ==
+				    application_message_action::ERROR) {
+					_reset();
+					return;
+				}
+			} else if (wire_msg_type(message_type) == wire_msg_type::MONITOR) {
+				_wire_protocol_state(wire_protocol_state::RUNNING_SEND_APP_MESSAGE);
+			} else {
+				// Unexpected message or a reset message.
+				_reset();
+				return;
+			}
+
+			break;
 		}
+		case wire_protocol_state::RUNNING_SEND_APP_MESSAGE:
+		{
+			constexpr auto idle_hold_ticks =
+				nsec::config::communication::network_handler_idle_monitor_hold_ticks;
 
-		break;
-	case wire_protocol_state::DISCOVERY_SEND_ANNOUNCE_REPLY:
-	{
-		const wire_msg_announce_reply announce_reply_msg = { .peer_count = _peer_count };
+			// The MONITOR message passes the wave front on, after our messages.
+			while (_outgoing_message_count <
+				       nsec::config::communication::transmit_window_size - 1 &&
+			       _dequeue_app_message(_sending_side())) {
+			}
 
-		_set_outgoing_message(current_time_ms,
-				      uint8_t(wire_msg_type::ANNOUNCE_REPLY),
-				      reinterpret_cast<const uint8_t *>(&announce_reply_msg));
+			if (_outgoing_message_count != 0 ||
+			    _ticks_in_wire_state++ == idle_hold_ticks) {
+				_enqueue_outgoing_message(uint8_t(wire_msg_type::MONITOR));
+				_wire_protocol_state(wire_protocol_state::RUNNING_CONFIRM_MONITOR);
+			}
 
-		_wire_protocol_state(wire_protocol_state::DISCOVERY_CONFIRM_ANNOUNCE_REPLY);
-		break;
-	}
-	case wire_protocol_state::DISCOVERY_CONFIRM_ANNOUNCE_REPLY:
-		_wire_protocol_state(
-			wire_protocol_state::DISCOVERY_SEND_MONITOR_AFTER_ANNOUNCE_REPLY);
-		break;
-	case wire_protocol_state::DISCOVERY_SEND_MONITOR_AFTER_ANNOUNCE_REPLY:
-		_set_outgoing_message(current_time_ms, uint8_t(wire_msg_type::MONITOR));
-		_wire_protocol_state(
-			wire_protocol_state::DISCOVERY_CONFIRM_MONITOR_AFTER_ANNOUNCE_REPLY);
-		break;
-	case wire_protocol_state::DISCOVERY_CONFIRM_MONITOR_AFTER_ANNOUNCE_REPLY:
-		// Next message will come from the left.
-		_listening_side(peer_relative_position::LEFT);
-		_wave_front_direction(peer_relative_position::RIGHT);
-		_wire_protocol_state(wire_protocol_state::RUNNING_RECEIVE_MESSAGE);
-		break;
-	case wire_protocol_state::RUNNING_RECEIVE_MESSAGE:
-	{
-		if (message_type >=
-		    nsec::config::communication::application_message_type_range_begin) {
-			// Process app-level message
-			nsec::g::the_badge.on_message_received(nc::message::type(message_type), message_payload);
-		} else if (wire_msg_type(message_type) == wire_msg_type::MONITOR) {
-			_wire_protocol_state(wire_protocol_state::RUNNING_SEND_APP_MESSAGE);
-		} else {
-			// Unexpected message or a reset message.
-			_reset();
-			return;
+			break;
 		}
+		case wire_protocol_state::RUNNING_CONFIRM_MONITOR:
+			if (position() == link_position::MIDDLE) {
+				_reverse_wave_front_direction();
+			}
 
-		break;
-	}
-	case wire_protocol_state::RUNNING_SEND_APP_MESSAGE:
-	{
-		const auto is_middle_peer = position() ==
-			nc::network_handler::link_position::MIDDLE;
-		const auto pending_matches_wave_front_direction =
-			_pending_outgoing_app_message_direction() == _wave_front_direction();
-
-		if (_has_pending_outgoing_app_message() &&
-		    (!is_middle_peer || (is_middle_peer && pending_matches_wave_front_direction))) {
-			_set_outgoing_message(current_time_ms,
-					      _current_pending_outgoing_app_message_type,
-					      _current_pending_outgoing_app_message_payload);
-			_clear_pending_outgoing_app_message();
-			_wire_protocol_state(wire_protocol_state::RUNNING_CONFIRM_APP_MESSAGE);
-		} else {
-			// Nothing sent, skip the confirmation step.
-			_wire_protocol_state(wire_protocol_state::RUNNING_SEND_MONITOR);
+			_wire_protocol_state(wire_protocol_state::RUNNING_RECEIVE_MESSAGE);
+			break;
 		}
 
-		break;
-	}
-	case wire_protocol_state::RUNNING_CONFIRM_APP_MESSAGE:
-		nsec::g::the_badge.on_app_message_sent();
-		_wire_protocol_state(wire_protocol_state::RUNNING_SEND_MONITOR);
-		break;
-	case wire_protocol_state::RUNNING_SEND_MONITOR:
-		_set_outgoing_message(current_time_ms, uint8_t(wire_msg_type::MONITOR));
-		_wire_protocol_state(wire_protocol_state::RUNNING_CONFIRM_MONITOR);
-		break;
-	case wire_protocol_state::RUNNING_CONFIRM_MONITOR:
-		if (position() == link_position::MIDDLE) {
-			_reverse_wave_front_direction();
+		if (_wire_protocol_state() == state &&
+		    !_is_wire_protocol_in_a_reception_state(state)) {
+			// Waiting on the next tick.
+			break;
 		}
+	}
 
-		_wire_protocol_state(wire_protocol_state::RUNNING_RECEIVE_MESSAGE);
-		break;
+	if (is_acknowledgement_due) {
+		_acknowledge(current_time_ms, negotiated_message_type);
 	}
 }
 
@@ -10,15 +10,21 @@
 
 namespace nd = nsec::display;
 namespace ns = nsec::scheduling;
+namespace ncd = nsec::config::display;
 
 namespace {
-constexpr uint16_t render_time_sampling_period = 300;
-};
+// Weight of a new sample in the render time moving average, as a power of two.
+constexpr uint8_t render_time_average_shift = 3;
+} // namespace
 
 nd::renderer::renderer(nd::screen **focused_screen) noexcept :
-	periodic_task(nsec::config::display::refresh_period_ms),
+	periodic_task(ncd::refresh_period_ms),
 	_display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, OLED_RESET),
-	_render_time_sampling_counter{ 0 },
+	_average_render_time_us{ 0 },
+	_network_activity{ false },
+	_current_power_state{ uint8_t(power_state::ON) },
+	_activity_pending{ true },
+	_last_activity_time_ms{ 0 },
 	_focused_screen{ focused_screen }
 {
 	nsec::g::the_scheduler.schedule_task(*this);
@@ -33,12 +39,79 @@ void nd::renderer::setup() noexcept
 	_display.display();
 }
 
+void nd::renderer::network_activity(bool active) noexcept
+{
+	// Network state changes follow badges being (dis)connected.
+	wake();
+	_network_activity = active;
+	_govern_refresh_period();
+}
+
+bool nd::renderer::wake() noexcept
+{
+	const auto previous_power_state = _power_state();
+
+	_activity_pending = true;
+	if (previous_power_state == power_state::ON) {
+		return false;
+	}
+
+	// The panel retains its content while off.
+	_display.dim(false);
+	if (previous_power_state == power_state::OFF) {
+		_display.ssd1306_command(SSD1306_DISPLAYON);
+		revive();
+		if (!scheduled()) {
+			nsec::g::the_scheduler.schedule_task(*this);
+		}
+	}
+
+	_current_power_state = uint8_t(power_state::ON);
+	_govern_refresh_period();
+	return previous_power_state == power_state::OFF;
+}
+
+void nd::renderer::_update_power_state(scheduling::absolute_time_ms current_time_ms) noexcept
+{
+	if (_activity_pending || _network_activity) {
+		_activity_pending = false;
+		_last_activity_time_ms = current_time_ms;
+	}
+
+	const auto inactive_time_ms = current_time_ms - _last_activity_time_ms;
+
+	switch (_power_state()) {
+	case power_state::ON:
+		if (inactive_time_ms >= ncd::dim_after_inactivity_ms) {
+			_display.dim(true);
+			_current_power_state = uint8_t(power_state::DIMMED);
+			_govern_refresh_period();
+		}
+
+		break;
+	case power_state::DIMMED:
+		if (inactive_time_ms >= ncd::off_after_inactivity_ms) {
+			_display.ssd1306_command(SSD1306_DISPLAYOFF);
+			_current_power_state = uint8_t(power_state::OFF);
+			// Unscheduled until woken-up.
+			kill();
+		}
+
+		break;
+	case power_state::OFF:
+		break;
+	}
+}
+
 void nd::renderer::run(scheduling::absolute_time_ms current_time_ms) noexcept
 {
-	if (!focused_screen().is_damaged()) {
+	_update_power_state(current_time_ms);
+	if (_power_state() == power_state::OFF || !focused_screen().is_damaged()) {
 		return;
 	}
 
+	const auto render_start_us = micros();
+
 	if (focused_screen().cleared_on_every_frame()) {
 		_display.clearDisplay();
 	}
@@ -48,7 +121,70 @@ void nd::renderer::run(scheduling::absolute_time_ms current_time_ms) noexcept
 		_display.display();
 	}
 
-	if (++_render_time_sampling_counter == render_time_sampling_period) {
-		_render_time_sampling_counter = 0;
+	const auto render_time_us = micros() - render_start_us;
+
+	_average_render_time_us = _average_render_time_us -
+		(_average_render_time_us >> render_time_average_shift) +
+		(min(render_time_us, uint32_t(UINT16_MAX)) >> render_time_average_shift);
+	_govern_refresh_period();
+}
+
+nd::renderer::refresh_period_bounds nd::renderer::_refresh_period_bounds() const noexcept
+{
+	refresh_period_bounds bounds;
+
+	switch (focused_screen().content()) {
+	case screen::content_type::SCROLLING:
+		bounds = { ncd::scrolling_content_min_refresh_period_ms,
+			   ncd::scrolling_content_max_refresh_period_ms };
+		break;
+	case screen::content_type::STATIC:
+	default:
+		bounds = { ncd::static_content_min_refresh_period_ms,
+			   ncd::static_content_max_refresh_period_ms };
+		break;
+	}
+
+	if (_network_activity) {
+		bounds.min = max(bounds.min, ncd::network_activity_min_refresh_period_ms);
+	}
+
+	if (_power_state() != power_state::ON) {
+		bounds.min = max(bounds.min, ncd::low_power_min_refresh_period_ms);
+	}
+
+	bounds.max = max(bounds.max, bounds.min);
+	return bounds;
+}
+
+/*
+ * Pick the refresh period that keeps the renderer within its share of the CPU
+ * time given the measured render time. Static screens are only redrawn when
+ * damaged, so they are polled as slowly as their bounds allow.
+ */
+void nd::renderer::_govern_refresh_period() noexcept
+{
+	const auto bounds = _refresh_period_bounds();
+	ns::relative_time_ms target_period_ms = bounds.max;
+
+	if (focused_screen().content() != screen::content_type::STATIC) {
+		const uint8_t budget_divisor = _network_activity ?
+			ncd::network_activity_render_time_budget_divisor :
+			ncd::render_time_budget_divisor;
+		const auto budgeted_period_ms =
+			(uint32_t(_average_render_time_us) * budget_divisor) / 1000;
+
+		target_period_ms = constrain(budgeted_period_ms, bounds.min, bounds.max);
+	}
+
+	const auto current_period_ms = period_ms();
+	const auto delta_ms = target_period_ms > current_period_ms ?
+		target_period_ms - current_period_ms :
+		current_period_ms - target_period_ms;
+
+	// Hysteresis: only apply significant changes, unless the bounds changed.
+	if (current_period_ms < bounds.min || current_period_ms > bounds.max ||
+	    delta_ms > current_period_ms / ncd::refresh_period_hysteresis_divisor) {
+		period_ms(target_period_ms);
 	}
 }
@@ -13,8 +13,17 @@ namespace nd = nsec::display;
 namespace ndu = nsec::display::utils;
 namespace nb = nsec::button;
 
-nd::menu_screen::menu_screen() noexcept : screen()
+nd::menu_screen::menu_screen() noexcept : screen(), _full_redraw_needed{ true }
 {
+	// Only the damaged lines are redrawn and pushed to the display.
+	_cleared_on_every_frame = false;
+}
+
+void nd::menu_screen::focused() noexcept
+{
+	// Another screen drew over our content.
+	_full_redraw_needed = true;
+	screen::focused();
 }
 
 void nd::menu_screen::button_event(nb::id id, nb::event event) noexcept
@@ -74,81 +83,158 @@ bool nd::menu_screen::_is_choice_offscreen(unsigned int choice) const noexcept
 						    _layout_constraints._lines_per_screen);
 }
 
-void nd::menu_screen::_render(scheduling::absolute_time_ms current_time_ms,
-			      Adafruit_SSD1306& canvas) noexcept
+nd::menu_screen::line_mask nd::menu_screen::_line_mask_of_choice(unsigned int choice) const noexcept
 {
-	if (!_layout_constraints_initialized) {
-		_initialize_layout_constraints(canvas);
+	return _is_choice_offscreen(choice) ? 0 : 1 << (choice - _first_drawn_choice_index);
+}
+
+void nd::menu_screen::_shift_lines(Adafruit_SSD1306& canvas, int line_count) const noexcept
+{
+	// Move the frame buffer's pages to reuse the lines that remain visible after a scroll.
+	const auto line_size = canvas.width() * (_layout_constraints.glyph_size.height / 8);
+	const auto moved_size = line_size * (_layout_constraints._lines_per_screen - 1);
+	auto *framebuffer = canvas.getBuffer();
+
+	if (line_count > 0) {
+		memmove(framebuffer, framebuffer + line_size, moved_size);
+	} else {
+		memmove(framebuffer + line_size, framebuffer, moved_size);
 	}
+}
 
-	canvas.setCursor(0, 0);
-	canvas.setTextSize(nsec::config::display::menu_font_size);
+void nd::menu_screen::_render_line(Adafruit_SSD1306& canvas,
+				   uint8_t line,
+				   bool reserve_indicator_column) const noexcept
+{
+	const auto choice_being_drawn_idx = _first_drawn_choice_index + line;
+	const auto is_active_choice = choice_being_drawn_idx == _active_choice_idx;
+	const int16_t y_position = line * _layout_constraints.glyph_size.height;
+
+	// Erase the previous content and highlight current choice by inverting colors.
+	canvas.fillRect(0,
+			y_position,
+			canvas.width(),
+			_layout_constraints.glyph_size.height,
+			is_active_choice ? SSD1306_WHITE : SSD1306_BLACK);
+	if (choice_being_drawn_idx >= _choices->count()) {
+		return;
+	}
+
+	canvas.setCursor(0, y_position);
 
-	const auto choices_to_draw_count =
-		min(_choices->count(), _layout_constraints._lines_per_screen);
-	const auto draw_up_indicator = _first_drawn_choice_index != 0;
-	const auto draw_down_indicator = _choices->count() >
-		static_cast<unsigned int>(_first_drawn_choice_index +
-					  _layout_constraints._lines_per_screen);
 	// Reserve a character if we have to draw the scrollbar
-	const auto max_line_length = (draw_up_indicator || draw_down_indicator) ?
-		_layout_constraints._chars_per_screen - 1 :
-		_layout_constraints._chars_per_screen;
-
-	int y_position = 0;
-	for (auto line_drawn = 0U; line_drawn < choices_to_draw_count; ++line_drawn) {
-		const auto choice_being_drawn_idx = _first_drawn_choice_index + line_drawn;
-		canvas.setCursor(0, y_position);
-
-		// Highlight current choice by inverting colors.
-		if (choice_being_drawn_idx == _active_choice_idx) {
-			canvas.fillRect(0,
-					y_position,
-					canvas.width(),
-					_layout_constraints.glyph_size.height,
-					SSD1306_WHITE);
-			canvas.setTextColor(SSD1306_BLACK, SSD1306_WHITE);
-		} else {
-			canvas.setTextColor(SSD1306_WHITE, SSD1306_BLACK);
-		}
+	const auto max_line_width = reserve_indicator_column ?
+		canvas.width() - _layout_constraints.glyph_size.width :
+		canvas.width();
 
-		ndu::draw_string(canvas, (*_choices)[choice_being_drawn_idx].name, max_line_length);
-		y_position += _layout_constraints.glyph_size.height;
-	}
+	ndu::draw_string(canvas,
+			 nsec::display::font::small,
+			 (*_choices)[choice_being_drawn_idx].name,
+			 max_line_width,
+			 is_active_choice ? SSD1306_BLACK : SSD1306_WHITE);
 
 	const auto last_char_x_position =
 		_layout_constraints.glyph_size.width * (_layout_constraints._chars_per_screen - 1);
-	if (draw_down_indicator) {
-		// Invert color of down indicator if the active choice is the last one on the
-		// screen.
-		const auto indicator_color = (_active_choice_idx - _first_drawn_choice_index) ==
-				(_layout_constraints._lines_per_screen - 1) ?
-			SSD1306_BLACK :
-			SSD1306_WHITE;
-
-		// If there are choices remaining, the cursor is already in the right place on the
-		// Y-axis (last line).
+	// Invert color of the indicators if they are on the active choice's line.
+	const auto indicator_color = is_active_choice ? SSD1306_BLACK : SSD1306_WHITE;
+
+	if (line == _layout_constraints._lines_per_screen - 1 &&
+	    _choices->count() >
+		    static_cast<unsigned int>(_first_drawn_choice_index +
+					      _layout_constraints._lines_per_screen)) {
 		ndu::draw_arrow_glyph(canvas,
 				      last_char_x_position,
-				      canvas.getCursorY(),
+				      y_position,
 				      _layout_constraints.glyph_size.width,
 				      _layout_constraints.glyph_size.height,
 				      indicator_color,
 				      ndu::arrow_glyph_direction::DOWN);
 	}
 
-	if (draw_up_indicator) {
-		// Invert color of up indicator if the active choice is the first one on the screen.
-		const auto indicator_color = (_active_choice_idx - _first_drawn_choice_index) == 0 ?
-			SSD1306_BLACK :
-			SSD1306_WHITE;
-
+	if (line == 0 && _first_drawn_choice_index != 0) {
 		ndu::draw_arrow_glyph(canvas,
 				      last_char_x_position,
-				      0,
+				      y_position,
 				      _layout_constraints.glyph_size.width,
 				      _layout_constraints.glyph_size.height,
 				      indicator_color,
 				      ndu::arrow_glyph_direction::UP);
 	}
 }
+
+void nd::menu_screen::_flush_lines(Adafruit_SSD1306& canvas, line_mask lines) const noexcept
+{
+	const uint8_t pages_per_line = _layout_constraints.glyph_size.height / 8;
+	uint8_t line = 0;
+
+	// Push each run of contiguous damaged lines in a single transfer.
+	while (line < _layout_constraints._lines_per_screen) {
+		if (!((lines >> line) & 1)) {
+			line++;
+			continue;
+		}
+
+		const auto first_line_of_run = line;
+		while (line < _layout_constraints._lines_per_screen && ((lines >> line) & 1)) {
+			line++;
+		}
+
+		canvas.display(first_line_of_run * pages_per_line, (line * pages_per_line) - 1);
+	}
+}
+
+void nd::menu_screen::_render(scheduling::absolute_time_ms current_time_ms,
+			      Adafruit_SSD1306& canvas) noexcept
+{
+	if (!_layout_constraints_initialized) {
+		_initialize_layout_constraints(canvas);
+	}
+
+	const auto draw_up_indicator = _first_drawn_choice_index != 0;
+	const auto draw_down_indicator = _choices->count() >
+		static_cast<unsigned int>(_first_drawn_choice_index +
+					  _layout_constraints._lines_per_screen);
+	const auto reserve_indicator_column = draw_up_indicator || draw_down_indicator;
+	const line_mask all_lines = (1 << _layout_constraints._lines_per_screen) - 1;
+	const line_mask top_line = 1;
+	const line_mask bottom_line = 1 << (_layout_constraints._lines_per_screen - 1);
+
+	line_mask damaged_lines = 0;
+
+	if (_full_redraw_needed || reserve_indicator_column != _drawn_with_indicators) {
+		canvas.clearDisplay();
+		damaged_lines = all_lines;
+	} else {
+		const int scroll_delta = static_cast<int>(_first_drawn_choice_index) -
+			static_cast<int>(_drawn_first_choice_index);
+
+		if (scroll_delta == 1 || scroll_delta == -1) {
+			_shift_lines(canvas, scroll_delta);
+			// Newly revealed line, and the indicators which don't move with the content.
+			damaged_lines = top_line | bottom_line;
+		} else if (scroll_delta != 0) {
+			damaged_lines = all_lines;
+		}
+
+		// Previous and new highlighted lines.
+		damaged_lines |= _line_mask_of_choice(_drawn_active_choice_idx);
+		damaged_lines |= _line_mask_of_choice(_active_choice_idx);
+	}
+
+	// All lines changed on screen when the content was shifted.
+	const line_mask flushed_lines =
+		_first_drawn_choice_index != _drawn_first_choice_index ? all_lines : damaged_lines;
+
+	for (uint8_t line = 0; line < _layout_constraints._lines_per_screen; line++) {
+		if ((damaged_lines >> line) & 1) {
+			_render_line(canvas, line, reserve_indicator_column);
+		}
+	}
+
+	_flush_lines(canvas, flushed_lines);
+
+	_full_redraw_needed = false;
+	_drawn_with_indicators = reserve_indicator_column;
+	_drawn_active_choice_idx = _active_choice_idx;
+	_drawn_first_choice_index = _first_drawn_choice_index;
+}
@@ -7,7 +7,8 @@
 #include "display/screen.hpp"
 #include "globals.hpp"
 
-nsec::display::screen::screen() noexcept : _cleared_on_every_frame{ true }
+nsec::display::screen::screen() noexcept :
+	_cleared_on_every_frame{ true }, _content_type{ uint8_t(content_type::STATIC) }
 {
 }
 
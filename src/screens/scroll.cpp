@@ -6,17 +6,17 @@
 
 #include "display/screen.hpp"
 #include "display/scroll.hpp"
-#include "display/utils.hpp"
+#include "display/font.hpp"
 #include "globals.hpp"
 
 namespace nd = nsec::display;
-namespace ndu = nsec::display::utils;
+namespace nf = nsec::display::font;
 namespace nb = nsec::button;
 namespace ns = nsec::scheduling;
 
 namespace {
 const char repeat_separator[] PROGMEM = "|";
-constexpr uint8_t repeat_separator_padding = 4 * nsec::config::display::scroll_font_size;
+constexpr uint8_t repeat_separator_padding = 8;
 
 inline char to_char(const char *src)
 {
@@ -33,27 +33,44 @@ const __FlashStringHelper *as_flash_string(const char *str)
 	return static_cast<const __FlashStringHelper *>(static_cast<const void *>(str));
 }
 
+/*
+ * Draw the characters of a string that intersect the canvas, starting at x,
+ * and return the position following the string.
+ */
 template <typename StringType>
-uint8_t property_renderable_character_count(const StringType *property)
-{
-	unsigned int length = 0;
-	auto current_ptr = reinterpret_cast<const char *>(property);
+int16_t draw_visible_characters(Adafruit_SSD1306& canvas,
+				const StringType *str,
+				int16_t x,
+				uint8_t page) noexcept
+{
+	auto current_ptr = reinterpret_cast<const char *>(str);
+
+	for (char current_char;
+	     (current_char = to_char(reinterpret_cast<const StringType *>(current_ptr))) != '\0';
+	     current_ptr++) {
+		const auto character_width = nf::character_width(nf::large, current_char);
+
+		if (x + character_width <= 0) {
+			// Off-screen to the left, only advance.
+			x += character_width;
+			continue;
+		}
 
-	while (to_char(reinterpret_cast<const StringType *>(current_ptr++))) {
-		length++;
+		if (x >= canvas.width()) {
+			break;
+		}
+
+		x = nf::draw_character(
+			canvas, nf::large, current_char, x, page, SSD1306_WHITE, canvas.width());
 	}
 
-	return length;
+	return x;
 }
 
 unsigned int window_offset_from_frame_time(nsec::scheduling::absolute_time_ms time,
-					   uint8_t character_width,
-					   uint8_t character_count,
-					   uint16_t separator_width)
+					   uint16_t total_string_width)
 {
 	// Compute x offset of the viewport according to the time
-	const auto total_string_width = (character_width * character_count) + int(separator_width);
-
 	auto window_offset = nsec::config::display::scroll_pixels_per_second * (time / 1000);
 	window_offset += ((nsec::config::display::scroll_pixels_per_second) * (time % 1000)) / 1000;
 	window_offset %= total_string_width;
@@ -62,9 +79,11 @@ unsigned int window_offset_from_frame_time(nsec::scheduling::absolute_time_ms ti
 }
 } // namespace
 
-nd::scroll_screen::scroll_screen() noexcept : screen()
+nd::scroll_screen::scroll_screen() noexcept :
+	screen(), _closely_repeat_string{ false }, _full_flush_needed{ true }
 {
 	_cleared_on_every_frame = false;
+	_content_type = uint8_t(content_type::SCROLLING);
 }
 
 void nd::scroll_screen::button_event(nb::id id, nb::event event) noexcept
@@ -97,93 +116,37 @@ void nd::scroll_screen::button_event(nb::id id, nb::event event) noexcept
 	}
 }
 
-char nd::scroll_screen::_property_character_at_offset(uint8_t offset) const noexcept
-{
-	return _property.is_value_in_ram ?
-		to_char(_property.ram_value + offset) :
-		to_char(as_flash_string(reinterpret_cast<const char *>(_property.flash_value) +
-					offset));
-}
-
-void nd::scroll_screen::_render_current_property_character(Adafruit_SSD1306& canvas) const noexcept
-{
-	canvas.drawChar(canvas.getCursorX(),
-			canvas.getCursorY(),
-			_property_character_at_offset(_current_character_offset),
-			SSD1306_WHITE,
-			SSD1306_BLACK,
-			nsec::config::display::scroll_font_size);
-	canvas.setCursor(canvas.getCursorX() + _scroll_character_width, canvas.getCursorY());
-}
-
 void nd::scroll_screen::_render(scheduling::absolute_time_ms current_time_ms,
 				Adafruit_SSD1306& canvas) noexcept
 {
-	if (!_layout_initialized) {
-		_initialize_layout(canvas);
-	}
+	// The text is centered vertically; only its pages change from frame to frame.
+	const uint8_t page_count = nf::page_count(nf::large);
+	const uint8_t first_page = ((canvas.height() / 8) - page_count) / 2;
 
-	switch (_render_state()) {
-	case render_state::FRAME_SETUP:
-	{
-		// Compute x offset of the viewport according to the time.
-		const unsigned int window_offset =
-			window_offset_from_frame_time(current_time_ms,
-						      _scroll_character_width,
-						      _property.renderable_character_count,
-						      _separator_rendered_width());
-
-		canvas.setTextSize(nsec::config::display::scroll_font_size);
-		canvas.setCursor(-static_cast<int16_t>(window_offset), _scroll_character_y_offset);
-		canvas.setTextWrap(false);
+	if (_full_flush_needed) {
 		canvas.clearDisplay();
-		_render_state(render_state::FIRST_VISIBLE_CHARACTER_RENDERING);
-		break;
+	} else {
+		memset(canvas.getBuffer() + (first_page * canvas.width()),
+		       0,
+		       page_count * canvas.width());
 	}
-	case render_state::FIRST_VISIBLE_CHARACTER_RENDERING:
-	{
-		// Render (off-screen) characters until we step into the visible area.
-		while (canvas.getCursorX() < 0) {
-			_render_current_property_character(canvas);
-			_current_character_offset++;
-
-			if (_current_character_offset == _property.renderable_character_count) {
-				break;
-			}
-		}
 
-		_render_state(_current_character_offset < _property.renderable_character_count ?
-				      render_state::VISIBLE_CHARACTER_CHUNK_RENDERING :
-				      render_state::SEPARATOR_RENDERING);
-		break;
-	}
-	case render_state::VISIBLE_CHARACTER_CHUNK_RENDERING:
-		_render_current_property_character(canvas);
-		_current_character_offset++;
-		if (canvas.getCursorX() < width()) {
-			_render_state(_current_character_offset <
-						      _property.renderable_character_count ?
-					      render_state::VISIBLE_CHARACTER_CHUNK_RENDERING :
-					      render_state::SEPARATOR_RENDERING);
-		} else {
-			// Frame completed.
-			_render_state(render_state::FRAME_SETUP);
-			canvas.display();
-		}
+	// Compute x offset of the viewport according to the time.
+	const unsigned int window_offset = window_offset_from_frame_time(
+		current_time_ms, _property.rendered_width + _separator_rendered_width());
 
-		break;
-	case render_state::SEPARATOR_RENDERING:
-		_render_separator(canvas);
-
-		if (canvas.getCursorX() < width()) {
-			_render_state(render_state::VISIBLE_CHARACTER_CHUNK_RENDERING);
-		} else {
-			// Frame completed.
-			_render_state(render_state::FRAME_SETUP);
-			canvas.display();
-		}
+	// Repeat the property until the viewport is filled.
+	int16_t x = -static_cast<int16_t>(window_offset);
+	while (x < canvas.width()) {
+		x = _draw_property(canvas, x, first_page);
+		x = _draw_separator(canvas, x, first_page);
+	}
 
-		break;
+	if (_full_flush_needed) {
+		canvas.display();
+		_full_flush_needed = false;
+	} else {
+		canvas.display(first_page, first_page + page_count - 1);
 	}
 
 	damage();
@@ -193,7 +156,7 @@ void nd::scroll_screen::set_property(const __FlashStringHelper *property, bool c
 {
 	_property.flash_value = property;
 	_property.is_value_in_ram = false;
-	_property.renderable_character_count = property_renderable_character_count(property);
+	_property.rendered_width = nf::string_width(nf::large, property);
 	_closely_repeat_string = close_repeat;
 }
 
@@ -201,44 +164,46 @@ void nd::scroll_screen::set_property(const char *property, bool close_repeat) no
 {
 	_property.ram_value = property;
 	_property.is_value_in_ram = true;
-	_property.renderable_character_count = property_renderable_character_count(property);
+	_property.rendered_width = nf::string_width(nf::large, property);
 	_closely_repeat_string = close_repeat;
 }
 
 void nd::scroll_screen::focused() noexcept
 {
-	_render_state(render_state::FRAME_SETUP);
+	_full_flush_needed = true;
 	screen::focused();
 }
 
-void nd::scroll_screen::_initialize_layout(Adafruit_SSD1306& canvas) noexcept
+int16_t
+nd::scroll_screen::_draw_property(Adafruit_SSD1306& canvas, int16_t x, uint8_t page) const noexcept
 {
-	_scroll_character_width =
-		nsec::config::display::scroll_font_size * config::display::font_base_width;
-	_scroll_character_y_offset =
-		(canvas.height() -
-		 (config::display::font_base_height * nsec::config::display::scroll_font_size)) /
-		2;
-	_layout_initialized = true;
+	if (x + int16_t(_property.rendered_width) <= 0) {
+		// Entirely off-screen.
+		return x + _property.rendered_width;
+	}
+
+	return _property.is_value_in_ram ?
+		draw_visible_characters(canvas, _property.ram_value, x, page) :
+		draw_visible_characters(canvas, _property.flash_value, x, page);
 }
 
-void nd::scroll_screen::_render_separator(Adafruit_SSD1306& canvas) noexcept
+int16_t
+nd::scroll_screen::_draw_separator(Adafruit_SSD1306& canvas, int16_t x, uint8_t page) const noexcept
 {
-	if (_closely_repeat_string) {
-		canvas.setCursor(canvas.getCursorX() + repeat_separator_padding,
-				canvas.getCursorY());
-		canvas.print(as_flash_string(repeat_separator));
-		canvas.setCursor(canvas.getCursorX() + repeat_separator_padding,
-				canvas.getCursorY());
-	} else {
-		canvas.setCursor(canvas.getCursorX() + (canvas.width() / 2), canvas.getCursorY());
+	if (!_closely_repeat_string) {
+		return x + _separator_rendered_width();
 	}
+
+	x = draw_visible_characters(
+		canvas, as_flash_string(repeat_separator), x + repeat_separator_padding, page);
+	return x + repeat_separator_padding;
 }
 
 uint16_t nd::scroll_screen::_separator_rendered_width() const noexcept
 {
 	if (_closely_repeat_string) {
-		return (2 * repeat_separator_padding) + _scroll_character_width;
+		return (2 * repeat_separator_padding) +
+			nf::string_width(nf::large, as_flash_string(repeat_separator));
 	} else {
 		return width() / 2;
 	}
@@ -24,7 +24,7 @@ void nd::splash_screen::button_event(nb::id id, nb::event event) noexcept
 void nd::splash_screen::_render(scheduling::absolute_time_ms current_time_ms [[maybe_unused]],
 				Adafruit_SSD1306& canvas) noexcept
 {
-	canvas.drawBitmap(0, 0, nsec_logo_data, canvas.width(), canvas.height(), 1);
+	nsec::display::utils::draw_packed_bitmap(canvas, 0, 0, nsec_logo_data);
 }
 
 void nd::splash_screen::one_shot_timer_task::run(ns::absolute_time_ms current_time
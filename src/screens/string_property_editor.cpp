@@ -174,15 +174,20 @@ void nd::string_property_editor_screen::_render(scheduling::absolute_time_ms cur
 	}
 
 	canvas.setCursor(0, 0);
-	canvas.setTextSize(nsec::config::display::menu_font_size);
 	_draw_prompt(canvas);
 
+	// The edited property is drawn in fixed-width cells to line up with the cursor.
 	canvas.setCursor(_edit_character_x_offset, _edit_character_y_offset);
 	canvas.setTextSize(2);
-	ndu::draw_string(canvas,
-			 _property.value + _first_drawn_character,
-			 _edit_characters_per_screen,
-			 false);
+	for (uint8_t i = 0; i < _edit_characters_per_screen; i++) {
+		const auto current_char = _property.value[_first_drawn_character + i];
+
+		if (current_char == '\0') {
+			break;
+		}
+
+		canvas.write(current_char);
+	}
 
 	// Redraw highlighted character over property string
 	canvas.fillRect(
@@ -258,7 +263,6 @@ void nd::string_property_editor_screen::clean_up_property() noexcept
 
 void nd::string_property_editor_screen::_initialize_layout(Adafruit_SSD1306& canvas) noexcept
 {
-	_prompt_characters_per_screen = canvas.width() / config::display::font_base_width;
 	_edit_character_y_offset = config::display::font_base_height + (config::display::font_base_height / 2);
 	_prompt_glyph_width = config::display::font_base_width;
 	_prompt_glyph_height = config::display::font_base_height;
@@ -275,17 +279,19 @@ void nd::string_property_editor_screen::_draw_prompt(Adafruit_SSD1306& canvas) n
 {
 	switch (_prompt_cycle_state) {
 	case prompt_cycle_state::PROPERTY_PROMPT:
-		ndu::draw_string(canvas, _prompt, _prompt_characters_per_screen);
+		ndu::draw_string(canvas, nsec::display::font::small, _prompt, canvas.width());
 		break;
 	case prompt_cycle_state::HOW_TO_DELETE:
 		ndu::draw_string(canvas,
+				 nsec::display::font::small,
 				 as_flash_string(how_to_delete_prompt),
-				 _prompt_characters_per_screen);
+				 canvas.width());
 		break;
 	case prompt_cycle_state::HOW_TO_QUIT:
 		ndu::draw_string(canvas,
+				 nsec::display::font::small,
 				 as_flash_string(how_to_leave_prompt),
-				 _prompt_characters_per_screen);
+				 canvas.width());
 		break;
 	default:
 		return;
@@ -6,199 +6,139 @@
 
 #include "board.hpp"
 #include "globals.hpp"
+#include "led/interpolation.hpp"
 #include "led/strip_animator.hpp"
+#include "unique_id.hpp"
+
+#include "animation_data.hpp"
+#include "program_data.hpp"
 
 namespace nl = nsec::led;
+namespace nla = nsec::led::animation;
 namespace ns = nsec::scheduling;
 namespace ng = nsec::g;
+namespace nli = nsec::led::interpolation;
+namespace nlp = nsec::led::program;
+namespace nlpw = nsec::led::power;
 
 #define ARRAY_LENGTH(array) (sizeof(array)/sizeof(*array))
 
 namespace {
-constexpr int16_t scaling_factor = 1024;
-
-// Linear interpolation in RGB space: not terrible, not great...
-nl::strip_animator::led_color interpolate(const nl::strip_animator::keyframe& origin,
-					  const nl::strip_animator::keyframe& destination,
-					  uint16_t current_time)
+nl::strip_animator::led_color palette_color(uint8_t index)
 {
-	nl::strip_animator::led_color new_color;
-
-	if (current_time >= destination.time) {
-		return destination.color;
-	}
-
-	const int32_t numerator = (int32_t(current_time) - int32_t(origin.time)) * scaling_factor;
-	const int32_t denominator =
-		(int32_t(destination.time) - int32_t(origin.time)) * scaling_factor;
-	for (uint8_t i = 0; i < sizeof(new_color.components); i++) {
-		const int32_t origin_component = origin.color.components[i];
-		const int32_t destination_component = destination.color.components[i];
-		const int32_t total_diff = destination_component - origin_component;
-		const int32_t diff_to_apply = ((total_diff * numerator) / denominator);
-
-		new_color.components[i] = uint8_t(origin_component + diff_to_apply);
-	}
+	const auto *entry = nsec_animation_palette[index];
 
-	return new_color;
+	return { pgm_read_byte(&entry[0]), pgm_read_byte(&entry[1]), pgm_read_byte(&entry[2]) };
 }
 
-nl::strip_animator::keyframe keyframe_from_flash(const nl::strip_animator::keyframe *src_keyframe)
+nla::descriptor animation_from_flash(const nla::descriptor& animation) noexcept
 {
-	const auto r = pgm_read_byte(&src_keyframe->color.r());
-	const auto g = pgm_read_byte(&src_keyframe->color.g());
-	const auto b = pgm_read_byte(&src_keyframe->color.b());
+	nla::descriptor local_copy;
 
-	return { { r, g, b }, pgm_read_word(&src_keyframe->time) };
+	memcpy_P(&local_copy, &animation, sizeof(local_copy));
+	return local_copy;
 }
 
-} // namespace
-
-namespace keyframes {
-const nl::strip_animator::keyframe PROGMEM red_to_green_progress_bar_keyframe_template[] = {
-	// red
-	{ { 100, 20, 0 }, 0 },
-	{ { 0, 0, 0 }, nsec::config::badge::pairing_animation_time_per_led_progress_bar_ms / 2 },
-	// green <- beginning of loop
-	{ { 0, 255, 0 }, nsec::config::badge::pairing_animation_time_per_led_progress_bar_ms },
-	// dimmed green to green loop
-	{ { 48, 120, 19 },
-	  nsec::config::badge::pairing_animation_time_per_led_progress_bar_ms * 2 },
-	{ { 0, 255, 0 }, nsec::config::badge::pairing_animation_time_per_led_progress_bar_ms * 3 },
-};
+const nla::descriptor *animation_by_index(uint8_t index) noexcept
+{
+	return static_cast<const nla::descriptor *>(pgm_read_ptr(&nsec_animations[index]));
+}
 
-const nl::strip_animator::keyframe PROGMEM happy_clown_barf_keyframes[] = {
-	{ { 0, 0, 0 }, 0 },
-	{ { 161, 255, 181 }, 100 },
-	{ { 255, 128, 140 }, 200 },
-	{ { 255, 188, 110 }, 300 },
-	{ { 255, 255, 110 }, 400 },
-	{ { 110, 192, 255 }, 500 },
-	{ { 161, 255, 181 }, 600 },
+/*
+ * Gamma curve of the LEDs, (x / 255) ^ 2.6, in 0.16 fixed point. This is the
+ * curve of Adafruit_NeoPixel::gamma8() with the precision needed to scale it
+ * down to low brightness levels.
+ */
+const uint16_t PROGMEM gamma_table[] = {
+	0x0000, 0x0000, 0x0000, 0x0001, 0x0001, 0x0002, 0x0004, 0x0006,
+	0x0008, 0x000b, 0x000e, 0x0012, 0x0017, 0x001d, 0x0023, 0x0029,
+	0x0031, 0x0039, 0x0043, 0x004d, 0x0058, 0x0063, 0x0070, 0x007e,
+	0x008d, 0x009c, 0x00ad, 0x00bf, 0x00d2, 0x00e6, 0x00fb, 0x0112,
+	0x0129, 0x0142, 0x015c, 0x0177, 0x0194, 0x01b1, 0x01d0, 0x01f1,
+	0x0213, 0x0236, 0x025a, 0x0280, 0x02a8, 0x02d1, 0x02fb, 0x0327,
+	0x0355, 0x0383, 0x03b4, 0x03e6, 0x041a, 0x044f, 0x0486, 0x04bf,
+	0x04f9, 0x0535, 0x0572, 0x05b2, 0x05f3, 0x0636, 0x067a, 0x06c1,
+	0x0709, 0x0753, 0x079f, 0x07ed, 0x083d, 0x088e, 0x08e2, 0x0937,
+	0x098e, 0x09e8, 0x0a43, 0x0aa0, 0x0b00, 0x0b61, 0x0bc4, 0x0c2a,
+	0x0c91, 0x0cfb, 0x0d67, 0x0dd5, 0x0e45, 0x0eb7, 0x0f2b, 0x0fa1,
+	0x101a, 0x1095, 0x1112, 0x1192, 0x1213, 0x1297, 0x131d, 0x13a6,
+	0x1431, 0x14be, 0x154d, 0x15df, 0x1673, 0x170a, 0x17a3, 0x183e,
+	0x18dc, 0x197d, 0x1a20, 0x1ac5, 0x1b6d, 0x1c17, 0x1cc4, 0x1d73,
+	0x1e25, 0x1ed9, 0x1f90, 0x204a, 0x2106, 0x21c5, 0x2286, 0x234a,
+	0x2411, 0x24da, 0x25a6, 0x2675, 0x2747, 0x281b, 0x28f2, 0x29cb,
+	0x2aa8, 0x2b87, 0x2c69, 0x2d4e, 0x2e35, 0x2f20, 0x300d, 0x30fd,
+	0x31f0, 0x32e6, 0x33df, 0x34da, 0x35d9, 0x36da, 0x37df, 0x38e6,
+	0x39f0, 0x3afe, 0x3c0e, 0x3d21, 0x3e38, 0x3f51, 0x406d, 0x418d,
+	0x42af, 0x43d5, 0x44fd, 0x4629, 0x4758, 0x488a, 0x49bf, 0x4af7,
+	0x4c33, 0x4d71, 0x4eb3, 0x4ff8, 0x5140, 0x528b, 0x53da, 0x552c,
+	0x5681, 0x57d9, 0x5935, 0x5a94, 0x5bf6, 0x5d5b, 0x5ec4, 0x6031,
+	0x61a0, 0x6313, 0x6489, 0x6603, 0x6780, 0x6900, 0x6a84, 0x6c0b,
+	0x6d96, 0x6f24, 0x70b6, 0x724b, 0x73e3, 0x757f, 0x771f, 0x78c2,
+	0x7a69, 0x7c13, 0x7dc0, 0x7f72, 0x8126, 0x82df, 0x849b, 0x865a,
+	0x881e, 0x89e4, 0x8baf, 0x8d7d, 0x8f4f, 0x9124, 0x92fd, 0x94da,
+	0x96ba, 0x989f, 0x9a86, 0x9c72, 0x9e61, 0xa055, 0xa24b, 0xa446,
+	0xa645, 0xa847, 0xaa4d, 0xac57, 0xae64, 0xb076, 0xb28b, 0xb4a5,
+	0xb6c2, 0xb8e3, 0xbb08, 0xbd30, 0xbf5d, 0xc18e, 0xc3c2, 0xc5fb,
+	0xc837, 0xca78, 0xccbc, 0xcf04, 0xd151, 0xd3a1, 0xd5f5, 0xd84e,
+	0xdaaa, 0xdd0b, 0xdf6f, 0xe1d8, 0xe444, 0xe6b5, 0xe92a, 0xeba3,
+	0xee20, 0xf0a1, 0xf326, 0xf5b0, 0xf83d, 0xfacf, 0xfd65, 0xffff,
 };
 
-const nl::strip_animator::keyframe PROGMEM no_new_friends_keyframes[] = {
-	{ { 0, 0, 0 }, 0 },
-	{ { 255, 0, 0 }, 200 },
-	{ { 0, 0, 0 }, 400 },
-	{ { 255, 0, 0 }, 600 },
-};
+} // namespace
 
+// The keyframes of the pairing progress bar are generated from this duration.
+static_assert(nsec::config::badge::pairing_animation_time_per_led_progress_bar_ms == 1000,
+	      "Regenerate the animation data (see the animations folder)");
 
+namespace keyframes {
 namespace shooting_star {
-// Colors evoking a tungten flash
-const nl::strip_animator::keyframe PROGMEM shooting_star_tungsten_keyframes[] = {
-	{ { 0, 0, 0 }, 0 }, // black
-	{ { 255, 255, 255 }, 100 }, // white
-	{ { 180, 0, 200 }, 400 }, // violet
-	{ { 70, 0, 0 }, 900 }, // red
-	{ { 0, 0, 0 }, 1500 }, // black
-	{ { 0, 0, 0 }, 5000 }, // maintain black
-};
-
-const nl::strip_animator::keyframe PROGMEM shooting_star_2_keyframes[] = {
-	{ { 0, 255, 159 }, 0 },
-	{ { 0, 138, 198 }, 900 },
-	{ { 0, 0, 0 }, 1500 },
-	{ { 0, 0, 0 }, 5000 },
-};
-
-const nl::strip_animator::keyframe PROGMEM shooting_star_3_keyframes[] = {
-	{ { 123,179,255 }, 0 },
-	{ { 232,106,240 }, 500 },
-	{ { 158,55,159 }, 1000 },
-	{ { 0, 0, 0 }, 1300 },
-	{ { 0, 0, 0 }, 5000 },
-};
-
-const nl::strip_animator::keyframe PROGMEM shooting_star_4_keyframes[] = {
-	{ { 115,205,186 }, 0 },
-	{ { 198,240,234 }, 500 },
-	{ { 79,145,62 }, 1000 },
-	{ { 0, 0, 0 }, 1300 },
-	{ { 0, 0, 0 }, 5000 },
-};
-
-const nl::strip_animator::keyframe PROGMEM shooting_star_5_keyframes[] = {
-	{ { 255, 128, 0 }, 0 },
-	{ { 200, 128, 0 }, 600 },
-	{ { 0, 0, 0 }, 1300 },
-	{ { 0, 0, 0 }, 5000 },
-};
-
-const nl::strip_animator::keyframe PROGMEM shooting_star_6_keyframes[] = {
-	{ { 0, 255, 128 }, 0 },
-	{ { 255,255, 51 }, 500 },
-	{ { 255,153, 51 }, 1000 },
-	{ { 0, 0, 0 }, 1300 },
-	{ { 0, 0, 0 }, 5000 },
-};
-
-const nl::strip_animator::keyframe PROGMEM shooting_star_7_keyframes[] = {
-	{ { 255,0,255 }, 0 },
-	{ { 127,0,255 }, 500 },
-	{ { 0,0,32 }, 1000 },
-	{ { 0, 0, 0 }, 1300 },
-	{ { 0, 0, 0 }, 5000 },
-};
-
-const nl::strip_animator::keyframe PROGMEM shooting_star_8_keyframes[] = {
-	{ { 0, 0, 0 }, 0 },
-	{ { 255, 204, 204 }, 100 },
-	{ { 51, 153, 255 }, 400 },
-	{ { 76, 0, 153 }, 900 },
-	{ { 0, 0, 0 }, 1500 },
-	{ { 0, 0, 0 }, 5000 },
-};
-
 struct shooting_star_parameters {
 	uint8_t shooting_star_count;
 	uint16_t delay_advance_ms;
-	const nl::strip_animator::keyframe *keyframes;
-	uint8_t keyframe_count;
+	const nla::descriptor *animation;
 };
 
 const shooting_star_parameters PROGMEM params[] = {
 	// white-violet-red, slow
-	{ 1, 90, shooting_star_tungsten_keyframes, ARRAY_LENGTH(shooting_star_tungsten_keyframes) },
-	{ 2, 2*90, shooting_star_tungsten_keyframes, ARRAY_LENGTH(shooting_star_tungsten_keyframes) },
-	{ 4, 3*90, shooting_star_tungsten_keyframes, ARRAY_LENGTH(shooting_star_tungsten_keyframes) },
-	{ 8, 4*90, shooting_star_tungsten_keyframes, ARRAY_LENGTH(shooting_star_tungsten_keyframes) },
+	{ 1, 90, &nsec_animation_shooting_star_tungsten },
+	{ 2, 2*90, &nsec_animation_shooting_star_tungsten },
+	{ 4, 3*90, &nsec_animation_shooting_star_tungsten },
+	{ 8, 4*90, &nsec_animation_shooting_star_tungsten },
 	// cyan-blue, slow
-	{ 1, 90, shooting_star_2_keyframes, ARRAY_LENGTH(shooting_star_2_keyframes) },
-	{ 2, 2*90, shooting_star_2_keyframes, ARRAY_LENGTH(shooting_star_2_keyframes) },
-	{ 4, 3*90, shooting_star_2_keyframes, ARRAY_LENGTH(shooting_star_2_keyframes) },
-	{ 8, 4*90, shooting_star_2_keyframes, ARRAY_LENGTH(shooting_star_2_keyframes) },
+	{ 1, 90, &nsec_animation_shooting_star_2 },
+	{ 2, 2*90, &nsec_animation_shooting_star_2 },
+	{ 4, 3*90, &nsec_animation_shooting_star_2 },
+	{ 8, 4*90, &nsec_animation_shooting_star_2 },
 	// violet-blue, fast
-	{ 1, 40, shooting_star_3_keyframes, ARRAY_LENGTH(shooting_star_3_keyframes) },
-	{ 2, 2*40, shooting_star_3_keyframes, ARRAY_LENGTH(shooting_star_3_keyframes) },
-	{ 4, 3*40, shooting_star_3_keyframes, ARRAY_LENGTH(shooting_star_3_keyframes) },
-	{ 8, 4*40, shooting_star_3_keyframes, ARRAY_LENGTH(shooting_star_3_keyframes) },
+	{ 1, 40, &nsec_animation_shooting_star_3 },
+	{ 2, 2*40, &nsec_animation_shooting_star_3 },
+	{ 4, 3*40, &nsec_animation_shooting_star_3 },
+	{ 8, 4*40, &nsec_animation_shooting_star_3 },
 	// aqua-green , fast
-	{ 1, 40, shooting_star_4_keyframes, ARRAY_LENGTH(shooting_star_4_keyframes) },
-	{ 2, 2*40, shooting_star_4_keyframes, ARRAY_LENGTH(shooting_star_4_keyframes) },
-	{ 4, 3*40, shooting_star_4_keyframes, ARRAY_LENGTH(shooting_star_4_keyframes) },
-	{ 8, 4*40, shooting_star_4_keyframes, ARRAY_LENGTH(shooting_star_4_keyframes) },
+	{ 1, 40, &nsec_animation_shooting_star_4 },
+	{ 2, 2*40, &nsec_animation_shooting_star_4 },
+	{ 4, 3*40, &nsec_animation_shooting_star_4 },
+	{ 8, 4*40, &nsec_animation_shooting_star_4 },
 	// orange , slow
-	{ 1, 90, shooting_star_5_keyframes, ARRAY_LENGTH(shooting_star_5_keyframes) },
-	{ 2, 2*90, shooting_star_5_keyframes, ARRAY_LENGTH(shooting_star_5_keyframes) },
-	{ 4, 3*90, shooting_star_5_keyframes, ARRAY_LENGTH(shooting_star_5_keyframes) },
-	{ 8, 4*90, shooting_star_5_keyframes, ARRAY_LENGTH(shooting_star_5_keyframes) },
+	{ 1, 90, &nsec_animation_shooting_star_5 },
+	{ 2, 2*90, &nsec_animation_shooting_star_5 },
+	{ 4, 3*90, &nsec_animation_shooting_star_5 },
+	{ 8, 4*90, &nsec_animation_shooting_star_5 },
 	// green to orange , slow
-	{ 1, 90, shooting_star_6_keyframes, ARRAY_LENGTH(shooting_star_6_keyframes) },
-	{ 2, 2*90, shooting_star_6_keyframes, ARRAY_LENGTH(shooting_star_6_keyframes) },
-	{ 4, 3*90, shooting_star_6_keyframes, ARRAY_LENGTH(shooting_star_6_keyframes) },
-	{ 8, 4*90, shooting_star_6_keyframes, ARRAY_LENGTH(shooting_star_6_keyframes) },
+	{ 1, 90, &nsec_animation_shooting_star_6 },
+	{ 2, 2*90, &nsec_animation_shooting_star_6 },
+	{ 4, 3*90, &nsec_animation_shooting_star_6 },
+	{ 8, 4*90, &nsec_animation_shooting_star_6 },
 	// violet to blue , slow
-	{ 1, 90, shooting_star_7_keyframes, ARRAY_LENGTH(shooting_star_7_keyframes) },
-	{ 2, 2*90, shooting_star_7_keyframes, ARRAY_LENGTH(shooting_star_7_keyframes) },
-	{ 4, 3*90, shooting_star_7_keyframes, ARRAY_LENGTH(shooting_star_7_keyframes) },
-	{ 8, 4*90, shooting_star_7_keyframes, ARRAY_LENGTH(shooting_star_7_keyframes) },
+	{ 1, 90, &nsec_animation_shooting_star_7 },
+	{ 2, 2*90, &nsec_animation_shooting_star_7 },
+	{ 4, 3*90, &nsec_animation_shooting_star_7 },
+	{ 8, 4*90, &nsec_animation_shooting_star_7 },
 	// white to blue, slow
-	{ 1, 90, shooting_star_8_keyframes, ARRAY_LENGTH(shooting_star_8_keyframes) },
-	{ 2, 2*90, shooting_star_8_keyframes, ARRAY_LENGTH(shooting_star_8_keyframes) },
-	{ 4, 3*90, shooting_star_8_keyframes, ARRAY_LENGTH(shooting_star_8_keyframes) },
-	{ 8, 4*90, shooting_star_8_keyframes, ARRAY_LENGTH(shooting_star_8_keyframes) },
+	{ 1, 90, &nsec_animation_shooting_star_8 },
+	{ 2, 2*90, &nsec_animation_shooting_star_8 },
+	{ 4, 3*90, &nsec_animation_shooting_star_8 },
+	{ 8, 4*90, &nsec_animation_shooting_star_8 },
 };
 
 shooting_star_parameters shooting_star_parameters_from_flash(const shooting_star_parameters* params)
@@ -207,10 +147,7 @@ shooting_star_parameters shooting_star_parameters_from_flash(const shooting_star
 
 	value.shooting_star_count = pgm_read_byte(&params->shooting_star_count);
 	value.delay_advance_ms = pgm_read_word(&params->delay_advance_ms);
-
-	static_assert(sizeof(value.keyframes) == sizeof(uint16_t));
-	value.keyframes = reinterpret_cast<const nl::strip_animator::keyframe*>(pgm_read_word(&params->keyframes));
-	value.keyframe_count = pgm_read_byte(&params->keyframe_count);
+	value.animation = static_cast<const nla::descriptor *>(pgm_read_ptr(&params->animation));
 
 	return value;
 }
@@ -220,381 +157,116 @@ namespace color_cycle {
 struct color_cycle_parameters {
 	uint16_t active_pattern;
 	uint8_t cycle_offset;
-	uint8_t keyframe_count;
-	const nl::strip_animator::keyframe *keyframes;
-};
-
-// Dark wave synth
-const nl::strip_animator::keyframe PROGMEM color_cycle_1_keyframes[] = {
-	{ { 0,0,0 }, 0 },
-	{ { 255,73,219 }, 1 },
-	{ { 28,28,62 }, 1000 },
-	{ { 50,240,255 }, 2000 },
-	{ { 255,129,50 }, 3000 },
-	{ { 90,52,123 }, 4000 },
-	{ { 255,73,219 }, 5000 },
-};
-
-// red-white
-const nl::strip_animator::keyframe PROGMEM color_cycle_2_keyframes[] = {
-	{ { 0,0,0 }, 0 },
-	{ { 255,255,255 }, 1 },
-	{ { 255,0,0 }, 1000 },
-	{ { 255,255,255 }, 2000 },
-};
-
-// pastel rainbow
-const nl::strip_animator::keyframe PROGMEM color_cycle_3_keyframes[] = {
-	{ { 0,0,0 }, 0 },
-	{ { 255,179,186 }, 1 },
-	{ { 255,223,186 }, 1000 },
-	{ { 255,255,186 }, 2000 },
-	{ { 186,255,201 }, 3000 },
-	{ { 186,225,255 }, 4000 },
-	{ { 255,179,186 }, 5000 },
-};
-
-// orange breathing
-const nl::strip_animator::keyframe PROGMEM color_cycle_orange_breathing_keyframes[] = {
-	{ { 0,0,0 }, 0 },
-	{ { 153,76,0 }, 1 },
-	{ { 255,178,102 }, 2000 },
-	{ { 153,76,0 }, 4000 },
-};
-
-const nl::strip_animator::keyframe PROGMEM color_cycle_red_breathing_keyframes[] = {
-	{ { 0,0,0 }, 0 },
-	{ { 153,0,0 }, 1 },
-	{ { 255,102,102 }, 2000 },
-	{ { 153,0,0 }, 4000 },
-};
-
-const nl::strip_animator::keyframe PROGMEM color_cycle_yellow_breathing_keyframes[] = {
-	{ { 0,0,0 }, 0 },
-	{ { 153,153,0 }, 1 },
-	{ { 255,255,102 }, 2000 },
-	{ { 153,153,0 }, 4000 },
-};
-
-const nl::strip_animator::keyframe PROGMEM color_cycle_green_breathing_keyframes[] = {
-	{ { 0,0,0 }, 0 },
-	{ { 0,153,0 }, 1 },
-	{ { 102,255,102 }, 2000 },
-	{ { 0,153,0 }, 4000 },
-};
-
-const nl::strip_animator::keyframe PROGMEM color_cycle_cyan_breathing_keyframes[] = {
-	{ { 0,0,0 }, 0 },
-	{ { 0,153,153 }, 1 },
-	{ { 102,255,255 }, 2000 },
-	{ { 0,153,153 }, 4000 },
-};
-
-const nl::strip_animator::keyframe PROGMEM color_cycle_blue_breathing_keyframes[] = {
-	{ { 0,0,0 }, 0 },
-	{ { 102,102,255 }, 1 },
-	{ { 0,0,153 }, 2000 },
-	{ { 102,102,255 }, 4000 },
-};
-
-const nl::strip_animator::keyframe PROGMEM color_cycle_violet_breathing_keyframes[] = {
-	{ { 0,0,0 }, 0 },
-	{ { 76,0,153 }, 1 },
-	{ { 178,102,255 }, 2000 },
-	{ { 76,0,153 }, 4000 },
-};
-
-const nl::strip_animator::keyframe PROGMEM color_cycle_pink_breathing_keyframes[] = {
-	{ { 0,0,0 }, 0 },
-	{ { 153,0,153 }, 1 },
-	{ { 255,102,255 }, 2000 },
-	{ { 153,0,153 }, 4000 },
-};
-
-const nl::strip_animator::keyframe PROGMEM color_cycle_white_breathing_keyframes[] = {
-	{ { 0,0,0 }, 0 },
-	{ { 153,76,0 }, 1 },
-	{ { 255,178,102 }, 2000 },
-	{ { 153,76,0 }, 4000 },
-};
-
-// Magenta-blue heartbeat
-const nl::strip_animator::keyframe PROGMEM color_cycle_magenta_blue_hb_keyframes[] = {
-	{ { 0,0,0 }, 0 },
-	{ { 0,0,0 }, 1 },
-	{ { 0,0,0 }, 200 },
-	{ { 255,50,255 }, 300 },
-	{ { 20,20,20 }, 400 },
-	{ { 20,20,20 }, 500 },
-	{ { 25,25,127 }, 600 },
-	{ { 0,0,0 }, 800 },
-	{ { 0,0,0 }, 1200 },
-};
-
-const nl::strip_animator::keyframe PROGMEM color_cycle_green_pink_hb_keyframes[] = {
-	{ { 0,0,0 }, 0 },
-	{ { 0,0,0 }, 1 },
-	{ { 0,0,0 }, 200 },
-	{ { 50,200,50 }, 300 },
-	{ { 10,10,10 }, 400 },
-	{ { 10,10,10 }, 500 },
-	{ { 200,50,170 }, 600 },
-	{ { 0,0,0 }, 800 },
-	{ { 0,0,0 }, 1200 },
-};
-
-// purple-white
-const nl::strip_animator::keyframe PROGMEM color_cycle_4_keyframes[] = {
-	{ { 0,0,0 }, 0 },
-	{ { 255,255,255 }, 1 },
-	{ { 101, 78, 146 }, 1000 },
-	{ { 255,255,255 }, 2000 },
-};
-
-// yellow-white
-const nl::strip_animator::keyframe PROGMEM color_cycle_5_keyframes[] = {
-	{ { 0,0,0 }, 0 },
-	{ { 255,255,255 }, 1 },
-	{ { 249, 245, 75 }, 1000 },
-	{ { 255,255,255 }, 2000 },
-};
-
-// cyan-white
-const nl::strip_animator::keyframe PROGMEM color_cycle_6_keyframes[] = {
-	{ { 0,0,0 }, 0 },
-	{ { 255,255,255 }, 1 },
-	{ { 139, 245, 250 }, 1000 },
-	{ { 255,255,255 }, 2000 },
-};
-
-// orange-white
-const nl::strip_animator::keyframe PROGMEM color_cycle_7_keyframes[] = {
-	{ { 0,0,0 }, 0 },
-	{ { 255,255,255 }, 1 },
-	{ { 252, 115, 0 }, 1000 },
-	{ { 255,255,255 }, 2000 },
-};
-
-// lime-white
-const nl::strip_animator::keyframe PROGMEM color_cycle_8_keyframes[] = {
-	{ { 0,0,0 }, 0 },
-	{ { 255,255,255 }, 1 },
-	{ { 130, 205, 71 }, 1000 },
-	{ { 255,255,255 }, 2000 },
-};
-
-// pink-white
-const nl::strip_animator::keyframe PROGMEM color_cycle_9_keyframes[] = {
-	{ { 0,0,0 }, 0 },
-	{ { 255,255,255 }, 1 },
-	{ { 249, 0, 191 }, 1000 },
-	{ { 255,255,255 }, 2000 },
-};
-
-const nl::strip_animator::keyframe PROGMEM color_cycle_10_keyframes[] = {
-	{ { 0, 0, 0 }, 0 },
-	{ { 242, 227, 219 }, 100 },
-	{ { 65, 100, 74 }, 200 },
-	{ { 38, 58, 41 }, 300 },
-	{ { 232, 106, 51 }, 400 },
-	{ { 242, 227, 219 }, 500 },
-};
-
-const nl::strip_animator::keyframe PROGMEM color_cycle_11_keyframes[] = {
-	{ { 0, 0, 0 }, 0 },
-	{ { 255, 184, 76 }, 100 },
-	{ { 242, 102, 171 }, 200 },
-	{ { 164, 89, 209 }, 300 },
-	{ { 44, 211, 225 }, 400 },
-	{ { 255, 184, 76 }, 500 },
-};
-
-// Pride
-const nl::strip_animator::keyframe PROGMEM color_cycle_12_keyframes[] = {
-	{ { 0, 0, 0 }, 0 },
-	{ { 228, 3, 3 }, 500 },
-	{ { 228, 3, 3 }, 950 },
-	{ { 255, 140, 0 }, 1000 },
-	{ { 255, 140, 0 }, 1450 },
-	{ { 255, 237, 0 }, 1500 },
-	{ { 255, 237, 0 }, 1950 },
-	{ { 0, 128, 38 }, 2000 },
-	{ { 0, 128, 38 }, 2450 },
-	{ { 36, 64, 142 }, 2500 },
-	{ { 36, 64, 142 }, 2950 },
-	{ { 115, 41, 130 }, 3000 },
-	{ { 115, 41, 130 }, 3450 },
-	{ { 228, 3, 3 }, 3500 },
-};
-
-const nl::strip_animator::keyframe PROGMEM color_cycle_13_keyframes[] = {
-	{ { 0, 0, 0 }, 0 },
-	{ { 0, 0, 0 }, 1 },
-	{ { 21, 4, 133 }, 500 },
-	{ { 21, 4, 133 }, 1000 },
-	{ { 0, 0, 0 }, 1100 },
-	{ { 0, 0, 0 }, 1250 },
-	{ { 198, 42, 136 }, 1750 },
-	{ { 198, 42, 136 }, 2250 },
-	{ { 0, 0, 0 }, 2350 },
-	{ { 0, 0, 0 }, 2450 },
-	{ { 3, 196, 161 }, 2950 },
-	{ { 3, 196, 161 }, 3450 },
-	{ { 0, 0, 0 }, 3550 },
-	{ { 0, 0, 0 }, 3650 },
-};
-
-const nl::strip_animator::keyframe PROGMEM color_cycle_14_keyframes[] = {
-	{ { 0, 0, 0 }, 0 },
-	{ { 0, 0, 0 }, 1 },
-	{ { 31, 138, 112 }, 500 },
-	{ { 31, 138, 112 }, 1000 },
-	{ { 0, 0, 0 }, 1100 },
-	{ { 0, 0, 0 }, 1250 },
-	{ { 191, 219, 56 }, 1750 },
-	{ { 191, 219, 56 }, 2250 },
-	{ { 0, 0, 0 }, 2350 },
-	{ { 0, 0, 0 }, 2450 },
-	{ { 252, 115, 0 }, 2950 },
-	{ { 252, 115, 0 }, 3450 },
-	{ { 0, 0, 0 }, 3550 },
-	{ { 0, 0, 0 }, 3650 },
-};
-
-const nl::strip_animator::keyframe PROGMEM color_cycle_spark_1_keyframes[] = {
-	{ { 0, 0, 0 }, 0 },
-	{ { 255, 255, 255 }, 100 },
-	{ { 180, 0, 200 }, 400 },
-	{ { 70, 0, 0 }, 900 },
-	{ { 0, 0, 0 }, 1500 },
-	{ { 0, 0, 0 }, 5000 },
-};
-
-const nl::strip_animator::keyframe PROGMEM color_cycle_spark_2_keyframes[] = {
-	{ { 0, 0, 0 }, 0 },
-	{ { 230, 238, 117 }, 100 },
-	{ { 218, 73, 73 }, 400 },
-	{ { 79, 28, 76 }, 900 },
-	{ { 0, 0, 0 }, 1500 },
-	{ { 0, 0, 0 }, 5000 },
-};
-
-const nl::strip_animator::keyframe PROGMEM color_cycle_spark_3_keyframes[] = {
-	{ { 0, 0, 0 }, 0 },
-	{ { 160, 193, 184 }, 100 },
-	{ { 113, 159, 176 }, 400 },
-	{ { 53, 31, 57 }, 900 },
-	{ { 0, 0, 0 }, 1500 },
-	{ { 0, 0, 0 }, 5000 },
+	const nla::descriptor *animation;
 };
 
 const color_cycle_parameters PROGMEM params[] = {
-	{ 0xFFFF, 0, ARRAY_LENGTH(color_cycle_13_keyframes), color_cycle_13_keyframes },
-	{ 0xFFFF, 10, ARRAY_LENGTH(color_cycle_13_keyframes), color_cycle_13_keyframes },
-	{ 0b1010101010101010, 10, ARRAY_LENGTH(color_cycle_13_keyframes), color_cycle_13_keyframes },
+	{ 0xFFFF, 0, &nsec_animation_color_cycle_13 },
+	{ 0xFFFF, 10, &nsec_animation_color_cycle_13 },
+	{ 0b1010101010101010, 10, &nsec_animation_color_cycle_13 },
 
-	{ 0xFFFF, 0, ARRAY_LENGTH(color_cycle_14_keyframes), color_cycle_14_keyframes },
-	{ 0xFFFF, 10, ARRAY_LENGTH(color_cycle_14_keyframes), color_cycle_14_keyframes },
-	{ 0b1010101010101010, 10, ARRAY_LENGTH(color_cycle_14_keyframes), color_cycle_14_keyframes },
+	{ 0xFFFF, 0, &nsec_animation_color_cycle_14 },
+	{ 0xFFFF, 10, &nsec_animation_color_cycle_14 },
+	{ 0b1010101010101010, 10, &nsec_animation_color_cycle_14 },
 
-	{ 0xFFFF, 0, ARRAY_LENGTH(color_cycle_10_keyframes), color_cycle_10_keyframes },
-	{ 0xFFFF, 10, ARRAY_LENGTH(color_cycle_10_keyframes), color_cycle_10_keyframes },
-	{ 0b1010101010101010, 10, ARRAY_LENGTH(color_cycle_10_keyframes), color_cycle_10_keyframes },
+	{ 0xFFFF, 0, &nsec_animation_color_cycle_10 },
+	{ 0xFFFF, 10, &nsec_animation_color_cycle_10 },
+	{ 0b1010101010101010, 10, &nsec_animation_color_cycle_10 },
 
-	{ 0xFFFF, 0, ARRAY_LENGTH(color_cycle_11_keyframes), color_cycle_11_keyframes },
-	{ 0xFFFF, 10, ARRAY_LENGTH(color_cycle_11_keyframes), color_cycle_11_keyframes },
-	{ 0b1010101010101010, 10, ARRAY_LENGTH(color_cycle_11_keyframes), color_cycle_11_keyframes },
+	{ 0xFFFF, 0, &nsec_animation_color_cycle_11 },
+	{ 0xFFFF, 10, &nsec_animation_color_cycle_11 },
+	{ 0b1010101010101010, 10, &nsec_animation_color_cycle_11 },
 
-	{ 0xFFFF, 0, ARRAY_LENGTH(color_cycle_12_keyframes), color_cycle_12_keyframes },
-	{ 0xFFFF, 10, ARRAY_LENGTH(color_cycle_12_keyframes), color_cycle_12_keyframes },
-	{ 0b1010101010101010, 10, ARRAY_LENGTH(color_cycle_12_keyframes), color_cycle_12_keyframes },
+	{ 0xFFFF, 0, &nsec_animation_color_cycle_12 },
+	{ 0xFFFF, 10, &nsec_animation_color_cycle_12 },
+	{ 0b1010101010101010, 10, &nsec_animation_color_cycle_12 },
 
-	{ 0xFFFF, 0, ARRAY_LENGTH(color_cycle_1_keyframes), color_cycle_1_keyframes },
-	{ 0xFFFF, 10, ARRAY_LENGTH(color_cycle_1_keyframes), color_cycle_1_keyframes },
-	{ 0b1010101010101010, 10, ARRAY_LENGTH(color_cycle_1_keyframes), color_cycle_1_keyframes },
+	{ 0xFFFF, 0, &nsec_animation_color_cycle_1 },
+	{ 0xFFFF, 10, &nsec_animation_color_cycle_1 },
+	{ 0b1010101010101010, 10, &nsec_animation_color_cycle_1 },
 
-	{ 0xFFFF, 0, ARRAY_LENGTH(color_cycle_2_keyframes), color_cycle_2_keyframes },
-	{ 0xFFFF, 10, ARRAY_LENGTH(color_cycle_2_keyframes), color_cycle_2_keyframes },
-	{ 0b1010101010101010, 10, ARRAY_LENGTH(color_cycle_2_keyframes), color_cycle_2_keyframes },
+	{ 0xFFFF, 0, &nsec_animation_color_cycle_2 },
+	{ 0xFFFF, 10, &nsec_animation_color_cycle_2 },
+	{ 0b1010101010101010, 10, &nsec_animation_color_cycle_2 },
 
-	{ 0xFFFF, 0, ARRAY_LENGTH(color_cycle_3_keyframes), color_cycle_3_keyframes },
-	{ 0xFFFF, 10, ARRAY_LENGTH(color_cycle_3_keyframes), color_cycle_3_keyframes },
-	{ 0b1010101010101010, 10, ARRAY_LENGTH(color_cycle_3_keyframes), color_cycle_3_keyframes },
+	{ 0xFFFF, 0, &nsec_animation_color_cycle_3 },
+	{ 0xFFFF, 10, &nsec_animation_color_cycle_3 },
+	{ 0b1010101010101010, 10, &nsec_animation_color_cycle_3 },
 
-	{ 0xFFFF, 0, ARRAY_LENGTH(color_cycle_4_keyframes), color_cycle_4_keyframes },
-	{ 0xFFFF, 10, ARRAY_LENGTH(color_cycle_4_keyframes), color_cycle_4_keyframes },
-	{ 0b1010101010101010, 10, ARRAY_LENGTH(color_cycle_4_keyframes), color_cycle_4_keyframes },
+	{ 0xFFFF, 0, &nsec_animation_color_cycle_4 },
+	{ 0xFFFF, 10, &nsec_animation_color_cycle_4 },
+	{ 0b1010101010101010, 10, &nsec_animation_color_cycle_4 },
 
-	{ 0xFFFF, 0, ARRAY_LENGTH(color_cycle_5_keyframes), color_cycle_5_keyframes },
-	{ 0xFFFF, 10, ARRAY_LENGTH(color_cycle_5_keyframes), color_cycle_5_keyframes },
-	{ 0b1010101010101010, 10, ARRAY_LENGTH(color_cycle_5_keyframes), color_cycle_5_keyframes },
+	{ 0xFFFF, 0, &nsec_animation_color_cycle_5 },
+	{ 0xFFFF, 10, &nsec_animation_color_cycle_5 },
+	{ 0b1010101010101010, 10, &nsec_animation_color_cycle_5 },
 
-	{ 0xFFFF, 0, ARRAY_LENGTH(color_cycle_6_keyframes), color_cycle_6_keyframes },
-	{ 0xFFFF, 10, ARRAY_LENGTH(color_cycle_6_keyframes), color_cycle_6_keyframes },
-	{ 0b1010101010101010, 10, ARRAY_LENGTH(color_cycle_6_keyframes), color_cycle_6_keyframes },
+	{ 0xFFFF, 0, &nsec_animation_color_cycle_6 },
+	{ 0xFFFF, 10, &nsec_animation_color_cycle_6 },
+	{ 0b1010101010101010, 10, &nsec_animation_color_cycle_6 },
 
-	{ 0xFFFF, 0, ARRAY_LENGTH(color_cycle_7_keyframes), color_cycle_7_keyframes },
-	{ 0xFFFF, 10, ARRAY_LENGTH(color_cycle_7_keyframes), color_cycle_7_keyframes },
-	{ 0b1010101010101010, 10, ARRAY_LENGTH(color_cycle_7_keyframes), color_cycle_7_keyframes },
+	{ 0xFFFF, 0, &nsec_animation_color_cycle_7 },
+	{ 0xFFFF, 10, &nsec_animation_color_cycle_7 },
+	{ 0b1010101010101010, 10, &nsec_animation_color_cycle_7 },
 
-	{ 0xFFFF, 0, ARRAY_LENGTH(color_cycle_8_keyframes), color_cycle_8_keyframes },
-	{ 0xFFFF, 10, ARRAY_LENGTH(color_cycle_8_keyframes), color_cycle_8_keyframes },
-	{ 0b1010101010101010, 10, ARRAY_LENGTH(color_cycle_8_keyframes), color_cycle_8_keyframes },
+	{ 0xFFFF, 0, &nsec_animation_color_cycle_8 },
+	{ 0xFFFF, 10, &nsec_animation_color_cycle_8 },
+	{ 0b1010101010101010, 10, &nsec_animation_color_cycle_8 },
 
-	{ 0xFFFF, 0, ARRAY_LENGTH(color_cycle_spark_1_keyframes), color_cycle_spark_1_keyframes },
-	{ 0xFFFF, 70, ARRAY_LENGTH(color_cycle_spark_1_keyframes), color_cycle_spark_1_keyframes },
+	{ 0xFFFF, 0, &nsec_animation_color_cycle_spark_1 },
+	{ 0xFFFF, 70, &nsec_animation_color_cycle_spark_1 },
 
-	{ 0xFFFF, 0, ARRAY_LENGTH(color_cycle_spark_2_keyframes), color_cycle_spark_2_keyframes },
-	{ 0xFFFF, 70, ARRAY_LENGTH(color_cycle_spark_2_keyframes), color_cycle_spark_2_keyframes },
+	{ 0xFFFF, 0, &nsec_animation_color_cycle_spark_2 },
+	{ 0xFFFF, 70, &nsec_animation_color_cycle_spark_2 },
 
-	{ 0xFFFF, 0, ARRAY_LENGTH(color_cycle_spark_3_keyframes), color_cycle_spark_3_keyframes },
-	{ 0xFFFF, 70, ARRAY_LENGTH(color_cycle_spark_3_keyframes), color_cycle_spark_3_keyframes },
+	{ 0xFFFF, 0, &nsec_animation_color_cycle_spark_3 },
+	{ 0xFFFF, 70, &nsec_animation_color_cycle_spark_3 },
 
-	{ 0xFFFF, 0, ARRAY_LENGTH(color_cycle_9_keyframes), color_cycle_9_keyframes },
-	{ 0xFFFF, 10, ARRAY_LENGTH(color_cycle_9_keyframes), color_cycle_9_keyframes },
-	{ 0b1010101010101010, 10, ARRAY_LENGTH(color_cycle_9_keyframes), color_cycle_9_keyframes },
+	{ 0xFFFF, 0, &nsec_animation_color_cycle_9 },
+	{ 0xFFFF, 10, &nsec_animation_color_cycle_9 },
+	{ 0b1010101010101010, 10, &nsec_animation_color_cycle_9 },
 
-	{ 0xFFFF, 0, ARRAY_LENGTH(color_cycle_orange_breathing_keyframes), color_cycle_orange_breathing_keyframes },
-	{ 0xFFFF, 60, ARRAY_LENGTH(color_cycle_orange_breathing_keyframes), color_cycle_orange_breathing_keyframes },
-	{ 0b1010101010101010, 60, ARRAY_LENGTH(color_cycle_orange_breathing_keyframes), color_cycle_orange_breathing_keyframes },
+	{ 0xFFFF, 0, &nsec_animation_color_cycle_orange_breathing },
+	{ 0xFFFF, 60, &nsec_animation_color_cycle_orange_breathing },
+	{ 0b1010101010101010, 60, &nsec_animation_color_cycle_orange_breathing },
 
-	{ 0xFFFF, 0, ARRAY_LENGTH(color_cycle_red_breathing_keyframes), color_cycle_red_breathing_keyframes },
-	{ 0xFFFF, 60, ARRAY_LENGTH(color_cycle_red_breathing_keyframes), color_cycle_red_breathing_keyframes },
-	{ 0b1010101010101010, 60, ARRAY_LENGTH(color_cycle_red_breathing_keyframes), color_cycle_red_breathing_keyframes },
+	{ 0xFFFF, 0, &nsec_animation_color_cycle_red_breathing },
+	{ 0xFFFF, 60, &nsec_animation_color_cycle_red_breathing },
+	{ 0b1010101010101010, 60, &nsec_animation_color_cycle_red_breathing },
 
-	{ 0xFFFF, 0, ARRAY_LENGTH(color_cycle_yellow_breathing_keyframes), color_cycle_yellow_breathing_keyframes },
-	{ 0xFFFF, 60, ARRAY_LENGTH(color_cycle_yellow_breathing_keyframes), color_cycle_yellow_breathing_keyframes },
-	{ 0b1010101010101010, 60, ARRAY_LENGTH(color_cycle_yellow_breathing_keyframes), color_cycle_yellow_breathing_keyframes },
+	{ 0xFFFF, 0, &nsec_animation_color_cycle_yellow_breathing },
+	{ 0xFFFF, 60, &nsec_animation_color_cycle_yellow_breathing },
+	{ 0b1010101010101010, 60, &nsec_animation_color_cycle_yellow_breathing },
 
-	{ 0xFFFF, 0, ARRAY_LENGTH(color_cycle_green_breathing_keyframes), color_cycle_green_breathing_keyframes },
-	{ 0xFFFF, 60, ARRAY_LENGTH(color_cycle_green_breathing_keyframes), color_cycle_green_breathing_keyframes },
-	{ 0b1010101010101010, 60, ARRAY_LENGTH(color_cycle_green_breathing_keyframes), color_cycle_green_breathing_keyframes },
+	{ 0xFFFF, 0, &nsec_animation_color_cycle_green_breathing },
+	{ 0xFFFF, 60, &nsec_animation_color_cycle_green_breathing },
+	{ 0b1010101010101010, 60, &nsec_animation_color_cycle_green_breathing },
 
-	{ 0xFFFF, 0, ARRAY_LENGTH(color_cycle_cyan_breathing_keyframes), color_cycle_cyan_breathing_keyframes },
-	{ 0xFFFF, 60, ARRAY_LENGTH(color_cycle_cyan_breathing_keyframes), color_cycle_cyan_breathing_keyframes },
-	{ 0b1010101010101010, 60, ARRAY_LENGTH(color_cycle_cyan_breathing_keyframes), color_cycle_cyan_breathing_keyframes },
+	{ 0xFFFF, 0, &nsec_animation_color_cycle_cyan_breathing },
+	{ 0xFFFF, 60, &nsec_animation_color_cycle_cyan_breathing },
+	{ 0b1010101010101010, 60, &nsec_animation_color_cycle_cyan_breathing },
 
-	{ 0xFFFF, 0, ARRAY_LENGTH(color_cycle_blue_breathing_keyframes), color_cycle_blue_breathing_keyframes },
-	{ 0xFFFF, 60, ARRAY_LENGTH(color_cycle_blue_breathing_keyframes), color_cycle_blue_breathing_keyframes },
-	{ 0b1010101010101010, 60, ARRAY_LENGTH(color_cycle_blue_breathing_keyframes), color_cycle_blue_breathing_keyframes },
+	{ 0xFFFF, 0, &nsec_animation_color_cycle_blue_breathing },
+	{ 0xFFFF, 60, &nsec_animation_color_cycle_blue_breathing },
+	{ 0b1010101010101010, 60, &nsec_animation_color_cycle_blue_breathing },
 
-	{ 0xFFFF, 0, ARRAY_LENGTH(color_cycle_violet_breathing_keyframes), color_cycle_violet_breathing_keyframes },
-	{ 0xFFFF, 60, ARRAY_LENGTH(color_cycle_violet_breathing_keyframes), color_cycle_violet_breathing_keyframes },
-	{ 0b1010101010101010, 60, ARRAY_LENGTH(color_cycle_violet_breathing_keyframes), color_cycle_violet_breathing_keyframes },
+	{ 0xFFFF, 0, &nsec_animation_color_cycle_violet_breathing },
+	{ 0xFFFF, 60, &nsec_animation_color_cycle_violet_breathing },
+	{ 0b1010101010101010, 60, &nsec_animation_color_cycle_violet_breathing },
 
-	{ 0xFFFF, 0, ARRAY_LENGTH(color_cycle_pink_breathing_keyframes), color_cycle_pink_breathing_keyframes },
-	{ 0xFFFF, 60, ARRAY_LENGTH(color_cycle_pink_breathing_keyframes), color_cycle_pink_breathing_keyframes },
-	{ 0b1010101010101010, 60, ARRAY_LENGTH(color_cycle_pink_breathing_keyframes), color_cycle_pink_breathing_keyframes },
+	{ 0xFFFF, 0, &nsec_animation_color_cycle_pink_breathing },
+	{ 0xFFFF, 60, &nsec_animation_color_cycle_pink_breathing },
+	{ 0b1010101010101010, 60, &nsec_animation_color_cycle_pink_breathing },
 
-	{ 0xFFFF, 0, ARRAY_LENGTH(color_cycle_white_breathing_keyframes), color_cycle_white_breathing_keyframes },
-	{ 0xFFFF, 60, ARRAY_LENGTH(color_cycle_white_breathing_keyframes), color_cycle_white_breathing_keyframes },
-	{ 0b1010101010101010, 60, ARRAY_LENGTH(color_cycle_white_breathing_keyframes), color_cycle_white_breathing_keyframes },
+	{ 0xFFFF, 0, &nsec_animation_color_cycle_white_breathing },
+	{ 0xFFFF, 60, &nsec_animation_color_cycle_white_breathing },
+	{ 0b1010101010101010, 60, &nsec_animation_color_cycle_white_breathing },
 
-	{ 0xFFFF, 0, ARRAY_LENGTH(color_cycle_magenta_blue_hb_keyframes), color_cycle_magenta_blue_hb_keyframes },
-	{ 0b1010101010101010, 0, ARRAY_LENGTH(color_cycle_magenta_blue_hb_keyframes), color_cycle_magenta_blue_hb_keyframes },
+	{ 0xFFFF, 0, &nsec_animation_color_cycle_magenta_blue_hb },
+	{ 0b1010101010101010, 0, &nsec_animation_color_cycle_magenta_blue_hb },
 
-	{ 0xFFFF, 0, ARRAY_LENGTH(color_cycle_green_pink_hb_keyframes), color_cycle_green_pink_hb_keyframes },
-	{ 0b1010101010101010, 0, ARRAY_LENGTH(color_cycle_green_pink_hb_keyframes), color_cycle_green_pink_hb_keyframes },
+	{ 0xFFFF, 0, &nsec_animation_color_cycle_green_pink_hb },
+	{ 0b1010101010101010, 0, &nsec_animation_color_cycle_green_pink_hb },
 };
 
 color_cycle_parameters color_cycle_parameters_from_flash(const color_cycle_parameters *params)
@@ -603,16 +275,43 @@ color_cycle_parameters color_cycle_parameters_from_flash(const color_cycle_param
 
 	value.active_pattern = pgm_read_word(&params->active_pattern);
 	value.cycle_offset = pgm_read_byte(&params->cycle_offset);
-	static_assert(sizeof(value.keyframes) == sizeof(uint16_t));
-	value.keyframes = reinterpret_cast<const nl::strip_animator::keyframe *>(
-		pgm_read_word(&params->keyframes));
-	value.keyframe_count = pgm_read_byte(&params->keyframe_count);
+	value.animation = static_cast<const nla::descriptor *>(pgm_read_ptr(&params->animation));
 
 	return value;
 }
 
 } // namespace color_cycle
 
+namespace sparks {
+struct sparks_parameters {
+	uint8_t spark_count;
+	uint16_t spawn_interval_ms;
+	const nla::descriptor *animation;
+};
+
+const sparks_parameters PROGMEM params[] = {
+	{ 1, 400, &nsec_animation_color_cycle_spark_1 },
+	{ 2, 300, &nsec_animation_color_cycle_spark_1 },
+	{ 4, 250, &nsec_animation_color_cycle_spark_1 },
+	{ 1, 400, &nsec_animation_color_cycle_spark_2 },
+	{ 2, 300, &nsec_animation_color_cycle_spark_2 },
+	{ 4, 250, &nsec_animation_color_cycle_spark_2 },
+	{ 1, 400, &nsec_animation_color_cycle_spark_3 },
+	{ 2, 300, &nsec_animation_color_cycle_spark_3 },
+	{ 4, 250, &nsec_animation_color_cycle_spark_3 },
+};
+
+sparks_parameters sparks_parameters_from_flash(const sparks_parameters *params)
+{
+	sparks_parameters value;
+
+	value.spark_count = pgm_read_byte(&params->spark_count);
+	value.spawn_interval_ms = pgm_read_word(&params->spawn_interval_ms);
+	value.animation = static_cast<const nla::descriptor *>(pgm_read_ptr(&params->animation));
+
+	return value;
+}
+} // namespace sparks
 
 } // namespace keyframes
 
@@ -620,12 +319,65 @@ nl::strip_animator::strip_animator() noexcept :
 	ns::periodic_task(100) /* Set by the various animations. */,
 	_pixels(NUMPIXELS, P_NEOP, NEO_GRB + NEO_KHZ800)
 {
+	memset(_keyframe_cache.indices, 0xff, sizeof(_keyframe_cache.indices));
+	_keyframe_cache.hits = 0;
+	_keyframe_cache.misses = 0;
+	// Stagger the LEDs' errors so they don't all step up on the same frame.
+	for (uint8_t i = 0; i < sizeof(_dithering_error); i++) {
+		const uint8_t even_led_id = i * 2 / 3;
+		const uint8_t odd_led_id = (i * 2 + 1) / 3;
+
+		_dithering_error[i] = ((even_led_id * 5) & 0xf) | (((odd_led_id * 5) & 0xf) << 4);
+	}
+	// Make sure the first frame reaches the LEDs.
+	_frame_changed = true;
+	_frame_deferred = false;
+	_skipped_frame_count = 0;
+	_emitted_frame_count = 0;
+	_deferred_frame_count = 0;
+	_forced_frame_count = 0;
+	_power_limited_frame_count = 0;
+	_power_scale = nlpw::unity_scale;
+	_stale_leds = 0;
+	_random_state = 1;
+	// Layers are hidden until an animation is set.
+	memset(_layers, 0, sizeof(_layers));
+
+	_select_layer(_base_layer);
+	_idle_animation_id = 0xff;
+	// Alone until paired, on our own clock.
+	_network_time_offset_ms = 0;
+	_peer_id = 0;
+	_peer_count = 1;
 	ng::the_scheduler.schedule_task(*this);
 }
 
 void nl::strip_animator::setup() noexcept
 {
 	_pixels.begin();
+
+	// Badges showing the same animation shouldn't sparkle in unison.
+	for (uint8_t i = 0; i < UniqueIDsize; i++) {
+		_random_state = (_random_state << 5) + _random_state + UniqueID[i];
+	}
+
+	if (!_random_state) {
+		_random_state = 1;
+	}
+}
+
+uint16_t nl::strip_animator::_random() noexcept
+{
+	_random_state ^= _random_state << 7;
+	_random_state ^= _random_state >> 9;
+	_random_state ^= _random_state << 8;
+	return _random_state;
+}
+
+uint16_t nl::strip_animator::_random(uint16_t bound) noexcept
+{
+	// Scale rather than divide, the AVR has no divider.
+	return (uint32_t(_random()) * bound) >> 16;
 }
 
 uint8_t nl::strip_animator::_get_keyframe_index(const indice_storage_element *indices,
@@ -649,130 +401,567 @@ void nl::strip_animator::_set_keyframe_index(indice_storage_element *indices,
 	}
 }
 
-void nl::strip_animator::_keyframe_animation_tick(
-	const scheduling::absolute_time_ms& current_time_ms) noexcept
+void nl::strip_animator::_layer_tick() noexcept
 {
-	// Animation specific setup
-	switch (_config.keyframed._animation) {
+	switch (_layer->config._animation) {
 	case keyframed_animation::SHOOTING_STAR:
-		if (_state.keyframed.shooting_star.ticks_in_position ==
-		    _config.keyframed.shooting_star.ticks_before_advance) {
-			_state.keyframed.shooting_star.ticks_in_position = 0;
-			// Stored on 4 bits, wraps around at 15.
-			_state.keyframed.shooting_star.position++;
-
-			const auto led_interval = 16 / _config.keyframed.shooting_star.star_count;
-			for (uint8_t i = 0; i < _config.keyframed.shooting_star.star_count; i++) {
-				const auto position = (_state.keyframed.shooting_star.position +
-						       (led_interval * i)) %
-					16;
-
-				_set_keyframe_index(
-					_state.keyframed.origin_keyframe_index, position, 0);
-				_set_keyframe_index(
-					_state.keyframed.destination_keyframe_index, position, 0);
-
-				_state.keyframed.ticks_since_start_of_animation[position] = 0;
-				_config.keyframed.active |= 1 << position;
+	{
+		auto& last_advance_time_ms = _layer->state.shooting_star.last_advance_time_ms;
+		const uint16_t interval_ms = _layer->config.shooting_star.advance_interval_ms;
+
+		// Signed, the network time may move back to before the last advance.
+		if (int16_t(_time_ms - last_advance_time_ms) >= int16_t(interval_ms)) {
+			/*
+			 * Stars are evenly spaced along the LEDs of the chain and advance
+			 * with the network time, so all the peers agree on their positions.
+			 * A late tick skips an LED rather than racing to catch up.
+			 */
+			const uint32_t step = _network_time_ms / interval_ms;
+			const uint16_t star_spacing =
+				16 * _peer_count / _layer->config.shooting_star.star_count;
+			const uint16_t first_led_spacing = (16 * _peer_id) % star_spacing;
+
+			last_advance_time_ms = step * interval_ms;
+			for (uint16_t led_id =
+				     (step % star_spacing + star_spacing - first_led_spacing) %
+				     star_spacing;
+			     led_id < 16;
+			     led_id += star_spacing) {
+				_set_active_leds(_layer->config.active | (1 << led_id));
+				_set_led_time(led_id, 0);
 			}
 		}
 
-		_state.keyframed.shooting_star.ticks_in_position++;
+		break;
+	}
+	case keyframed_animation::SPARKS:
+	{
+		const uint16_t interval_ms = _layer->config.sparks.spawn_interval_ms;
+
+		for (uint8_t i = 0; i < _layer->config.sparks.spark_count; i++) {
+			auto& next_spawn_time_ms = _layer->state.sparks.next_spawn_time_ms[i];
+
+			if (int16_t(_time_ms - next_spawn_time_ms) < 0) {
+				continue;
+			}
+
+			// Light the first idle LED from a random one, sparks don't restart.
+			if (_layer->config.active != 0xffff) {
+				uint8_t led_id = _random(16);
+
+				while ((_layer->config.active >> led_id) & 1) {
+					led_id = (led_id + 1) & 0xf;
+				}
+
+				_set_active_leds(_layer->config.active | (1 << led_id));
+				_set_led_time(led_id, 0);
+			}
+
+			// Scheduled from now so a late tick doesn't cause a burst of sparks.
+			next_spawn_time_ms = _time_ms + interval_ms / 2 + _random(interval_ms);
+		}
+
+		break;
+	}
+	case keyframed_animation::PROGRAM:
+		_program_tick();
 		break;
 	default:
 		break;
 	}
+}
 
-	_pixels.setBrightness(_config.keyframed.brightness);
+nl::strip_animator::led_color nl::strip_animator::_layer_led_color(uint8_t led_id) noexcept
+{
+	auto& led_time_ms = _layer->state.led_time_ms[led_id];
+	uint8_t origin_keyframe_index =
+		_get_keyframe_index(_layer->state.origin_keyframe_index, led_id);
+	uint8_t destination_keyframe_index =
+		_get_keyframe_index(_layer->state.destination_keyframe_index, led_id);
+
+	if (!((_layer->config.active >> led_id) & 1)) {
+		// Inactive, repeat the origin keyframe.
+		return _keyframe(origin_keyframe_index).color;
+	}
 
-	for (uint8_t i = 0; i < 16; i++) {
-		const auto origin_keyframe_index =
-			_get_keyframe_index(_state.keyframed.origin_keyframe_index, i);
-		const auto destination_keyframe_index =
-			_get_keyframe_index(_state.keyframed.destination_keyframe_index, i);
-
-		const auto origin_keyframe =
-			keyframe_from_flash(&_config.keyframed.keyframes[origin_keyframe_index]);
-		const bool led_animation_is_active = (_config.keyframed.active >> i) & 1;
-
-		if (!led_animation_is_active) {
-			// Inactive, repeat the origin keyframe.
-			_pixels.setPixelColor(i,
-					      origin_keyframe.color.r(),
-					      origin_keyframe.color.g(),
-					      origin_keyframe.color.b());
-			continue;
+	uint16_t time = _time_ms - led_time_ms;
+	auto destination_keyframe = _keyframe(destination_keyframe_index);
+
+	if (time >= destination_keyframe.time) {
+		bool finished = false;
+		const uint8_t last_keyframe_index = _layer->config.keyframe_count - 1;
+		const uint8_t loop_point_index = _layer->config.loop_point_index;
+
+		// Skip all the segments that ended since the last tick.
+		do {
+			if (destination_keyframe_index < last_keyframe_index) {
+				origin_keyframe_index = destination_keyframe_index++;
+			} else {
+				const uint16_t loop_time = _keyframe(loop_point_index).time;
+				const uint16_t end_time = destination_keyframe.time;
+
+				if (loop_time == end_time) {
+					// Nothing to loop over, hold the last keyframe.
+					origin_keyframe_index = destination_keyframe_index;
+					time = end_time;
+					finished = true;
+					break;
+				}
+
+				// Move back in the loop, skipping whole loops after a pause.
+				time = loop_time + (time - loop_time) % (end_time - loop_time);
+				origin_keyframe_index = loop_point_index;
+				destination_keyframe_index = loop_point_index + 1;
+			}
+
+			destination_keyframe = _keyframe(destination_keyframe_index);
+		} while (time >= destination_keyframe.time);
+
+		if (finished) {
+			// Stop evaluating the LED, inactive LEDs hold their animation time.
+			_layer->config.active &= ~(1 << led_id);
+			led_time_ms = time;
+		} else {
+			led_time_ms = _time_ms - time;
 		}
 
-		const auto time_since_animation_start =
-			_state.keyframed.ticks_since_start_of_animation[i] * period_ms();
+		_set_keyframe_index(
+			_layer->state.origin_keyframe_index, led_id, origin_keyframe_index);
+		_set_keyframe_index(_layer->state.destination_keyframe_index,
+				    led_id,
+				    destination_keyframe_index);
+	}
+
+	if (time >= destination_keyframe.time) {
+		return destination_keyframe.color;
+	}
+
+	const auto destination_slot = _keyframe_slot(destination_keyframe_index);
+	const auto origin_slot = _keyframe_slot(origin_keyframe_index);
+	const auto& origin_keyframe = _keyframe_cache.keyframes[origin_slot];
+	const auto phase = nli::phase_at(time - origin_keyframe.time,
+					 _keyframe_cache.segment_rates[destination_slot]);
+
+	if (_layer->config.interpolation_space == nla::color_space::HSV) {
+		const auto color = nli::rgb(nli::hsv(_keyframe_cache.hsv_colors[origin_slot],
+						     _keyframe_cache.hsv_colors[destination_slot],
+						     phase));
+
+		return { color.red, color.green, color.blue };
+	}
+
+	led_color new_color;
+
+	for (uint8_t component = 0; component < sizeof(new_color.components); component++) {
+		new_color.components[component] =
+			nli::component(origin_keyframe.color.components[component],
+				       destination_keyframe.color.components[component],
+				       phase);
+	}
+
+	return new_color;
+}
+
+uint16_t nl::strip_animator::_loop_time(uint32_t time_ms) noexcept
+{
+	const uint16_t loop_time = _keyframe(_layer->config.loop_point_index).time;
+	const uint16_t end_time = _keyframe(_layer->config.keyframe_count - 1).time;
+
+	if (time_ms < end_time) {
+		return time_ms;
+	}
+
+	if (loop_time == end_time) {
+		return end_time;
+	}
+
+	return loop_time + (time_ms - loop_time) % (end_time - loop_time);
+}
+
+void nl::strip_animator::_set_led_time(uint8_t led_id, uint16_t time_ms) noexcept
+{
+	const bool is_active = (_layer->config.active >> led_id) & 1;
 
-		if (_state.keyframed.ticks_since_start_of_animation[i] != 255) {
-			// Saturate counter.
-			_state.keyframed.ticks_since_start_of_animation[i]++;
+	// The LED's next evaluation moves it to the segment it is in.
+	_layer->state.led_time_ms[led_id] = is_active ? _time_ms - time_ms : time_ms;
+	_set_keyframe_index(_layer->state.origin_keyframe_index, led_id, 0);
+	_set_keyframe_index(_layer->state.destination_keyframe_index, led_id, 0);
+	_stale_leds |= 1 << led_id;
+}
+
+void nl::strip_animator::_set_active_leds(uint16_t active) noexcept
+{
+	const uint16_t toggled_leds = _layer->config.active ^ active;
+
+	// A start time and an animation time convert to each other the same way.
+	for (uint8_t led_id = 0; led_id < 16; led_id++) {
+		if ((toggled_leds >> led_id) & 1) {
+			auto& time_ms = _layer->state.led_time_ms[led_id];
+
+			time_ms = _time_ms - time_ms;
 		}
+	}
 
-		// Interpolate to find the current color.
-		const auto destination_keyframe = keyframe_from_flash(
-			&_config.keyframed.keyframes[destination_keyframe_index]);
+	_layer->config.active = active;
+	_stale_leds |= toggled_leds;
+}
 
-		// destination_keyframe.color.log(F("destination keyframe: "));
+void nl::strip_animator::_program_tick() noexcept
+{
+	auto& vm = _layer->state.program;
+	const uint8_t *const bytecode = _layer->config.program.bytecode;
 
-		const auto new_color = interpolate(origin_keyframe,
-						   destination_keyframe,
-						   uint16_t(time_since_animation_start));
-		// new_color.log(F("interpolated color: "));
+	if (vm.fade_ticks_left) {
+		auto& brightness = _layer->config.brightness;
 
-		_pixels.setPixelColor(i,
-				      _pixels.gamma8(new_color.r()),
-				      _pixels.gamma8(new_color.g()),
-				      _pixels.gamma8(new_color.b()));
+		brightness += (int16_t(vm.fade_target) - brightness) / vm.fade_ticks_left;
+		vm.fade_ticks_left--;
+	}
 
-		// Advance keyframes if needed.
-		if (time_since_animation_start < destination_keyframe.time) {
-			continue;
+	if (vm.ticks_to_wait && --vm.ticks_to_wait) {
+		return;
+	}
+
+	// Bound the time spent per tick; a busy program resumes on the next tick.
+	for (uint8_t budget = nsec::config::led::program_instruction_budget; budget; budget--) {
+		const uint8_t opcode = pgm_read_byte(&bytecode[vm.pc]);
+		const uint8_t *const operands = &bytecode[vm.pc + 1];
+		const auto operation = nlp::opcode_operation(opcode);
+		auto& reg = vm.registers[nlp::opcode_register(opcode)];
+		const uint8_t led_id = reg & 0xf;
+
+		vm.pc += 1 + nlp::operand_size(operation);
+
+		switch (operation) {
+		case nlp::operation::END:
+			// Stay on the END instruction.
+			vm.pc--;
+			return;
+		case nlp::operation::WAIT:
+			vm.ticks_to_wait = pgm_read_byte(&operands[0]);
+			if (vm.ticks_to_wait) {
+				return;
+			}
+
+			break;
+		case nlp::operation::LOOP:
+		{
+			auto& loop = vm.loops[vm.loop_depth++];
+
+			loop.start_pc = vm.pc;
+			loop.iterations_left = pgm_read_byte(&operands[0]);
+			break;
 		}
+		case nlp::operation::NEXT:
+		{
+			auto& loop = vm.loops[vm.loop_depth - 1];
+
+			if (loop.iterations_left == 0 || --loop.iterations_left != 0) {
+				vm.pc = loop.start_pc;
+			} else {
+				vm.loop_depth--;
+			}
 
-		uint8_t new_origin_keyframe_index = destination_keyframe_index;
-		uint8_t new_destination_keyframe_index = destination_keyframe_index + 1;
-		if (new_destination_keyframe_index >= _config.keyframed.keyframe_count) {
-			// Loop back to the configured loop point. Move the current animation time
-			// in the past.
-			new_origin_keyframe_index = _config.keyframed.loop_point_index;
-			new_destination_keyframe_index = min(new_origin_keyframe_index + 1,
-							     _config.keyframed.keyframe_count - 1);
-			// Round up to make sure the time isn't _before_ the origin keyframe.
-			_state.keyframed.ticks_since_start_of_animation[i] =
-				((keyframe_from_flash(
-					  &_config.keyframed.keyframes[new_origin_keyframe_index])
-					  .time +
-				  (period_ms() - 1)) /
-				 period_ms());
-		} else {
-			new_origin_keyframe_index = destination_keyframe_index;
-			new_destination_keyframe_index = destination_keyframe_index + 1;
+			break;
+		}
+		case nlp::operation::SET:
+			reg = pgm_read_byte(&operands[0]);
+			break;
+		case nlp::operation::ADD:
+			reg += pgm_read_byte(&operands[0]);
+			break;
+		case nlp::operation::RANDOM:
+		{
+			const uint8_t bound = pgm_read_byte(&operands[0]);
+
+			reg = _random(bound ? bound : 256);
+			break;
 		}
+		case nlp::operation::START:
+			_set_active_leds(_layer->config.active | (1 << led_id));
+			_set_led_time(led_id, 0);
+			break;
+		case nlp::operation::STOP:
+			_set_active_leds(_layer->config.active & ~(1 << led_id));
+			break;
+		case nlp::operation::PHASE:
+			_set_led_time(led_id,
+				      pgm_read_byte(&operands[0]) * _layer->config.period_ms);
+			break;
+		case nlp::operation::SPREAD:
+		{
+			const uint8_t ticks_between_leds = pgm_read_byte(&operands[0]);
+
+			for (uint8_t i = 0; i < 16; i++) {
+				_set_led_time(i, i * ticks_between_leds * _layer->config.period_ms);
+			}
 
-		_set_keyframe_index(
-			_state.keyframed.origin_keyframe_index, i, new_origin_keyframe_index);
-		_set_keyframe_index(_state.keyframed.destination_keyframe_index,
-				    i,
-				    new_destination_keyframe_index);
+			break;
+		}
+		case nlp::operation::ACTIVATE:
+			_set_active_leds(pgm_read_word(&operands[0]));
+			break;
+		case nlp::operation::KEYFRAMES:
+		{
+			const auto *animation = animation_by_index(pgm_read_byte(&operands[0]));
+			const uint8_t range = pgm_read_byte(&operands[1]);
+
+			_set_keyframe_range(*animation, range >> 4, range & 0xf);
+			_layer->config.loop_point_index = pgm_read_byte(&operands[2]);
+			for (uint8_t i = 0; i < 16; i++) {
+				_set_led_time(i, 0);
+			}
+
+			break;
+		}
+		case nlp::operation::BRIGHTNESS:
+			_layer->config.brightness = pgm_read_byte(&operands[0]);
+			vm.fade_ticks_left = 0;
+			break;
+		case nlp::operation::FADE:
+			vm.fade_target = pgm_read_byte(&operands[0]);
+			vm.fade_ticks_left = pgm_read_byte(&operands[1]);
+			break;
+		case nlp::operation::PERIOD:
+			_set_period(pgm_read_byte(&operands[0]));
+			break;
+		}
+	}
+}
+
+void nl::strip_animator::_render_layers() noexcept
+{
+	// LEDs of each layer that aren't covered by a layer above it.
+	uint16_t visible_leds[_layer_count];
+	uint16_t hidden_leds = 0;
+
+	for (uint8_t layer_id = _layer_count; layer_id-- > 0;) {
+		const auto mask = _layers[layer_id].config.mask;
+
+		visible_leds[layer_id] = mask & ~hidden_leds;
+		hidden_leds |= mask;
+	}
+
+	if (!hidden_leds) {
+		// Nothing to show yet.
+		return;
+	}
+
+	for (uint8_t layer_id = 0; layer_id < _layer_count; layer_id++) {
+		if (visible_leds[layer_id]) {
+			_select_layer(layer_id);
+			_layer_tick();
+		}
+	}
+
+	const uint16_t stale_leds = _stale_leds;
+
+	_stale_leds = 0;
+	for (uint8_t layer_id = 0; layer_id < _layer_count; layer_id++) {
+		auto& layer = _layers[layer_id];
+		// Each layer sets the brightness of its LEDs, within the power budget.
+		const uint8_t brightness = (uint16_t(layer.config.brightness) * _power_scale) >> 8;
+		// Sparse animations only cost their active LEDs.
+		uint16_t updated_leds = visible_leds[layer_id] & (stale_leds | layer.config.active);
+
+		if (layer.state.output_brightness != brightness) {
+			// Pixels are rescaled as they are set below.
+			layer.state.output_brightness = brightness;
+			updated_leds = visible_leds[layer_id];
+		}
+
+		_select_layer(layer_id);
+		for (uint8_t led_id = 0; updated_leds; led_id++, updated_leds >>= 1) {
+			if (updated_leds & 1) {
+				_set_pixel_color(led_id, _layer_led_color(led_id), brightness);
+			}
+		}
+	}
+}
+
+void nl::strip_animator::_select_layer(uint8_t layer_id) noexcept
+{
+	_layer = &_layers[layer_id];
+	_layer_id = layer_id;
+}
+
+void nl::strip_animator::_set_layer_mask(uint16_t mask) noexcept
+{
+	_layer->config.mask = mask;
+	_stale_leds = 0xffff;
+	_update_period();
+}
+
+void nl::strip_animator::_set_period(uint8_t period) noexcept
+{
+	_layer->config.period_ms = period;
+	_update_period();
+}
+
+void nl::strip_animator::_update_period() noexcept
+{
+	/*
+	 * Animations follow the clock, the period only sets the frame rate. Programs
+	 * count ticks, so they run at the top layer's pace while it is visible.
+	 */
+	for (uint8_t layer_id = _layer_count; layer_id-- > 0;) {
+		const auto& config = _layers[layer_id].config;
+
+		if (config.mask && config.period_ms) {
+			period_ms(config.period_ms);
+			return;
+		}
 	}
 }
 
 void nl::strip_animator::run(scheduling::absolute_time_ms current_time_ms) noexcept
 {
-	switch (_current_animation_type) {
-	case animation_type::KEYFRAMED:
-		_keyframe_animation_tick(current_time_ms);
-		break;
-	default:
-		break;
+	_network_time_ms = current_time_ms + _network_time_offset_ms;
+	_time_ms = _network_time_ms;
+	_render_layers();
+	_limit_power();
+
+	/*
+	 * Send the updated pixel colors to the hardware. show() disables interrupts
+	 * for the duration of the transfer, which stalls millis() and corrupts
+	 * serial reception; skip it when no pixel changed.
+	 */
+	if (!_frame_changed) {
+		_skipped_frame_count++;
+		return;
 	}
 
-	// Send the updated pixel colors to the hardware.
+	/*
+	 * Hold the frame while a peer may be transmitting; the network handler flushes
+	 * it as soon as it acknowledges a message.
+	 */
+	if (nsec::config::led::defer_output_to_quiet_line &&
+	    !ng::the_badge.is_network_line_quiet()) {
+		if (!_frame_deferred) {
+			_frame_deferred = true;
+			_deferral_start_time_ms = current_time_ms;
+		}
+
+		if (current_time_ms - _deferral_start_time_ms <
+		    nsec::config::led::max_output_deferral_ms) {
+			_deferred_frame_count++;
+			return;
+		}
+
+		_forced_frame_count++;
+	}
+
+	_show();
+}
+
+void nl::strip_animator::_limit_power() noexcept
+{
+	uint8_t *const pixels = _pixels.getPixels();
+	uint16_t component_sum = 0;
+
+	for (uint8_t i = 0; i < NUMPIXELS * 3; i++) {
+		component_sum += pixels[i];
+	}
+
+	constexpr uint16_t idle_current_ma = NUMPIXELS * nsec::config::led::idle_current_ma;
+	static_assert(nsec::config::led::power_budget_ma > idle_current_ma,
+		      "The power budget must cover the LEDs' idle current");
+	// Left to the pixel components.
+	constexpr uint16_t budget_ma = nsec::config::led::power_budget_ma - idle_current_ma;
+	const uint16_t frame_current_ma = nlpw::components_current_ma(
+		component_sum, nsec::config::led::component_current_ma);
+	// Current the frame would draw at the animation's brightness.
+	const uint16_t unscaled_current_ma =
+		min(uint32_t(frame_current_ma) * nlpw::unity_scale / _power_scale, uint32_t(0xffff));
+	const auto target_scale = nlpw::limit_scale(unscaled_current_ma, budget_ma);
+
+	if (target_scale < _power_scale) {
+		// Output is linear in the pixel values, after gamma correction.
+		const uint16_t frame_scale =
+			uint32_t(target_scale) * nlpw::unity_scale / _power_scale;
+
+		for (uint8_t i = 0; i < NUMPIXELS * 3; i++) {
+			pixels[i] = (pixels[i] * frame_scale) >> 8;
+		}
+
+		_power_scale = target_scale;
+		_frame_changed = true;
+	} else if (_power_scale < nlpw::unity_scale) {
+		// Recover gradually, and short of the budget so the scale doesn't pump.
+		const uint16_t recovery_budget_ma = budget_ma -
+			(budget_ma >> nsec::config::led::power_limit_recovery_margin_shift);
+		const auto recovery_scale =
+			nlpw::limit_scale(unscaled_current_ma, recovery_budget_ma);
+
+		if (recovery_scale > _power_scale) {
+			const uint16_t step = nsec::config::led::power_limit_release_step;
+
+			_power_scale = min(recovery_scale, _power_scale + step);
+		}
+	}
+
+	if (_power_scale < nlpw::unity_scale) {
+		_power_limited_frame_count++;
+	}
+}
+
+void nl::strip_animator::flush_deferred_frame() noexcept
+{
+	// Our acknowledgement may still be going out, in which case the next tick sends the frame.
+	if (_frame_deferred && ng::the_badge.is_network_line_quiet()) {
+		_show();
+	}
+}
+
+void nl::strip_animator::_show() noexcept
+{
 	_pixels.show();
+	_frame_changed = false;
+	_frame_deferred = false;
+	_emitted_frame_count++;
+}
+
+void nl::strip_animator::_set_pixel_color(uint8_t led_id,
+					  const led_color& color,
+					  uint8_t brightness) noexcept
+{
+	// led_color components are in the device's pixel order (GRB).
+	uint8_t *const pixel = &_pixels.getPixels()[led_id * 3];
+
+	for (uint8_t i = 0; i < sizeof(color.components); i++) {
+		const uint32_t gamma = pgm_read_word(&gamma_table[color.components[i]]);
+		uint8_t value;
+
+		if (!nsec::config::led::temporal_dithering) {
+			// Round to nearest to keep the lowest levels of dim fades distinct.
+			value = (gamma * brightness + 0x8000) >> 16;
+		} else {
+			// 8.4 fixed point, full scale maps to 255.0.
+			const uint16_t fixed_value = (gamma * brightness + 0x800) >> 12;
+			const uint8_t error_index = led_id * 3 + i;
+			const uint8_t error_shift = (error_index & 1) << 2;
+			auto& error_pair = _dithering_error[error_index >> 1];
+			uint8_t error = ((error_pair >> error_shift) & 0xf) + (fixed_value & 0xf);
+
+			value = fixed_value >> 4;
+			if (error >= 16) {
+				// Carry the accumulated fraction into this frame.
+				error -= 16;
+				value++;
+			}
+
+			error_pair = (error_pair & ~(0xf << error_shift)) | (error << error_shift);
+			if (fixed_value & 0xf) {
+				// Keep dithering the LED while its color holds.
+				_stale_leds |= 1 << led_id;
+			}
+		}
+
+		if (pixel[i] != value) {
+			pixel[i] = value;
+			_frame_changed = true;
+		}
+	}
 }
 
 nl::strip_animator::led_color nl::strip_animator::_color(uint8_t led_id) const noexcept
@@ -782,14 +971,110 @@ nl::strip_animator::led_color nl::strip_animator::_color(uint8_t led_id) const n
 
 void nl::strip_animator::set_idle_animation(uint8_t id) noexcept
 {
+	// Status overlays end when the badge goes back to idle.
+	_select_layer(_overlay_layer);
+	_set_layer_mask(0);
+
+	if (id == _idle_animation_id) {
+		// Resume the idle animation where the overlay left it.
+		return;
+	}
+
+	_idle_animation_id = id;
+	_set_idle_animation(id);
+}
+
+void nl::strip_animator::set_chain_position(uint8_t peer_id, uint8_t peer_count) noexcept
+{
+	if (peer_id == _peer_id && peer_count == _peer_count) {
+		return;
+	}
+
+	_peer_id = peer_id;
+	_peer_count = peer_count;
+	if (_idle_animation_id != 0xff) {
+		// Restart the idle animation at its place in the chain.
+		_set_idle_animation(_idle_animation_id);
+	}
+}
+
+void nl::strip_animator::set_network_time_offset(uint32_t offset_ms) noexcept
+{
+	const int32_t shift_ms = offset_ms - _network_time_offset_ms;
+
+	// Applied from the next tick, the running animations skip ahead.
+	_network_time_offset_ms = offset_ms;
+	if (shift_ms >= 0) {
+		return;
+	}
+
+	/*
+	 * An LED's time can't move back, it would fall before the segment it is in.
+	 * The LEDs carry on from where they are on the shifted clock; the idle
+	 * animation is placed again if it follows the network time.
+	 */
+	_network_time_ms += shift_ms;
+	_time_ms = _network_time_ms;
+	for (auto& layer : _layers) {
+		for (uint8_t led_id = 0; led_id < 16; led_id++) {
+			if ((layer.config.active >> led_id) & 1) {
+				layer.state.led_time_ms[led_id] += shift_ms;
+			}
+		}
+
+		if (layer.config._animation == keyframed_animation::SPARKS) {
+			for (auto& next_spawn_time_ms : layer.state.sparks.next_spawn_time_ms) {
+				next_spawn_time_ms += shift_ms;
+			}
+		}
+	}
+
+	// Shooting stars already advance with the network time.
+	if (_peer_count > 1 &&
+	    _layers[_base_layer].config._animation == keyframed_animation::CYCLE) {
+		_set_idle_animation(_idle_animation_id);
+	}
+}
+
+void nl::strip_animator::_set_idle_animation(uint8_t id) noexcept
+{
+	_select_layer(_base_layer);
+	_set_layer_mask(0xffff);
+
 	/*
 	 * This looks pretty bad, but the goal is to alternate between animations
 	 * of each type as 'id' increases.
 	 */
 	const auto shooting_star_animations_count = ARRAY_LENGTH(keyframes::shooting_star::params);
 	const auto color_cycle_animations_count = ARRAY_LENGTH(keyframes::color_cycle::params);
+	const auto program_animations_count = ARRAY_LENGTH(nsec_programs);
+	const auto sparks_animations_count = ARRAY_LENGTH(keyframes::sparks::params);
+
+	id = id %
+		(shooting_star_animations_count + color_cycle_animations_count +
+		 program_animations_count + sparks_animations_count);
 
-	id = id % (shooting_star_animations_count + color_cycle_animations_count);
+	// Programs, then sparks, come after the animations of both types.
+	if (id >= shooting_star_animations_count + color_cycle_animations_count +
+		    program_animations_count) {
+		id -= shooting_star_animations_count + color_cycle_animations_count +
+			program_animations_count;
+
+		const auto sparks_params = keyframes::sparks::sparks_parameters_from_flash(
+			&keyframes::sparks::params[id]);
+
+		_set_sparks_animation(sparks_params.spark_count,
+				      sparks_params.spawn_interval_ms,
+				      *sparks_params.animation);
+		return;
+	}
+
+	if (id >= shooting_star_animations_count + color_cycle_animations_count) {
+		id -= shooting_star_animations_count + color_cycle_animations_count;
+		_set_program_animation(
+			static_cast<const uint8_t *>(pgm_read_ptr(&nsec_programs[id])));
+		return;
+	}
 
 	if (id / 2 < shooting_star_animations_count && id / 2 < color_cycle_animations_count) {
 		if (id % 2) {
@@ -797,8 +1082,7 @@ void nl::strip_animator::set_idle_animation(uint8_t id) noexcept
 				keyframes::color_cycle::color_cycle_parameters_from_flash(
 					&keyframes::color_cycle::params[id / 2]);
 
-			_set_keyframed_cycle_animation(cc_params.keyframes,
-						       cc_params.keyframe_count,
+			_set_keyframed_cycle_animation(*cc_params.animation,
 						       1,
 						       cc_params.active_pattern,
 						       cc_params.cycle_offset,
@@ -811,8 +1095,7 @@ void nl::strip_animator::set_idle_animation(uint8_t id) noexcept
 
 			_set_shooting_star_animation(ss_params.shooting_star_count,
 						     ss_params.delay_advance_ms,
-						     ss_params.keyframes,
-						     ss_params.keyframe_count);
+						     *ss_params.animation);
 			return;
 		}
 	}
@@ -826,16 +1109,14 @@ void nl::strip_animator::set_idle_animation(uint8_t id) noexcept
 
 		_set_shooting_star_animation(ss_params.shooting_star_count,
 					     ss_params.delay_advance_ms,
-					     ss_params.keyframes,
-					     ss_params.keyframe_count);
+					     *ss_params.animation);
 		return;
 	} else {
 		id -= shooting_star_animations_count;
 		const auto cc_params = keyframes::color_cycle::color_cycle_parameters_from_flash(
 			&keyframes::color_cycle::params[id]);
 
-		_set_keyframed_cycle_animation(cc_params.keyframes,
-					       cc_params.keyframe_count,
+		_set_keyframed_cycle_animation(*cc_params.animation,
 					       1,
 					       cc_params.active_pattern,
 					       cc_params.cycle_offset,
@@ -844,35 +1125,133 @@ void nl::strip_animator::set_idle_animation(uint8_t id) noexcept
 	}
 }
 
+void nl::strip_animator::_set_keyframes(const nla::descriptor& animation) noexcept
+{
+	_set_keyframe_range(animation, 0, 15);
+}
+
+void nl::strip_animator::_set_keyframe_range(const nla::descriptor& flash_animation,
+					     uint8_t first_keyframe_index,
+					     uint8_t keyframe_count) noexcept
+{
+	const auto animation = animation_from_flash(flash_animation);
+
+	_layer->config.keyframes = &animation.keyframes[first_keyframe_index];
+	_layer->config.keyframe_count =
+		min(keyframe_count, animation.keyframe_count - first_keyframe_index);
+	_layer->config.time_scale = animation.time_scale;
+	_layer->config.interpolation_space = animation.interpolation_space;
+
+	// Invalidate the layer's cached keyframes. The first keyframe of a range is at time 0.
+	for (uint8_t slot = 0; slot < sizeof(_keyframe_cache.indices); slot++) {
+		if ((_keyframe_cache.indices[slot] >> 4) == _layer_id) {
+			_keyframe_cache.indices[slot] = 0xff;
+		}
+	}
+
+	_layer->state.keyframe_cursor_index = 0;
+	_layer->state.keyframe_cursor_time = 0;
+	_stale_leds = 0xffff;
+}
+
+uint8_t nl::strip_animator::_keyframe_slot(uint8_t index) noexcept
+{
+	// Layers start at different slots to share the cache without evicting each other.
+	const uint8_t slot = (index + _layer_id * (nsec::config::led::keyframe_cache_size / 2)) &
+		(nsec::config::led::keyframe_cache_size - 1);
+	const uint8_t tag = (_layer_id << 4) | index;
+
+	if (_keyframe_cache.indices[slot] == tag) {
+		_keyframe_cache.hits++;
+	} else {
+		const auto *keyframes = _layer->config.keyframes;
+		const auto time_scale = _layer->config.time_scale;
+		auto& cursor_index = _layer->state.keyframe_cursor_index;
+		auto& cursor_time = _layer->state.keyframe_cursor_time;
+
+		// Segments are mostly visited in order, so the cursor rarely moves far.
+		while (cursor_index < index) {
+			cursor_index++;
+			cursor_time +=
+				pgm_read_byte(&keyframes[cursor_index].time_step) * time_scale;
+		}
+
+		while (cursor_index > index) {
+			cursor_time -=
+				pgm_read_byte(&keyframes[cursor_index].time_step) * time_scale;
+			cursor_index--;
+		}
+
+		const uint16_t segment_duration =
+			pgm_read_byte(&keyframes[index].time_step) * time_scale;
+
+		const uint8_t color_index = pgm_read_byte(&keyframes[index].color);
+
+		_keyframe_cache.misses++;
+		_keyframe_cache.indices[slot] = tag;
+		_keyframe_cache.keyframes[slot] = { palette_color(color_index), cursor_time };
+		_keyframe_cache.segment_rates[slot] = nli::rate(segment_duration);
+		if (_layer->config.interpolation_space == nla::color_space::HSV) {
+			memcpy_P(&_keyframe_cache.hsv_colors[slot],
+				 &nsec_animation_palette_hsv[color_index],
+				 sizeof(_keyframe_cache.hsv_colors[slot]));
+		}
+	}
+
+	return slot;
+}
+
+nl::strip_animator::keyframe nl::strip_animator::_keyframe(uint8_t index) noexcept
+{
+	return _keyframe_cache.keyframes[_keyframe_slot(index)];
+}
+
 void nl::strip_animator::_reset_keyframed_animation_state() noexcept
 {
-	memset(&_state.keyframed, 0, sizeof(_state.keyframed));
+	memset(&_layer->state, 0, sizeof(_layer->state));
+
+	// Animations start now, inactive LEDs at time 0.
+	_network_time_ms = millis() + _network_time_offset_ms;
+	_time_ms = _network_time_ms;
+	for (uint8_t led_id = 0; led_id < 16; led_id++) {
+		if ((_layer->config.active >> led_id) & 1) {
+			_layer->state.led_time_ms[led_id] = _time_ms;
+		}
+	}
+
+	_stale_leds = 0xffff;
 }
 
 void nl::strip_animator::set_red_to_green_led_progress_bar(uint8_t active_led_count) noexcept
 {
-	const bool is_current_animation = _current_animation_type == animation_type::KEYFRAMED &&
-		_config.keyframed._animation == keyframed_animation::PROGRESS_BAR;
+	_select_layer(_overlay_layer);
+
+	const bool is_current_animation = _layer->config.mask &&
+		_layer->config._animation == keyframed_animation::PROGRESS_BAR;
+	const uint16_t shown_leds = is_current_animation ? _layer->config.mask : 0;
 
 	if (!is_current_animation) {
-		period_ms(40);
+		_set_period(40);
 
 		// Setup animation parameters.
-		_current_animation_type = animation_type::KEYFRAMED;
-		_config.keyframed._animation = keyframed_animation::PROGRESS_BAR;
-		_config.keyframed.active = 0;
-		_config.keyframed.keyframe_count = ARRAY_LENGTH(keyframes::red_to_green_progress_bar_keyframe_template);
-		_config.keyframed.keyframes = keyframes::red_to_green_progress_bar_keyframe_template;
-		_config.keyframed.loop_point_index = 2;
-		_config.keyframed.brightness = 120;
+		_layer->config._animation = keyframed_animation::PROGRESS_BAR;
+		_layer->config.active = 0;
+		_set_keyframes(nsec_animation_red_to_green_progress_bar);
+		_layer->config.loop_point_index = 2;
+		_layer->config.brightness = 120;
 
 		// Clear its state.
 		_reset_keyframed_animation_state();
 	}
 
+	uint16_t active_leds = _layer->config.active;
 	for (uint8_t i = 0; i < active_led_count; i++) {
-		_config.keyframed.active |= (1 << i);
+		active_leds |= (1 << i);
 	}
+
+	_set_active_leds(active_leds);
+	// The idle animation goes on past the end of the bar.
+	_set_layer_mask(shown_leds | active_leds);
 }
 
 void nl::strip_animator::set_pairing_completed_animation(
@@ -886,7 +1265,7 @@ void nl::strip_animator::set_show_level_animation(
 	uint8_t level,
 	bool set_lower_bar_on) noexcept
 {
-	period_ms(40);
+	_select_layer(_overlay_layer);
 
 	uint8_t cycle_offset = 0;
 	uint16_t active_mask = 0;
@@ -897,74 +1276,113 @@ void nl::strip_animator::set_show_level_animation(
 		active_mask |= value_bit << (7 - i);
 	}
 
-	const keyframe *keyframes = nullptr;
-	uint8_t keyframe_count = 0;
+	const nla::descriptor *animation;
 
 	if (animation_type == pairing_completed_animation_type::HAPPY_CLOWN_BARF) {
-		keyframe_count = ARRAY_LENGTH(keyframes::happy_clown_barf_keyframes);
-		keyframes = keyframes::happy_clown_barf_keyframes;
+		animation = &nsec_animation_happy_clown_barf;
 		// Apply a slight offset between LEDs to achieve a "sparkle" effect.
 		cycle_offset = 10;
 	} else {
-		keyframe_count = ARRAY_LENGTH(keyframes::no_new_friends_keyframes);
-		keyframes = keyframes::no_new_friends_keyframes;
+		animation = &nsec_animation_no_new_friends;
 	}
 
 	if (set_lower_bar_on) {
 		active_mask |= 0xFF00;
 	}
 
-	_set_keyframed_cycle_animation(keyframes, keyframe_count, 1, active_mask, cycle_offset, 40);
+	_set_keyframed_cycle_animation(*animation, 1, active_mask, cycle_offset, 40);
+	// The level's unlit LEDs are shown, the idle animation goes on under an unlit bar.
+	_set_layer_mask(set_lower_bar_on ? 0xffff : 0x00ff);
 }
 
 void nl::strip_animator::_set_shooting_star_animation(uint8_t star_count,
 						     unsigned int advance_interval_ms,
-						     const keyframe *keyframes,
-						     uint8_t keyframe_count) noexcept
+						     const nla::descriptor& animation) noexcept
+{
+	_set_period(20);
+	_layer->config._animation = keyframed_animation::SHOOTING_STAR;
+	_layer->config.active = 0;
+	_reset_keyframed_animation_state();
+	_set_keyframes(animation);
+
+	_layer->config.loop_point_index = 0;
+	_layer->config.brightness = 50;
+	_layer->config.shooting_star.advance_interval_ms = advance_interval_ms;
+	// Light the stars where they are along the chain on the first tick.
+	_layer->state.shooting_star.last_advance_time_ms = _time_ms - advance_interval_ms;
+	_layer->config.shooting_star.star_count = star_count;
+}
+
+void nl::strip_animator::_set_sparks_animation(uint8_t spark_count,
+					       uint16_t spawn_interval_ms,
+					       const nla::descriptor& animation) noexcept
 {
-	period_ms(20);
-	_current_animation_type = animation_type::KEYFRAMED;
-	_config.keyframed._animation = keyframed_animation::SHOOTING_STAR;
-	_config.keyframed.active = 0;
+	_set_period(20);
+	_layer->config._animation = keyframed_animation::SPARKS;
+	_layer->config.active = 0;
 	_reset_keyframed_animation_state();
-	_config.keyframed.keyframe_count = keyframe_count;
-	_config.keyframed.keyframes = keyframes;
+	// Hold the first black keyframe after the fade rather than the trailing pause.
+	_set_keyframe_range(animation, 0, 5);
 
-	_config.keyframed.loop_point_index = 0;
-	_config.keyframed.brightness = 50;
-	_config.keyframed.shooting_star.ticks_before_advance = advance_interval_ms / period_ms();
-	_config.keyframed.shooting_star.star_count = star_count;
+	_layer->config.loop_point_index = 4;
+	_layer->config.brightness = 50;
+	_layer->config.sparks.spawn_interval_ms = spawn_interval_ms;
+	_layer->config.sparks.spark_count = min(spark_count, _max_spark_count);
+
+	// Stagger the first spawns.
+	for (uint8_t i = 0; i < _layer->config.sparks.spark_count; i++) {
+		_layer->state.sparks.next_spawn_time_ms[i] = _time_ms + _random(spawn_interval_ms);
+	}
 }
 
-void nl::strip_animator::_set_keyframed_cycle_animation(const keyframe *keyframe,
-							uint8_t keyframe_count,
+void nl::strip_animator::_set_keyframed_cycle_animation(const nla::descriptor& animation,
 							uint8_t loop_point_index,
 							uint16_t active_mask,
 							uint8_t cycle_offset_between_frames,
 							uint8_t refresh_rate) noexcept
 {
-	period_ms(refresh_rate);
+	_set_period(refresh_rate);
 
 	// Setup animation parameters.
-	_current_animation_type = animation_type::KEYFRAMED;
-	_config.keyframed._animation = keyframed_animation::CYCLE;
-	_config.keyframed.active = active_mask;
+	_layer->config._animation = keyframed_animation::CYCLE;
+	_layer->config.active = active_mask;
 
 	_reset_keyframed_animation_state();
 
-	_config.keyframed.keyframe_count = keyframe_count;
-	_config.keyframed.keyframes = keyframe;
+	_set_keyframes(animation);
+	_layer->config.loop_point_index = loop_point_index;
+	_layer->config.brightness = 50;
+
+	const bool spans_chain = _layer_id == _base_layer && _peer_count > 1;
 
 	// Apply an offset between LEDs to achieve a "sparkle" effect.
 	for (uint8_t i = 0; i < 16; i++) {
-		_state.keyframed.ticks_since_start_of_animation[i] =
-			(i * cycle_offset_between_frames) %
-			(keyframe_from_flash(
-				 &_config.keyframed.keyframes[_config.keyframed.keyframe_count - 1])
-				 .time /
-			 period_ms());
+		if (!spans_chain) {
+			_set_led_time(i, i * cycle_offset_between_frames * _layer->config.period_ms);
+			continue;
+		}
+
+		/*
+		 * Chained badges show the animation as if it started at network time 0,
+		 * the offset between LEDs running on from one peer to the next.
+		 */
+		const uint32_t led_offset_ms = uint32_t(16 * _peer_id + i) *
+			cycle_offset_between_frames * _layer->config.period_ms;
+
+		_set_led_time(i, _loop_time(_network_time_ms + led_offset_ms));
 	}
+}
+
+void nl::strip_animator::_set_program_animation(const uint8_t *bytecode) noexcept
+{
+	_set_period(20);
+	_layer->config._animation = keyframed_animation::PROGRAM;
+	_layer->config.active = 0;
+	_reset_keyframed_animation_state();
+	// Until the program selects its own keyframes.
+	_set_keyframes(*animation_by_index(0));
 
-	_config.keyframed.loop_point_index = loop_point_index;
-	_config.keyframed.brightness = 50;
+	_layer->config.loop_point_index = 0;
+	_layer->config.brightness = 50;
+	_layer->config.program.bytecode = bytecode;
 }
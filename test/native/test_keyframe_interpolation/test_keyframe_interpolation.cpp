@@ -0,0 +1,465 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2023 Jérémie Galarneau <jeremie.galarneau@gmail.com>
+ */
+
+// Program memory is plain memory on the host.
+#define PROGMEM
+
+#include "animation_data.hpp"
+#include "led/interpolation.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <unity.h>
+#include <vector>
+
+namespace nli = nsec::led::interpolation;
+
+namespace {
+constexpr unsigned int led_count = 16;
+
+struct keyframe {
+	std::array<uint8_t, 3> components;
+	uint16_t time;
+};
+
+// Representative keyframes taken from the strip animator's idle animations.
+const std::vector<keyframe> shooting_star_tungsten = {
+	{ { 0, 0, 0 }, 0 },	  { { 255, 255, 255 }, 100 }, { { 180, 0, 200 }, 400 },
+	{ { 70, 0, 0 }, 900 },	  { { 0, 0, 0 }, 1500 },      { { 0, 0, 0 }, 5000 },
+};
+
+const std::vector<keyframe> breathing = {
+	{ { 0, 0, 0 }, 0 },
+	{ { 255, 128, 0 }, 1000 },
+	{ { 40, 20, 0 }, 2000 },
+	{ { 255, 128, 0 }, 3000 },
+};
+
+const std::vector<keyframe> pastel_rainbow = {
+	{ { 0, 0, 0 }, 0 },	      { { 161, 255, 181 }, 100 }, { { 255, 128, 140 }, 200 },
+	{ { 255, 188, 110 }, 300 }, { { 255, 255, 110 }, 400 }, { { 110, 192, 255 }, 500 },
+	{ { 161, 255, 181 }, 600 },
+};
+
+/*
+ * Per-LED animation state, mirroring the strip animator's keyframed state
+ * (segment indices and the time at which the LED's animation started).
+ */
+struct led_state {
+	uint8_t origin = 0;
+	uint8_t destination = 0;
+	uint16_t start_time = 0;
+};
+
+// Interpolation as implemented before the fixed-point engine.
+std::array<uint8_t, 3>
+division_interpolate(const keyframe& origin, const keyframe& destination, uint16_t current_time)
+{
+	constexpr int16_t scaling_factor = 1024;
+	std::array<uint8_t, 3> color;
+
+	if (current_time >= destination.time) {
+		return destination.components;
+	}
+
+	const int32_t numerator = (int32_t(current_time) - int32_t(origin.time)) * scaling_factor;
+	const int32_t denominator =
+		(int32_t(destination.time) - int32_t(origin.time)) * scaling_factor;
+	for (uint8_t i = 0; i < 3; i++) {
+		const int32_t origin_component = origin.components[i];
+		const int32_t total_diff = int32_t(destination.components[i]) - origin_component;
+
+		color[i] = uint8_t(origin_component + ((total_diff * numerator) / denominator));
+	}
+
+	return color;
+}
+
+// Reference: color at an animation time, looking up its segment from scratch.
+std::array<uint8_t, 3>
+division_color(const std::vector<keyframe>& keyframes, uint8_t loop_point, uint32_t time)
+{
+	const uint16_t loop_time = keyframes[loop_point].time;
+	const uint16_t end_time = keyframes.back().time;
+
+	if (time >= end_time && loop_time == end_time) {
+		time = end_time;
+	} else if (time >= end_time) {
+		time = loop_time + (time - loop_time) % (end_time - loop_time);
+	}
+
+	unsigned int destination = 0;
+	while (destination < keyframes.size() - 1 && keyframes[destination].time <= time) {
+		destination++;
+	}
+
+	const auto origin = destination ? destination - 1 : 0;
+	return division_interpolate(keyframes[origin], keyframes[destination], time);
+}
+
+// Emulation of one LED's work in strip_animator::_layer_led_color().
+std::array<uint8_t, 3> rate_color(const std::vector<keyframe>& keyframes,
+				  uint8_t loop_point,
+				  uint16_t now,
+				  led_state& led)
+{
+	uint16_t time = now - led.start_time;
+	const uint8_t last = keyframes.size() - 1;
+
+	while (time >= keyframes[led.destination].time) {
+		if (led.destination < last) {
+			led.origin = led.destination++;
+			continue;
+		}
+
+		const uint16_t loop_time = keyframes[loop_point].time;
+		const uint16_t end_time = keyframes[led.destination].time;
+
+		if (loop_time == end_time) {
+			led.origin = led.destination;
+			time = end_time;
+			break;
+		}
+
+		time = loop_time + (time - loop_time) % (end_time - loop_time);
+		led.origin = loop_point;
+		led.destination = loop_point + 1;
+	}
+
+	led.start_time = now - time;
+
+	const auto& origin = keyframes[led.origin];
+	const auto& destination = keyframes[led.destination];
+
+	if (time >= destination.time) {
+		return destination.components;
+	}
+
+	// Rates are computed once per decoded keyframe on the badge.
+	const auto rate = nli::rate(destination.time - origin.time);
+	const auto phase = nli::phase_at(time - origin.time, rate);
+	std::array<uint8_t, 3> color;
+
+	for (uint8_t i = 0; i < 3; i++) {
+		color[i] = nli::component(origin.components[i], destination.components[i], phase);
+	}
+
+	return color;
+}
+
+/*
+ * Ticks 16 LEDs, started at staggered times, at irregular intervals including
+ * pauses longer than whole segments and loops.
+ */
+void check_matches_division(const std::vector<keyframe>& keyframes,
+			    uint8_t loop_point,
+			    uint16_t period_ms,
+			    uint16_t offset_ms)
+{
+	std::array<led_state, led_count> leds;
+	std::array<uint32_t, led_count> start_times;
+	uint32_t now = 0xfff0;
+	unsigned int exact = 0, total = 0;
+
+	for (unsigned int i = 0; i < led_count; i++) {
+		start_times[i] = now - i * offset_ms;
+		leds[i].start_time = start_times[i];
+	}
+
+	for (unsigned int tick = 0; tick < 2000; tick++) {
+		now += period_ms + (tick % 7 == 0 ? tick % 5 : 0) + (tick % 101 == 0 ? 3000 : 0);
+
+		for (unsigned int i = 0; i < led_count; i++) {
+			const auto expected =
+				division_color(keyframes, loop_point, now - start_times[i]);
+			const auto actual = rate_color(keyframes, loop_point, now, leds[i]);
+
+			for (uint8_t c = 0; c < 3; c++) {
+				TEST_ASSERT_INT_WITHIN_MESSAGE(
+					1,
+					expected[c],
+					actual[c],
+					"Fixed-point color is within 1 of the division-based color");
+				exact += expected[c] == actual[c];
+				total++;
+			}
+		}
+	}
+
+	char message[96];
+	snprintf(message,
+		 sizeof(message),
+		 "%u/%u components bit-identical (period %u ms)",
+		 exact,
+		 total,
+		 period_ms);
+	TEST_MESSAGE(message);
+}
+
+void test_component_extremes()
+{
+	TEST_ASSERT_EQUAL_UINT8(0, nli::component(0, 255, 0));
+	TEST_ASSERT_EQUAL_UINT8(254, nli::component(0, 255, UINT16_MAX));
+	TEST_ASSERT_EQUAL_UINT8(255, nli::component(255, 0, 0));
+	TEST_ASSERT_EQUAL_UINT8(1, nli::component(255, 0, UINT16_MAX));
+	TEST_ASSERT_EQUAL_UINT8(127, nli::component(0, 255, 0x8000));
+	TEST_ASSERT_EQUAL_UINT8(128, nli::component(255, 0, 0x8000));
+	TEST_ASSERT_EQUAL_UINT8(42, nli::component(42, 42, 0x1234));
+}
+
+void test_phase_at_rate()
+{
+	TEST_ASSERT_EQUAL_UINT16(0, nli::phase_at(0, nli::rate(1)));
+	// Rates are rounded down.
+	TEST_ASSERT_UINT16_WITHIN(1, 0x8000, nli::phase_at(20, nli::rate(40)));
+	TEST_ASSERT_UINT16_WITHIN(2, 65470, nli::phase_at(999, nli::rate(1000)));
+	// The end of the longest segment doesn't wrap around.
+	TEST_ASSERT_UINT16_WITHIN(4, UINT16_MAX, nli::phase_at(65024, nli::rate(65025)));
+}
+
+void test_shooting_star_matches_division()
+{
+	check_matches_division(shooting_star_tungsten, 0, 20, 0);
+	check_matches_division(shooting_star_tungsten, 5, 20, 90);
+}
+
+void test_breathing_matches_division()
+{
+	check_matches_division(breathing, 1, 20, 60 * 20);
+}
+
+void test_pastel_rainbow_matches_division()
+{
+	check_matches_division(pastel_rainbow, 1, 40, 10 * 40);
+}
+
+void check_rgb(uint8_t red, uint8_t green, uint8_t blue, const nli::hsv_color& color)
+{
+	const auto converted = nli::rgb(color);
+
+	TEST_ASSERT_EQUAL_UINT8(red, converted.red);
+	TEST_ASSERT_EQUAL_UINT8(green, converted.green);
+	TEST_ASSERT_EQUAL_UINT8(blue, converted.blue);
+}
+
+void test_hsv_to_rgb()
+{
+	check_rgb(255, 0, 0, { 0, 255, 255 });
+	check_rgb(255, 255, 0, { 256, 255, 255 });
+	check_rgb(0, 255, 0, { 512, 255, 255 });
+	check_rgb(0, 255, 255, { 768, 255, 255 });
+	check_rgb(0, 0, 255, { 1024, 255, 255 });
+	check_rgb(255, 0, 255, { 1280, 255, 255 });
+	check_rgb(255, 0, 127, { 1408, 255, 255 });
+	check_rgb(255, 128, 0, { 128, 255, 255 });
+	check_rgb(100, 100, 100, { 1000, 0, 100 });
+	check_rgb(0, 0, 0, { 300, 255, 0 });
+}
+
+// The animation compiler chooses HSV colors that convert back exactly.
+void test_hsv_palette_matches_rgb_palette()
+{
+	const auto hsv_color_count =
+		sizeof(nsec_animation_palette_hsv) / sizeof(*nsec_animation_palette_hsv);
+
+	for (unsigned int i = 0; i < hsv_color_count; i++) {
+		const auto& expected = nsec_animation_palette[i];
+
+		TEST_ASSERT_LESS_THAN_UINT16(nli::hue_range, nsec_animation_palette_hsv[i].hue);
+		check_rgb(expected[0], expected[1], expected[2], nsec_animation_palette_hsv[i]);
+	}
+}
+
+void test_hue_takes_shortest_arc()
+{
+	TEST_ASSERT_EQUAL_UINT16(1400, nli::hue(1400, 100, 0));
+	// Forward and backward through red.
+	TEST_ASSERT_EQUAL_UINT16(1518, nli::hue(1400, 100, 0x8000));
+	TEST_ASSERT_EQUAL_UINT16(1518, nli::hue(100, 1400, 0x8000));
+	TEST_ASSERT_EQUAL_UINT16(99, nli::hue(1400, 100, UINT16_MAX));
+	TEST_ASSERT_EQUAL_UINT16(1401, nli::hue(100, 1400, UINT16_MAX));
+	TEST_ASSERT_EQUAL_UINT16(384, nli::hue(0, 768, 0x8000));
+	TEST_ASSERT_EQUAL_UINT16(600, nli::hue(600, 600, 0x8000));
+
+	for (uint32_t progress = 0; progress <= UINT16_MAX; progress += 7) {
+		TEST_ASSERT_LESS_THAN_UINT16(nli::hue_range, nli::hue(1535, 1, progress));
+		TEST_ASSERT_LESS_THAN_UINT16(nli::hue_range, nli::hue(1, 1535, progress));
+	}
+}
+
+/*
+ * Red to cyan goes through grey in RGB, but stays saturated in HSV. Fading from
+ * black only changes the value.
+ */
+void test_hsv_fades()
+{
+	const nli::hsv_color red = { 0, 255, 255 }, cyan = { 768, 255, 255 };
+	const auto middle = nli::rgb(nli::hsv(red, cyan, 0x8000));
+	const auto [min, max] = std::minmax({ middle.red, middle.green, middle.blue });
+
+	// In RGB, red and cyan components all meet halfway.
+	TEST_ASSERT_UINT8_WITHIN(1, nli::component(255, 0, 0x8000), nli::component(0, 255, 0x8000));
+	TEST_ASSERT_EQUAL_UINT8(0, min);
+	TEST_ASSERT_EQUAL_UINT8(255, max);
+
+	for (uint32_t progress = 0; progress <= UINT16_MAX; progress += 255) {
+		const auto color = nli::rgb(nli::hsv({ 0, 0, 0 }, { 1024, 255, 200 }, progress));
+
+		TEST_ASSERT_EQUAL_UINT8(0, color.red);
+		TEST_ASSERT_EQUAL_UINT8(0, color.green);
+		TEST_ASSERT_EQUAL_UINT8(nli::component(0, 200, progress), color.blue);
+	}
+}
+
+template <typename ColorFunction>
+double nanoseconds_per_tick(ColorFunction color_function)
+{
+	constexpr unsigned int tick_count = 200000;
+	std::array<led_state, led_count> leds;
+	unsigned int checksum = 0;
+	uint16_t now = 0;
+
+	for (unsigned int i = 0; i < led_count; i++) {
+		leds[i].start_time = now - i * 60 * 20;
+	}
+
+	const auto start = std::chrono::steady_clock::now();
+	for (unsigned int tick = 0; tick < tick_count; tick++) {
+		now += 20;
+		for (auto& led : leds) {
+			const auto color = color_function(now, led);
+
+			checksum += color[0] + color[1] + color[2];
+		}
+	}
+	const auto end = std::chrono::steady_clock::now();
+
+	// Keep the computation from being optimized out.
+	TEST_ASSERT_NOT_EQUAL(0, checksum);
+	return std::chrono::duration<double, std::nano>(end - start).count() / tick_count;
+}
+
+/*
+ * Compares the cost of a 16-LED keyframe tick on the host, looking up each
+ * LED's segment and dividing on every tick versus following the segments with
+ * phase rates. The host has a hardware divider, so the gap understates the gain
+ * on the AVR where each 32-bit division is a ~600 cycle __divmodsi4 call.
+ */
+void benchmark_keyframe_animation_tick()
+{
+	const auto division_ns = nanoseconds_per_tick([](uint16_t now, led_state& led) {
+		return division_color(breathing, 1, uint16_t(now - led.start_time));
+	});
+	const auto rate_ns = nanoseconds_per_tick(
+		[](uint16_t now, led_state& led) { return rate_color(breathing, 1, now, led); });
+	char message[128];
+
+	snprintf(message,
+		 sizeof(message),
+		 "keyframe tick: %.1f ns with divisions, %.1f ns with phase rates",
+		 division_ns,
+		 rate_ns);
+	TEST_MESSAGE(message);
+}
+/*
+ * Compares the cost of interpolating 16 LEDs in RGB and in HSV through the
+ * segments of the pastel rainbow, once the keyframes are decoded. On the AVR,
+ * the HSV path replaces three 8x16-bit multiplications by a 16x16-bit one for
+ * the hue and four 8x8-bit ones, which the hardware multiplier does in 2 cycles.
+ */
+void benchmark_hsv_interpolation()
+{
+	constexpr unsigned int tick_count = 200000;
+	std::vector<std::array<uint8_t, 3>> rgb_colors;
+	std::vector<nli::hsv_color> hsv_colors;
+
+	for (const auto& keyframe : pastel_rainbow) {
+		const auto [red, green, blue] = keyframe.components;
+		nli::hsv_color hsv;
+
+		// Search the palette's HSV colors, as the animation compiler would convert them.
+		for (unsigned int i = 0;; i++) {
+			const auto *entry = nsec_animation_palette[i];
+
+			if (entry[0] == red && entry[1] == green && entry[2] == blue) {
+				hsv = nsec_animation_palette_hsv[i];
+				break;
+			}
+		}
+
+		rgb_colors.push_back(keyframe.components);
+		hsv_colors.push_back(hsv);
+	}
+
+	const auto measure = [&](auto color_function) {
+		unsigned int checksum = 0;
+		const auto start = std::chrono::steady_clock::now();
+
+		for (unsigned int tick = 0; tick < tick_count; tick++) {
+			for (unsigned int led = 0; led < led_count; led++) {
+				const unsigned int segment =
+					1 + (tick / 64 + led) % (rgb_colors.size() - 1);
+				const nli::phase phase = (tick * 1021 + led * 4099) & 0xffff;
+				const auto color = color_function(segment, phase);
+
+				checksum += color[0] + color[1] + color[2];
+			}
+		}
+
+		const auto end = std::chrono::steady_clock::now();
+
+		TEST_ASSERT_NOT_EQUAL(0, checksum);
+		return std::chrono::duration<double, std::nano>(end - start).count() / tick_count;
+	};
+
+	const auto rgb_ns = measure([&](unsigned int segment, nli::phase phase) {
+		std::array<uint8_t, 3> color;
+
+		for (uint8_t i = 0; i < 3; i++) {
+			color[i] = nli::component(
+				rgb_colors[segment - 1][i], rgb_colors[segment][i], phase);
+		}
+
+		return color;
+	});
+	const auto hsv_ns = measure([&](unsigned int segment, nli::phase phase) {
+		const auto color = nli::rgb(
+			nli::hsv(hsv_colors[segment - 1], hsv_colors[segment], phase));
+
+		return std::array<uint8_t, 3>{ color.red, color.green, color.blue };
+	});
+	char message[128];
+
+	snprintf(message,
+		 sizeof(message),
+		 "16-LED interpolation: %.1f ns in RGB, %.1f ns in HSV",
+		 rgb_ns,
+		 hsv_ns);
+	TEST_MESSAGE(message);
+}
+} // anonymous namespace
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+	UNITY_BEGIN();
+
+	RUN_TEST(test_component_extremes);
+	RUN_TEST(test_phase_at_rate);
+	RUN_TEST(test_shooting_star_matches_division);
+	RUN_TEST(test_breathing_matches_division);
+	RUN_TEST(test_pastel_rainbow_matches_division);
+	RUN_TEST(test_hsv_to_rgb);
+	RUN_TEST(test_hsv_palette_matches_rgb_palette);
+	RUN_TEST(test_hue_takes_shortest_arc);
+	RUN_TEST(test_hsv_fades);
+	RUN_TEST(benchmark_keyframe_animation_tick);
+	RUN_TEST(benchmark_hsv_interpolation);
+
+	return UNITY_END();
+}
@@ -0,0 +1,62 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2023 Jérémie Galarneau <jeremie.galarneau@gmail.com>
+ */
+
+#ifndef NSEC_SIMULATION_ARDUINO_H
+#define NSEC_SIMULATION_ARDUINO_H
+
+/*
+ * Host stand-in for the parts of the Arduino core used by the network handler.
+ * Pins read the connectors of the badge being run.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+namespace nsec::simulation {
+// Virtual clock, in microseconds.
+extern unsigned long now_us;
+
+int digital_read(uint8_t pin) noexcept;
+} // namespace nsec::simulation
+
+#define LOW	     0
+#define HIGH	     1
+#define INPUT	     0
+#define OUTPUT	     1
+#define INPUT_PULLUP 2
+
+// Functions rather than the core's macros, which would break the standard library's headers.
+template <typename Lhs, typename Rhs>
+constexpr auto min(Lhs lhs, Rhs rhs) noexcept
+{
+	return lhs < rhs ? lhs : rhs;
+}
+
+template <typename Lhs, typename Rhs>
+constexpr auto max(Lhs lhs, Rhs rhs) noexcept
+{
+	return lhs > rhs ? lhs : rhs;
+}
+
+inline unsigned long millis() noexcept
+{
+	return nsec::simulation::now_us / 1000;
+}
+
+inline int digitalRead(uint8_t pin) noexcept
+{
+	return nsec::simulation::digital_read(pin);
+}
+
+inline void digitalWrite(uint8_t, uint8_t) noexcept
+{
+}
+
+inline void pinMode(uint8_t, uint8_t) noexcept
+{
+}
+
+#endif // NSEC_SIMULATION_ARDUINO_H
@@ -0,0 +1,699 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2023 Jérémie Galarneau <jeremie.galarneau@gmail.com>
+ */
+
+/*
+ * Host simulation of a chain of badges.
+ *
+ * The firmware's network handler is built against fake serial ports and a
+ * virtual clock (see Arduino.h in this folder). Each badge runs its handler at
+ * the handler's period, with its own phase. The bytes written to a port reach
+ * the peer's receiver after their time on the line at the sender's speed; a
+ * receiver set to another speed loses them. Links may also corrupt bytes.
+ *
+ * Chains are plugged at once and measured until all badges completed their
+ * pairing. The badges' IDs are then exchanged by the firmware's ID exchanger.
+ */
+
+#include "Arduino.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <set>
+#include <unity.h>
+#include <vector>
+
+// Stand-ins for the badge's globals and unique ID, the network handler only needs these.
+#define NSEC_GLOBALS_HPP
+#define NSEC_UNIQUE_ID_HPP
+#define UniqueIDsize 10
+
+#include "network/id_exchanger.hpp"
+#include "network/network_handler.hpp"
+
+namespace nsec::simulation {
+struct simulated_badge;
+
+unsigned long now_us;
+simulated_badge *current_badge;
+} // namespace nsec::simulation
+
+namespace nsec::runtime {
+// Forwards the network handler's notifications to the badge being run.
+class badge {
+public:
+	void on_disconnection() noexcept;
+	void on_pairing_end(communication::peer_id_t peer_id, uint8_t peer_count) noexcept;
+	communication::network_handler::application_message_action
+	on_message_received(communication::message::type message_type,
+			    const uint8_t *payload) noexcept;
+	uint32_t id() const noexcept;
+	enum class badge_discovered_result : uint8_t { NEW, ALREADY_KNOWN };
+	badge_discovered_result on_badge_discovered(uint32_t id) noexcept;
+	void on_badge_discovery_completed() noexcept;
+
+	void on_network_quiet_window() noexcept
+	{
+	}
+
+	void on_network_time_offset_changed(uint32_t) noexcept
+	{
+	}
+};
+} // namespace nsec::runtime
+
+namespace nsec::g {
+// Badges are run directly, each at its own phase.
+class scheduler_stub {
+public:
+	void schedule_task(scheduling::task&) noexcept
+	{
+	}
+} the_scheduler;
+
+runtime::badge the_badge;
+} // namespace nsec::g
+
+#include "../../../src/id_exchanger.cpp"
+#include "../../../src/network_handler.cpp"
+
+namespace ndsu = nsec::communication::dual_soft_uart;
+namespace nsu = nsec::communication::soft_uart;
+
+namespace nsec::simulation {
+// Pseudo-random numbers, reproducible from their seed.
+class random_generator {
+public:
+	explicit random_generator(uint32_t seed) noexcept : _state(seed)
+	{
+	}
+
+	uint32_t next(uint32_t bound) noexcept
+	{
+		_state = _state * 1103515245 + 12345;
+		return (_state >> 8) % bound;
+	}
+
+private:
+	uint32_t _state;
+};
+
+// One end of a link: a port and the bytes on their way to its receiver.
+struct link_end {
+	struct byte_on_line {
+		unsigned long arrival_us;
+		uint32_t speed;
+		uint8_t value;
+	};
+
+	// Put a byte on the line, after the bytes already written.
+	void send(uint8_t value) noexcept
+	{
+		if (!peer) {
+			return;
+		}
+
+		line_free_us = std::max(now_us, line_free_us) +
+			nsu::frame_bit_count * 1000000UL / speed;
+		if (corruption_rate && random->next(corruption_rate) == 0) {
+			value ^= 1 << random->next(8);
+		}
+
+		peer->incoming.push_back({ line_free_us, speed, value });
+		sent_byte_count++;
+	}
+
+	// Feed the receiver with the bytes that arrived, as its interrupt handlers do.
+	void deliver() noexcept
+	{
+		while (!incoming.empty() && incoming.front().arrival_us <= now_us) {
+			const auto byte = incoming.front();
+
+			incoming.pop_front();
+			if (byte.speed != speed) {
+				// Garbled.
+				continue;
+			}
+
+			receiver.start(0);
+			for (uint8_t bit_index = 0; bit_index < nsu::frame_bit_count; bit_index++) {
+				receiver.sample(nsu::frame_level(byte.value, bit_index));
+			}
+		}
+	}
+
+	ndsu::receiver receiver;
+	ndsu::transmitter transmitter;
+	link_end *peer = nullptr;
+	uint32_t speed = 0;
+	unsigned long line_free_us = 0;
+	std::deque<byte_on_line> incoming;
+	// One byte in corruption_rate is corrupted, none if 0.
+	uint32_t corruption_rate = 0;
+	random_generator *random = nullptr;
+	unsigned long sent_byte_count = 0;
+};
+
+// Ends of the ports, in their construction order: each badge's left port, then its right one.
+std::deque<link_end> link_ends;
+
+link_end& end_of(const ndsu::receiver& receiver) noexcept
+{
+	return *std::find_if(link_ends.begin(), link_ends.end(), [&receiver](const link_end& end) {
+		return &end.receiver == &receiver;
+	});
+}
+
+struct simulated_badge {
+	simulated_badge() :
+		left(link_ends[link_ends.size() - 2]), right(link_ends[link_ends.size() - 1])
+	{
+	}
+
+	void run() noexcept
+	{
+		current_badge = this;
+		left.deliver();
+		right.deliver();
+		static_cast<scheduling::task&>(handler).run(millis());
+		if (is_exchanging_ids) {
+			id_exchanger.tick(handler);
+		}
+
+		current_badge = nullptr;
+	}
+
+	communication::network_handler handler;
+	communication::id_exchanger id_exchanger;
+	link_end& left;
+	link_end& right;
+	unsigned long next_run_us = 0;
+
+	bool is_paired = false;
+	communication::peer_id_t peer_id = 0;
+	uint8_t peer_count = 0;
+	unsigned long pairing_end_us = 0;
+	unsigned int disconnection_count = 0;
+	unsigned int received_app_message_count = 0;
+
+	uint32_t id = 0;
+	bool is_exchanging_ids = false;
+	std::set<uint32_t> discovered_ids;
+	unsigned long id_exchange_end_us = 0;
+};
+
+int digital_read(uint8_t pin) noexcept
+{
+	// A peer holds our RX pin low and pulls our sense pin down.
+	if (pin == nsec::config::communication::serial_rx_pin_left) {
+		return current_badge->left.peer ? LOW : HIGH;
+	}
+
+	if (pin == nsec::config::communication::connection_sense_pin_right) {
+		return current_badge->right.peer ? LOW : HIGH;
+	}
+
+	return HIGH;
+}
+
+// Badges plugged left to right, at time 0.
+class chain {
+public:
+	chain(uint8_t badge_count, uint32_t seed, uint32_t corruption_rate = 0) : _random(seed)
+	{
+		now_us = 0;
+		link_ends.clear();
+
+		for (uint8_t i = 0; i < badge_count; i++) {
+			_badges.emplace_back(new simulated_badge);
+
+			auto& badge = *_badges.back();
+
+			current_badge = &badge;
+			badge.handler.setup();
+			current_badge = nullptr;
+			badge.id = 0x1e951600 + i;
+			badge.next_run_us = _random.next(
+				nsec::config::communication::network_handler_base_period_ms * 1000);
+		}
+
+		for (uint8_t i = 0; i + 1 < badge_count; i++) {
+			auto& left = _badges[i]->right;
+			auto& right = _badges[i + 1]->left;
+
+			left.peer = &right;
+			right.peer = &left;
+		}
+
+		for (auto& end : link_ends) {
+			end.corruption_rate = corruption_rate;
+			end.random = &_random;
+		}
+	}
+
+	~chain()
+	{
+		_badges.clear();
+		link_ends.clear();
+	}
+
+	simulated_badge& operator[](uint8_t index) noexcept
+	{
+		return *_badges[index];
+	}
+
+	uint8_t size() const noexcept
+	{
+		return _badges.size();
+	}
+
+	// Run the badges until predicate holds or duration_ms elapsed, returns the predicate.
+	template <typename Predicate>
+	bool run_until(Predicate predicate, unsigned long duration_ms)
+	{
+		const auto end_us = now_us + duration_ms * 1000;
+
+		while (!predicate()) {
+			auto& badge = **std::min_element(_badges.begin(),
+							 _badges.end(),
+							 [](const auto& lhs, const auto& rhs) {
+								 return lhs->next_run_us <
+									 rhs->next_run_us;
+							 });
+
+			if (badge.next_run_us > end_us) {
+				now_us = end_us;
+				return false;
+			}
+
+			now_us = badge.next_run_us;
+			badge.run();
+			badge.next_run_us +=
+				nsec::config::communication::network_handler_base_period_ms * 1000;
+		}
+
+		return true;
+	}
+
+	void run_for(unsigned long duration_ms)
+	{
+		run_until([] { return false; }, duration_ms);
+	}
+
+	// All badges agree on the chain.
+	bool is_paired() const noexcept
+	{
+		for (uint8_t i = 0; i < _badges.size(); i++) {
+			const auto& badge = *_badges[i];
+
+			if (!badge.is_paired || badge.peer_id != i ||
+			    badge.peer_count != _badges.size()) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	// Each badge starts the exchange of IDs, as the badges do after the pairing animation.
+	void start_id_exchange() noexcept
+	{
+		for (auto& badge : _badges) {
+			current_badge = badge.get();
+			badge->id_exchanger.reset();
+			badge->is_exchanging_ids = true;
+			badge->id_exchanger.start(badge->handler);
+			current_badge = nullptr;
+		}
+	}
+
+	bool is_id_exchange_complete() const noexcept
+	{
+		return std::none_of(_badges.begin(), _badges.end(), [](const auto& badge) {
+			return badge->is_exchanging_ids;
+		});
+	}
+
+	unsigned long id_exchange_end_time_ms() const noexcept
+	{
+		unsigned long end_us = 0;
+
+		for (const auto& badge : _badges) {
+			end_us = std::max(end_us, badge->id_exchange_end_us);
+		}
+
+		return end_us / 1000;
+	}
+
+	unsigned long pairing_time_ms() const noexcept
+	{
+		unsigned long pairing_end_us = 0;
+
+		for (const auto& badge : _badges) {
+			pairing_end_us = std::max(pairing_end_us, badge->pairing_end_us);
+		}
+
+		return pairing_end_us / 1000;
+	}
+
+private:
+	random_generator _random;
+	std::vector<std::unique_ptr<simulated_badge>> _badges;
+};
+} // namespace nsec::simulation
+
+void ndsu::begin() noexcept
+{
+}
+
+ndsu::port::port(side port_side) noexcept :
+	_receiver(nsec::simulation::link_ends.emplace_back().receiver),
+	_transmitter(nsec::simulation::link_ends.back().transmitter),
+	_side(port_side)
+{
+}
+
+void ndsu::port::begin() noexcept
+{
+}
+
+void ndsu::port::speed(uint32_t speed) noexcept
+{
+	nsec::simulation::end_of(_receiver).speed = speed;
+}
+
+void ndsu::port::read(uint8_t *data, uint8_t size) noexcept
+{
+	for (uint8_t i = 0; i < size; i++) {
+		data[i] = _receiver.read();
+	}
+}
+
+void ndsu::port::write(uint8_t value) noexcept
+{
+	nsec::simulation::end_of(_receiver).send(value);
+}
+
+void ndsu::port::write(const uint8_t *data, uint8_t size) noexcept
+{
+	for (uint8_t i = 0; i < size; i++) {
+		write(data[i]);
+	}
+}
+
+void nsec::runtime::badge::on_disconnection() noexcept
+{
+	simulation::current_badge->is_paired = false;
+	simulation::current_badge->disconnection_count++;
+}
+
+void nsec::runtime::badge::on_pairing_end(communication::peer_id_t peer_id,
+					  uint8_t peer_count) noexcept
+{
+	simulation::current_badge->is_paired = true;
+	simulation::current_badge->peer_id = peer_id;
+	simulation::current_badge->peer_count = peer_count;
+	simulation::current_badge->pairing_end_us = simulation::now_us;
+}
+
+nsec::communication::network_handler::application_message_action
+nsec::runtime::badge::on_message_received(communication::message::type message_type,
+					  const uint8_t *payload) noexcept
+{
+	auto& badge = *simulation::current_badge;
+
+	badge.received_app_message_count++;
+	if (badge.is_exchanging_ids) {
+		return badge.id_exchanger.new_message(badge.handler, message_type, payload);
+	}
+
+	return communication::network_handler::application_message_action::OK;
+}
+
+uint32_t nsec::runtime::badge::id() const noexcept
+{
+	return simulation::current_badge->id;
+}
+
+nsec::runtime::badge::badge_discovered_result
+nsec::runtime::badge::on_badge_discovered(uint32_t id) noexcept
+{
+	return simulation::current_badge->discovered_ids.insert(id).second ?
+		badge_discovered_result::NEW :
+		badge_discovered_result::ALREADY_KNOWN;
+}
+
+void nsec::runtime::badge::on_badge_discovery_completed() noexcept
+{
+	simulation::current_badge->is_exchanging_ids = false;
+	simulation::current_badge->id_exchange_end_us = simulation::now_us;
+}
+
+namespace {
+namespace nsim = nsec::simulation;
+
+constexpr unsigned long pairing_time_limit_ms = 60000;
+constexpr unsigned long id_exchange_time_limit_ms = 120000;
+constexpr uint8_t seed_count = 8;
+/*
+ * Messages travel back and forth along the chain, once discovery starts (after
+ * 4 ticks): each badge may not take more than two ticks on average.
+ */
+constexpr unsigned long discovery_start_time_ms =
+	4 * nsec::config::communication::network_handler_base_period_ms;
+constexpr unsigned long pairing_time_per_badge_ms =
+	2 * nsec::config::communication::network_handler_base_period_ms;
+
+void assert_pairs(nsim::chain& chain)
+{
+	TEST_ASSERT_TRUE(chain.run_until([&chain] { return chain.is_paired(); },
+					 pairing_time_limit_ms));
+
+	for (uint8_t i = 0; i < chain.size(); i++) {
+		TEST_ASSERT_EQUAL_UINT8(i, chain[i].peer_id);
+		TEST_ASSERT_EQUAL_UINT8(chain.size(), chain[i].peer_count);
+		TEST_ASSERT_EQUAL_UINT32(0, chain[i].disconnection_count);
+	}
+}
+
+// Once started, every badge learns the IDs of all the others without being disconnected.
+void assert_exchanges_ids(nsim::chain& chain)
+{
+	TEST_ASSERT_TRUE(chain.run_until([&chain] { return chain.is_id_exchange_complete(); },
+					 id_exchange_time_limit_ms));
+
+	for (uint8_t i = 0; i < chain.size(); i++) {
+		TEST_ASSERT_EQUAL_UINT32(chain.size() - 1, chain[i].discovered_ids.size());
+		TEST_ASSERT_EQUAL_UINT32(0, chain[i].discovered_ids.count(chain[i].id));
+		TEST_ASSERT_EQUAL_UINT32(0, chain[i].disconnection_count);
+	}
+}
+
+// Average pairing time of chains of badge_count badges, over several phases of their ticks.
+unsigned long mean_pairing_time_ms(uint8_t badge_count)
+{
+	unsigned long total_ms = 0;
+
+	for (uint8_t seed = 1; seed <= seed_count; seed++) {
+		nsim::chain chain(badge_count, seed);
+
+		assert_pairs(chain);
+		total_ms += chain.pairing_time_ms();
+	}
+
+	return total_ms / seed_count;
+}
+
+void test_pairing_time()
+{
+	for (const uint8_t badge_count : { 2, 3, 4, 8, 16 }) {
+		const auto pairing_time_ms = mean_pairing_time_ms(badge_count);
+		char message[96];
+
+		snprintf(message,
+			 sizeof(message),
+			 "%2u badges: paired in %5lu ms",
+			 badge_count,
+			 pairing_time_ms);
+		TEST_MESSAGE(message);
+		TEST_ASSERT_TRUE(pairing_time_ms <=
+				 discovery_start_time_ms + badge_count * pairing_time_per_badge_ms);
+	}
+}
+
+// Links corrupt one byte in 100: corrupted frames are sent again.
+void test_pairing_with_corrupted_bytes()
+{
+	for (uint8_t seed = 1; seed <= seed_count; seed++) {
+		nsim::chain chain(6, seed, 100);
+
+		assert_pairs(chain);
+	}
+}
+
+void test_links_run_at_negotiated_speed()
+{
+	nsim::chain chain(4, 1);
+
+	assert_pairs(chain);
+	chain.run_for(5000);
+
+	for (uint8_t i = 0; i + 1 < chain.size(); i++) {
+		TEST_ASSERT_EQUAL_UINT32(57600, chain[i].right.speed);
+		TEST_ASSERT_EQUAL_UINT32(57600, chain[i + 1].left.speed);
+	}
+
+	for (uint8_t i = 0; i < chain.size(); i++) {
+		TEST_ASSERT_TRUE(chain[i].is_paired);
+	}
+}
+
+/*
+ * The IDs travel along the chain and back, but every badge must receive every
+ * other ID: the bytes on the chain grow with the square of its length.
+ */
+void test_id_exchange_time()
+{
+	for (const uint8_t badge_count : { 4, 8, 16, 31 }) {
+		unsigned long total_ms = 0;
+		char message[96];
+
+		for (uint8_t seed = 1; seed <= seed_count; seed++) {
+			nsim::chain chain(badge_count, seed);
+
+			assert_pairs(chain);
+
+			const auto start_ms = nsim::now_us / 1000;
+
+			chain.start_id_exchange();
+			assert_exchanges_ids(chain);
+			total_ms += chain.id_exchange_end_time_ms() - start_ms;
+		}
+
+		snprintf(message,
+			 sizeof(message),
+			 "%2u badges: IDs exchanged in %5lu ms",
+			 badge_count,
+			 total_ms / seed_count);
+		TEST_MESSAGE(message);
+	}
+}
+
+// Fragments a badge has no room for are forwarded once its queue drains.
+void test_id_exchange_with_full_queue()
+{
+	nsim::chain chain(5, 1);
+	auto& badge = chain[1];
+	// The message has no payload.
+	const uint8_t no_payload = 0;
+
+	assert_pairs(chain);
+	chain.start_id_exchange();
+
+	// Keep the badge's queue full until the first fragment reaches it.
+	TEST_ASSERT_TRUE(chain.run_until(
+		[&badge, &no_payload] {
+			while (badge.handler.enqueue_app_message(
+				       nc::peer_relative_position::RIGHT,
+				       uint8_t(nc::message::type::PAIRING_ANIMATION_DONE),
+				       &no_payload) ==
+			       nc::network_handler::enqueue_message_result::QUEUED) {
+			}
+
+			return !badge.discovered_ids.empty();
+		},
+		id_exchange_time_limit_ms));
+
+	assert_exchanges_ids(chain);
+}
+
+// Application messages reach the neighbor they are sent to, in both directions.
+void test_app_messages_are_delivered()
+{
+	nsim::chain chain(3, 1);
+	const nsec::communication::message::badge_id_vector message = {};
+
+	assert_pairs(chain);
+
+	TEST_ASSERT_EQUAL(nc::network_handler::enqueue_message_result::QUEUED,
+			  chain[0].handler.enqueue_app_message(
+				  nc::peer_relative_position::RIGHT,
+				  uint8_t(nc::message::type::COLLECT_BADGE_IDS),
+				  reinterpret_cast<const uint8_t *>(&message)));
+	TEST_ASSERT_EQUAL(nc::network_handler::enqueue_message_result::QUEUED,
+			  chain[2].handler.enqueue_app_message(
+				  nc::peer_relative_position::LEFT,
+				  uint8_t(nc::message::type::COLLECT_BADGE_IDS),
+				  reinterpret_cast<const uint8_t *>(&message)));
+	TEST_ASSERT_TRUE(chain.run_until(
+		[&chain] { return chain[1].received_app_message_count == 2; }, 2000));
+	chain.run_for(500);
+
+	TEST_ASSERT_EQUAL_UINT32(0, chain[0].received_app_message_count);
+	TEST_ASSERT_EQUAL_UINT32(2, chain[1].received_app_message_count);
+	TEST_ASSERT_EQUAL_UINT32(0, chain[2].received_app_message_count);
+}
+
+// Messages queued at once go out back to back, until the queue is drained.
+void test_app_messages_are_queued()
+{
+	nsim::chain chain(3, 1);
+	const nsec::communication::message::badge_id_vector message = {};
+	constexpr uint8_t queued_message_count =
+		nsec::config::communication::application_message_queue_size /
+		(1 + sizeof(message));
+
+	assert_pairs(chain);
+
+	for (uint8_t i = 0; i < queued_message_count; i++) {
+		TEST_ASSERT_EQUAL(nc::network_handler::enqueue_message_result::QUEUED,
+				  chain[0].handler.enqueue_app_message(
+					  nc::peer_relative_position::RIGHT,
+					  uint8_t(nc::message::type::COLLECT_BADGE_IDS),
+					  reinterpret_cast<const uint8_t *>(&message)));
+	}
+
+	TEST_ASSERT_EQUAL(nc::network_handler::enqueue_message_result::FULL,
+			  chain[0].handler.enqueue_app_message(
+				  nc::peer_relative_position::RIGHT,
+				  uint8_t(nc::message::type::COLLECT_BADGE_IDS),
+				  reinterpret_cast<const uint8_t *>(&message)));
+
+	// Two passes of the wave front.
+	TEST_ASSERT_TRUE(chain.run_until(
+		[&chain] {
+			return chain[1].received_app_message_count == queued_message_count;
+		},
+		1500));
+	chain.run_for(500);
+	TEST_ASSERT_EQUAL_UINT32(queued_message_count, chain[1].received_app_message_count);
+
+	// The queue drained as the messages were acknowledged.
+	for (uint8_t i = 0; i < queued_message_count; i++) {
+		TEST_ASSERT_EQUAL(nc::network_handler::enqueue_message_result::QUEUED,
+				  chain[0].handler.enqueue_app_message(
+					  nc::peer_relative_position::RIGHT,
+					  uint8_t(nc::message::type::COLLECT_BADGE_IDS),
+					  reinterpret_cast<const uint8_t *>(&message)));
+	}
+}
+} // anonymous namespace
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+	UNITY_BEGIN();
+
+	RUN_TEST(test_pairing_time);
+	RUN_TEST(test_pairing_with_corrupted_bytes);
+	RUN_TEST(test_links_run_at_negotiated_speed);
+	RUN_TEST(test_app_messages_are_delivered);
+	RUN_TEST(test_app_messages_are_queued);
+	RUN_TEST(test_id_exchange_time);
+	RUN_TEST(test_id_exchange_with_full_queue);
+
+	return UNITY_END();
+}
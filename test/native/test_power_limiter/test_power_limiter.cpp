@@ -0,0 +1,113 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2023 Jérémie Galarneau <jeremie.galarneau@gmail.com>
+ */
+
+#include "led/power.hpp"
+
+#include <cstdint>
+#include <initializer_list>
+#include <unity.h>
+
+namespace nlpw = nsec::led::power;
+
+namespace {
+// Components of 16 LEDs showing full white, each drawing 20 mA.
+constexpr uint16_t full_white_component_sum = 16 * 3 * 255;
+constexpr uint16_t full_white_current_ma = 16 * 3 * 20;
+
+nlpw::scale min_scale(nlpw::scale lhs, nlpw::scale rhs)
+{
+	return lhs < rhs ? lhs : rhs;
+}
+
+uint16_t scaled_current_ma(uint16_t current_ma, uint16_t budget_ma)
+{
+	return uint32_t(current_ma) * nlpw::limit_scale(current_ma, budget_ma) / nlpw::unity_scale;
+}
+
+void test_components_current()
+{
+	TEST_ASSERT_EQUAL_UINT16(0, nlpw::components_current_ma(0, 20));
+	TEST_ASSERT_EQUAL_UINT16(full_white_current_ma,
+				 nlpw::components_current_ma(full_white_component_sum, 20));
+	// Rounded up, a dim frame still counts.
+	TEST_ASSERT_EQUAL_UINT16(1, nlpw::components_current_ma(1, 20));
+}
+
+void test_under_knee_is_unscaled()
+{
+	for (uint16_t current_ma = 0; current_ma <= 300; current_ma++) {
+		TEST_ASSERT_EQUAL_UINT16(nlpw::unity_scale, nlpw::limit_scale(current_ma, 400));
+	}
+
+	TEST_ASSERT_LESS_THAN_UINT16(nlpw::unity_scale, nlpw::limit_scale(301, 400));
+}
+
+void test_scaled_current_within_budget()
+{
+	for (const uint16_t budget_ma : { 50, 134, 250, 384 }) {
+		for (uint16_t current_ma = 0; current_ma <= 4 * full_white_current_ma;
+		     current_ma++) {
+			TEST_ASSERT_LESS_THAN_UINT16(budget_ma,
+						     scaled_current_ma(current_ma, budget_ma));
+		}
+	}
+}
+
+/*
+ * The scaled current rises with the frame's current and never jumps, so fades
+ * through the knee stay smooth, while the scale itself only goes down. Both
+ * are within the scale's resolution of 1/256th.
+ */
+void test_curve_is_smooth_and_monotonic()
+{
+	constexpr uint16_t budget_ma = 384;
+	uint16_t previous_scaled_ma = 0;
+	nlpw::scale previous_scale = nlpw::unity_scale;
+
+	for (uint16_t current_ma = 1; current_ma <= full_white_current_ma; current_ma++) {
+		const auto scale = nlpw::limit_scale(current_ma, budget_ma);
+		const auto scaled_ma = scaled_current_ma(current_ma, budget_ma);
+		const int32_t resolution_ma = current_ma / nlpw::unity_scale + 1;
+
+		TEST_ASSERT_LESS_OR_EQUAL_UINT16(previous_scale + 1, scale);
+		TEST_ASSERT_GREATER_OR_EQUAL_INT32(previous_scaled_ma - resolution_ma, scaled_ma);
+		TEST_ASSERT_LESS_OR_EQUAL_INT32(previous_scaled_ma + resolution_ma, scaled_ma);
+
+		previous_scaled_ma = scaled_ma;
+		previous_scale = min_scale(previous_scale, scale);
+	}
+}
+
+void test_full_white_is_compressed_near_budget()
+{
+	constexpr uint16_t budget_ma = 384;
+	const auto scaled_ma = scaled_current_ma(full_white_current_ma, budget_ma);
+
+	// Past the knee (288 mA), most of the remaining budget is used.
+	TEST_ASSERT_UINT16_WITHIN(16, 365, scaled_ma);
+}
+
+void test_empty_budget_keeps_frames_measurable()
+{
+	TEST_ASSERT_EQUAL_UINT16(1, nlpw::limit_scale(full_white_current_ma, 0));
+	TEST_ASSERT_EQUAL_UINT16(nlpw::unity_scale, nlpw::limit_scale(0, 0));
+}
+
+} // anonymous namespace
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+	UNITY_BEGIN();
+
+	RUN_TEST(test_components_current);
+	RUN_TEST(test_under_knee_is_unscaled);
+	RUN_TEST(test_scaled_current_within_budget);
+	RUN_TEST(test_curve_is_smooth_and_monotonic);
+	RUN_TEST(test_full_white_is_compressed_near_budget);
+	RUN_TEST(test_empty_budget_keeps_frames_measurable);
+
+	return UNITY_END();
+}
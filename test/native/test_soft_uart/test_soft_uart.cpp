@@ -0,0 +1,376 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2023 Jérémie Galarneau <jeremie.galarneau@gmail.com>
+ */
+
+#include "network/soft_uart.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <unity.h>
+#include <vector>
+
+namespace nsu = nsec::communication::soft_uart;
+
+/*
+ * Bit-level harness of the software UART: lines are simulated one timer tick
+ * at a time, and the receivers and transmitters are driven as by the badge's
+ * interrupt handlers.
+ */
+namespace {
+// 38400 and 57600 bauds at 8 MHz.
+constexpr uint16_t bit_ticks = 208;
+constexpr uint16_t fast_bit_ticks = 139;
+constexpr uint8_t buffer_size = 32;
+constexpr uint8_t transmit_buffer_size = 16;
+
+using receiver = nsu::receiver<buffer_size>;
+using transmitter = nsu::transmitter<transmit_buffer_size>;
+
+// Waveform of a line, as a list of level changes.
+class line {
+public:
+	// Idle (mark) until the first change.
+	bool level(uint32_t time) const noexcept
+	{
+		bool current_level = true;
+
+		for (const auto& change : _changes) {
+			if (change.time > time) {
+				break;
+			}
+
+			current_level = change.level;
+		}
+
+		return current_level;
+	}
+
+	// Frames of values sent back to back from start_time, bits lasting sent_bit_ticks.
+	uint32_t send(uint32_t start_time,
+		      const std::vector<uint8_t>& values,
+		      double sent_bit_ticks = bit_ticks) noexcept
+	{
+		double time = start_time;
+
+		for (const auto value : values) {
+			for (uint8_t bit_index = 0; bit_index < nsu::frame_bit_count; bit_index++) {
+				drive(uint32_t(time), nsu::frame_level(value, bit_index));
+				time += sent_bit_ticks;
+			}
+		}
+
+		return uint32_t(time);
+	}
+
+	// Hold a level for duration ticks.
+	uint32_t hold(uint32_t start_time, bool level, uint32_t duration) noexcept
+	{
+		drive(start_time, level);
+		drive(start_time + duration, true);
+		return start_time + duration;
+	}
+
+	void drive(uint32_t time, bool level)
+	{
+		_changes.push_back({ time, level });
+	}
+
+	uint32_t end_time() const noexcept
+	{
+		return _changes.empty() ? 0 : _changes.back().time;
+	}
+
+private:
+	struct level_change {
+		uint32_t time;
+		bool level;
+	};
+
+	std::vector<level_change> _changes;
+};
+
+// A receiver with the state of its side's interrupts.
+struct side {
+	explicit side(const line& side_line, uint16_t rx_bit_ticks = bit_ticks) : wire(side_line)
+	{
+		rx.bit_ticks(rx_bit_ticks);
+	}
+
+	std::vector<uint8_t> received() noexcept
+	{
+		std::vector<uint8_t> values;
+
+		while (rx.available()) {
+			values.push_back(rx.read());
+		}
+
+		return values;
+	}
+
+	const line& wire;
+	receiver rx;
+	bool is_edge_armed = true;
+	bool is_compare_armed = false;
+	bool previous_level = true;
+	uint16_t compare_tick = 0;
+};
+
+/*
+ * Run the sides until all their lines are idle. The timer starts at
+ * timer_origin; each sample is taken up to max_sample_delay ticks late, as
+ * when its interrupt is held by another handler.
+ */
+void run(std::vector<side *> sides, uint16_t timer_origin = 0, uint16_t max_sample_delay = 0)
+{
+	uint32_t end_time = 0;
+	uint32_t delay_state = 12345;
+
+	for (const auto *simulated_side : sides) {
+		end_time = std::max(end_time, simulated_side->wire.end_time() + 2 * bit_ticks);
+	}
+
+	for (uint32_t time = 0; time < end_time; time++) {
+		const uint16_t tick = timer_origin + time;
+
+		for (auto *simulated_side : sides) {
+			const bool level = simulated_side->wire.level(time);
+
+			if (simulated_side->is_edge_armed && simulated_side->previous_level &&
+			    !level) {
+				simulated_side->is_edge_armed = false;
+				simulated_side->is_compare_armed = true;
+				simulated_side->compare_tick = simulated_side->rx.start(tick);
+			}
+
+			simulated_side->previous_level = level;
+
+			if (!simulated_side->is_compare_armed ||
+			    simulated_side->compare_tick != tick) {
+				continue;
+			}
+
+			delay_state = delay_state * 1103515245 + 12345;
+			const uint32_t delay =
+				max_sample_delay ? (delay_state >> 16) % (max_sample_delay + 1) : 0;
+
+			if (simulated_side->rx.sample(simulated_side->wire.level(time + delay))) {
+				simulated_side->compare_tick = simulated_side->rx.next_sample_tick();
+			} else {
+				simulated_side->is_compare_armed = false;
+				simulated_side->is_edge_armed = true;
+			}
+		}
+	}
+}
+
+/*
+ * Drive a line from a transmitter, as its timer's interrupt handler does, up
+ * to the end of the frame during which queue_time is reached. Returns the time
+ * of the next edge.
+ */
+uint32_t transmit(transmitter& tx, line& wire, uint32_t time, uint32_t queue_time = UINT32_MAX)
+{
+	bool level;
+
+	while (time <= queue_time && tx.edge(level)) {
+		const uint16_t edge_tick = time;
+
+		wire.drive(time, level);
+		time += uint16_t(tx.next_edge_tick() - edge_tick);
+	}
+
+	return time;
+}
+
+std::vector<uint8_t> sequence(uint8_t first, uint8_t count)
+{
+	std::vector<uint8_t> values;
+
+	for (uint8_t i = 0; i < count; i++) {
+		values.push_back(first + i);
+	}
+
+	return values;
+}
+
+void assert_received(const std::vector<uint8_t>& expected, side& simulated_side)
+{
+	const auto received = simulated_side.received();
+
+	TEST_ASSERT_EQUAL_UINT32(expected.size(), received.size());
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected.data(), received.data(), expected.size());
+	TEST_ASSERT_EQUAL_UINT8(0, simulated_side.rx.framing_error_count());
+	TEST_ASSERT_FALSE(simulated_side.rx.is_receiving());
+}
+
+void test_frame_levels()
+{
+	const bool expected_levels[] = { false, true, false, true, false, false, true, false, true,
+					 true };
+
+	for (uint8_t bit_index = 0; bit_index < nsu::frame_bit_count; bit_index++) {
+		TEST_ASSERT_EQUAL(expected_levels[bit_index], nsu::frame_level(0xA5, bit_index));
+	}
+}
+
+void test_receives_all_values()
+{
+	for (unsigned int first = 0; first < 256; first += buffer_size - 1) {
+		line wire;
+		side left(wire);
+		const auto values =
+			sequence(first, std::min<unsigned int>(buffer_size - 1, 256 - first));
+
+		wire.send(100, values);
+		run({ &left });
+		assert_received(values, left);
+	}
+}
+
+// Both sides receive at once, out of phase and across the timer's wrap around.
+void test_receives_both_sides_at_once()
+{
+	line left_wire, right_wire;
+	side left(left_wire), right(right_wire);
+	const auto left_values = sequence(0x30, 20);
+	const auto right_values = sequence(0xC0, 24);
+
+	left_wire.send(50, left_values);
+	right_wire.send(50 + bit_ticks / 3, right_values);
+	run({ &left, &right }, 0xFFFF - 10 * bit_ticks);
+
+	assert_received(left_values, left);
+	assert_received(right_values, right);
+}
+
+// Senders' clocks off by 2%, samples held by other interrupt handlers.
+void test_tolerates_clock_drift_and_latency()
+{
+	for (const double drift : { -0.02, 0.02 }) {
+		line left_wire, right_wire;
+		side left(left_wire), right(right_wire);
+		const auto values = sequence(0x55, 10);
+
+		left_wire.send(10, values, bit_ticks * (1 + drift));
+		right_wire.send(77, values, bit_ticks * (1 - drift));
+		run({ &left, &right }, 0, bit_ticks / 4);
+
+		assert_received(values, left);
+		assert_received(values, right);
+	}
+}
+
+void test_transmits_queued_bytes()
+{
+	for (const auto speed_bit_ticks : { bit_ticks, fast_bit_ticks }) {
+		line wire;
+		side right(wire, speed_bit_ticks);
+		transmitter tx;
+		const auto values = sequence(0xF0, 30);
+		auto value = values.begin();
+
+		tx.bit_ticks(speed_bit_ticks);
+		TEST_ASSERT_FALSE(tx.is_transmitting());
+
+		// Keep the queue fed as the bytes go out, starting near the timer's wrap around.
+		uint32_t time = 0xFF80;
+		while (value != values.end() && tx.push(*value)) {
+			value++;
+		}
+
+		TEST_ASSERT_TRUE(tx.start(time));
+		TEST_ASSERT_FALSE(tx.start(time));
+		while (value != values.end()) {
+			time = transmit(tx, wire, time, time);
+			while (value != values.end() && tx.push(*value)) {
+				value++;
+			}
+		}
+
+		time = transmit(tx, wire, time);
+		TEST_ASSERT_FALSE(tx.is_transmitting());
+		TEST_ASSERT_EQUAL_UINT32(0xFF80 + values.size() * 10 * speed_bit_ticks, time);
+
+		run({ &right });
+		assert_received(values, right);
+	}
+}
+
+// Peers must agree on the speed: the base speed is garbled at the fast one.
+void test_speed_mismatch_is_garbled()
+{
+	line wire;
+	side right(wire, fast_bit_ticks);
+	const auto values = sequence(0x00, 8);
+
+	wire.send(100, values);
+	run({ &right });
+
+	const auto received = right.received();
+	TEST_ASSERT_TRUE(received != values);
+}
+
+void test_ignores_glitches()
+{
+	line wire;
+	side left(wire);
+	const auto values = sequence(0x10, 2);
+
+	const auto glitch_end = wire.hold(100, false, bit_ticks / 3);
+	wire.send(glitch_end + 5 * bit_ticks, values);
+	run({ &left });
+
+	assert_received(values, left);
+}
+
+// A frame without its stop bit is dropped and the next frame is received.
+void test_drops_framing_errors()
+{
+	line wire;
+	side left(wire);
+
+	const auto break_end = wire.hold(100, false, 12 * bit_ticks);
+	wire.send(break_end + 3 * bit_ticks, { 0x42 });
+	run({ &left });
+
+	TEST_ASSERT_EQUAL_UINT8(1, left.rx.framing_error_count());
+	TEST_ASSERT_EQUAL_UINT8(1, left.rx.available());
+	TEST_ASSERT_EQUAL_UINT8(0x42, left.rx.read());
+}
+
+void test_overflow_keeps_oldest_bytes()
+{
+	line wire;
+	side left(wire);
+	const auto values = sequence(0, buffer_size + 3);
+
+	wire.send(100, values);
+	run({ &left });
+
+	TEST_ASSERT_EQUAL_UINT8(4, left.rx.overflow_count());
+	TEST_ASSERT_EQUAL_UINT8(buffer_size - 1, left.rx.available());
+	TEST_ASSERT_EQUAL_UINT8(0, left.rx.peek());
+
+	left.rx.flush();
+	TEST_ASSERT_EQUAL_UINT8(0, left.rx.available());
+}
+} // anonymous namespace
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+	UNITY_BEGIN();
+
+	RUN_TEST(test_frame_levels);
+	RUN_TEST(test_receives_all_values);
+	RUN_TEST(test_receives_both_sides_at_once);
+	RUN_TEST(test_tolerates_clock_drift_and_latency);
+	RUN_TEST(test_transmits_queued_bytes);
+	RUN_TEST(test_speed_mismatch_is_garbled);
+	RUN_TEST(test_ignores_glitches);
+	RUN_TEST(test_drops_framing_errors);
+	RUN_TEST(test_overflow_keeps_oldest_bytes);
+
+	return UNITY_END();
+}
@@ -0,0 +1,60 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2023 Jérémie Galarneau <jeremie.galarneau@gmail.com>
+ */
+
+#ifndef NSEC_SIMULATION_ADAFRUIT_NEOPIXEL_H
+#define NSEC_SIMULATION_ADAFRUIT_NEOPIXEL_H
+
+#include "Arduino.h"
+
+#include <vector>
+
+// Same values as the library.
+#define NEO_GRB	   ((1 << 6) | (1 << 4) | (0 << 2) | (2))
+#define NEO_KHZ800 0x0000
+
+// Host stand-in for the NeoPixel strip, keeping the last frame sent to the LEDs.
+class Adafruit_NeoPixel {
+public:
+	Adafruit_NeoPixel(uint16_t pixel_count,
+			  [[maybe_unused]] int16_t pin,
+			  [[maybe_unused]] uint16_t type) :
+		_pixels(pixel_count * 3), _shown_pixels(pixel_count * 3)
+	{
+	}
+
+	void begin() noexcept
+	{
+	}
+
+	void show() noexcept
+	{
+		_shown_pixels = _pixels;
+		_show_count++;
+	}
+
+	uint8_t *getPixels() const noexcept
+	{
+		return const_cast<uint8_t *>(_pixels.data());
+	}
+
+	// Pixels of the last frame sent, in the device's order (GRB).
+	const std::vector<uint8_t>& shown_pixels() const noexcept
+	{
+		return _shown_pixels;
+	}
+
+	unsigned long show_count() const noexcept
+	{
+		return _show_count;
+	}
+
+private:
+	std::vector<uint8_t> _pixels;
+	std::vector<uint8_t> _shown_pixels;
+	unsigned long _show_count = 0;
+};
+
+#endif // NSEC_SIMULATION_ADAFRUIT_NEOPIXEL_H
@@ -0,0 +1,60 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2023 Jérémie Galarneau <jeremie.galarneau@gmail.com>
+ */
+
+#ifndef NSEC_SIMULATION_ARDUINO_H
+#define NSEC_SIMULATION_ARDUINO_H
+
+/*
+ * Host stand-in for the parts of the Arduino core and avr-libc used by the
+ * strip animator. Program memory is plain memory; its reads are counted as a
+ * measure of the animator's work.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+namespace nsec::simulation {
+// Virtual clock returned by millis().
+extern unsigned long now_ms;
+extern unsigned long flash_read_count;
+
+template <typename Value>
+Value read_flash(const void *address) noexcept
+{
+	Value value;
+
+	flash_read_count++;
+	memcpy(&value, address, sizeof(value));
+	return value;
+}
+} // namespace nsec::simulation
+
+#define PROGMEM
+#define pgm_read_byte(address) nsec::simulation::read_flash<uint8_t>(address)
+#define pgm_read_word(address) nsec::simulation::read_flash<uint16_t>(address)
+#define pgm_read_ptr(address) nsec::simulation::read_flash<void *>(address)
+#define memcpy_P(destination, source, size) \
+	(nsec::simulation::flash_read_count++, memcpy(destination, source, size))
+
+// Functions rather than the core's macros, which would break the standard library's headers.
+template <typename Lhs, typename Rhs>
+constexpr auto min(Lhs lhs, Rhs rhs) noexcept
+{
+	return lhs < rhs ? lhs : rhs;
+}
+
+template <typename Lhs, typename Rhs>
+constexpr auto max(Lhs lhs, Rhs rhs) noexcept
+{
+	return lhs > rhs ? lhs : rhs;
+}
+
+inline unsigned long millis() noexcept
+{
+	return nsec::simulation::now_ms;
+}
+
+#endif // NSEC_SIMULATION_ARDUINO_H
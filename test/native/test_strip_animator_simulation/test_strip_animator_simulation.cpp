@@ -0,0 +1,588 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2023 Jérémie Galarneau <jeremie.galarneau@gmail.com>
+ */
+
+/*
+ * Host simulation of the strip animator.
+ *
+ * The firmware's strip animator is built against a fake NeoPixel strip and a
+ * virtual clock (see Arduino.h and Adafruit_NeoPixel.h in this folder) and
+ * ticked by the badge's scheduler. Every idle animation is run, checking the
+ * animation state after each tick and measuring the work done per tick.
+ *
+ * Set NSEC_SIMULATION_OUTPUT_DIR to write a preview of each idle animation,
+ * idle_<id>.ppm, with one row per frame sent to the LEDs (top to bottom) and
+ * 4 pixels per LED. Previews are normalized to their brightest component.
+ */
+
+#include "Adafruit_NeoPixel.h"
+#include "Arduino.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <unity.h>
+#include <vector>
+
+// Stand-ins for the badge's globals and unique ID, the animator only needs these.
+#define NSEC_GLOBALS_HPP
+#define NSEC_UNIQUE_ID_HPP
+#include "config.hpp"
+#include "scheduler.hpp"
+
+#define UniqueIDsize 10
+#define UniqueID     (nsec::simulation::unique_id)
+
+namespace nsec::simulation {
+unsigned long now_ms;
+unsigned long flash_read_count;
+const uint8_t unique_id[UniqueIDsize] = {
+	0x1e, 0x95, 0x16, 0x42, 0x05, 0x13, 0x37, 0xca, 0xfe, 0x01
+};
+} // namespace nsec::simulation
+
+namespace nsec::runtime {
+class badge {
+public:
+	bool is_network_line_quiet() const noexcept
+	{
+		return true;
+	}
+};
+} // namespace nsec::runtime
+
+namespace nsec::g {
+scheduling::scheduler<config::scheduler::max_scheduled_task_count> the_scheduler;
+runtime::badge the_badge;
+} // namespace nsec::g
+
+#include "../../../src/strip_animator.cpp"
+
+namespace nsec::led {
+class strip_animator_simulator {
+public:
+	struct statistics {
+		unsigned int tick_count = 0;
+		unsigned long flash_read_count = 0;
+		unsigned int keyframe_cache_miss_count = 0;
+		double host_ns = 0;
+		// LEDs animated by a visible layer during the first half of the run.
+		uint16_t animated_leds = 0;
+		// LEDs whose color changed in the frames sent.
+		uint16_t changed_leds = 0;
+	};
+
+	explicit strip_animator_simulator(strip_animator& animator) noexcept : _animator{ animator }
+	{
+	}
+
+	/*
+	 * Tick the scheduler until duration_ms of virtual time elapsed, checking the
+	 * animator after each tick and keeping the frames sent to the LEDs.
+	 */
+	statistics run_for(unsigned long duration_ms)
+	{
+		statistics stats;
+		const auto end_ms = simulation::now_ms + duration_ms;
+		const auto half_ms = simulation::now_ms + duration_ms / 2;
+		auto show_count = _animator._pixels.show_count();
+
+		_frames.clear();
+		while (simulation::now_ms < end_ms) {
+			const auto flash_read_count = simulation::flash_read_count;
+			const auto keyframe_cache_misses = _animator.keyframe_cache_misses();
+
+			const auto start = std::chrono::steady_clock::now();
+			const auto wait_ms = g::the_scheduler.tick(simulation::now_ms);
+			const auto end = std::chrono::steady_clock::now();
+
+			stats.tick_count++;
+			stats.flash_read_count += simulation::flash_read_count - flash_read_count;
+			stats.keyframe_cache_miss_count +=
+				uint16_t(_animator.keyframe_cache_misses() - keyframe_cache_misses);
+			stats.host_ns +=
+				std::chrono::duration<double, std::nano>(end - start).count();
+
+			_check_invariants();
+			if (simulation::now_ms < half_ms) {
+				stats.animated_leds |= _animated_leds();
+			}
+
+			if (_animator._pixels.show_count() != show_count) {
+				const auto& pixels = _animator._pixels.shown_pixels();
+
+				show_count = _animator._pixels.show_count();
+				_check_power(pixels);
+				if (!_frames.empty()) {
+					stats.changed_leds |= _changed_leds(_frames.back(), pixels);
+				}
+
+				_frames.push_back(pixels);
+			}
+
+			simulation::now_ms += wait_ms;
+		}
+
+		return stats;
+	}
+
+	const std::vector<std::vector<uint8_t>>& frames() const noexcept
+	{
+		return _frames;
+	}
+
+	bool is_overlay_shown() const noexcept
+	{
+		return _animator._layers[strip_animator::_overlay_layer].config.mask;
+	}
+
+	const std::vector<uint8_t>& shown_pixels() const noexcept
+	{
+		return _animator._pixels.shown_pixels();
+	}
+
+	// Animated LED of the base layer that restarted last, 16 if there is none.
+	uint8_t newest_led(uint16_t& time_ms) const noexcept
+	{
+		const auto& layer = _animator._layers[strip_animator::_base_layer];
+		uint8_t newest_led_id = 16;
+
+		for (uint8_t led_id = 0; led_id < 16; led_id++) {
+			const uint16_t time = _animator._time_ms - layer.state.led_time_ms[led_id];
+
+			if ((layer.config.active >> led_id) & 1 &&
+			    (newest_led_id == 16 || time < time_ms)) {
+				newest_led_id = led_id;
+				time_ms = time;
+			}
+		}
+
+		return newest_led_id;
+	}
+
+	// Stop the base layer's animation, its LEDs hold their last keyframe.
+	void hold_base_layer() noexcept
+	{
+		_animator._layers[strip_animator::_base_layer].config.active = 0;
+	}
+
+private:
+	// LEDs of each layer that aren't covered by a layer above, as rendered.
+	std::array<uint16_t, strip_animator::_layer_count> _visible_leds() const noexcept
+	{
+		std::array<uint16_t, strip_animator::_layer_count> visible_leds;
+		uint16_t hidden_leds = 0;
+
+		for (uint8_t layer_id = strip_animator::_layer_count; layer_id-- > 0;) {
+			const auto mask = _animator._layers[layer_id].config.mask;
+
+			visible_leds[layer_id] = mask & ~hidden_leds;
+			hidden_leds |= mask;
+		}
+
+		return visible_leds;
+	}
+
+	uint16_t _animated_leds() const noexcept
+	{
+		const auto visible_leds = _visible_leds();
+		uint16_t animated_leds = 0;
+
+		for (uint8_t layer_id = 0; layer_id < strip_animator::_layer_count; layer_id++) {
+			const auto& config = _animator._layers[layer_id].config;
+
+			animated_leds |= visible_leds[layer_id] & config.active;
+		}
+
+		return animated_leds;
+	}
+
+	static uint16_t last_keyframe_time(const strip_animator::layer& layer) noexcept
+	{
+		uint16_t time = 0;
+
+		// The first keyframe of a range is at time 0.
+		for (uint8_t i = 1; i < layer.config.keyframe_count; i++) {
+			time += layer.config.keyframes[i].time_step * layer.config.time_scale;
+		}
+
+		return time;
+	}
+
+	void _check_invariants() const
+	{
+		const auto visible_leds = _visible_leds();
+
+		for (uint8_t layer_id = 0; layer_id < strip_animator::_layer_count; layer_id++) {
+			const auto& layer = _animator._layers[layer_id];
+
+			if (!layer.config.mask) {
+				continue;
+			}
+
+			const uint8_t keyframe_count = layer.config.keyframe_count;
+			const uint16_t end_time = last_keyframe_time(layer);
+
+			TEST_ASSERT_NOT_EQUAL(0, keyframe_count);
+			TEST_ASSERT_LESS_THAN_UINT8(keyframe_count, layer.config.loop_point_index);
+
+			for (uint8_t led_id = 0; led_id < 16; led_id++) {
+				const auto origin = _animator._get_keyframe_index(
+					layer.state.origin_keyframe_index, led_id);
+				const auto destination = _animator._get_keyframe_index(
+					layer.state.destination_keyframe_index, led_id);
+
+				TEST_ASSERT_LESS_THAN_UINT8(keyframe_count, origin);
+				TEST_ASSERT_LESS_THAN_UINT8(keyframe_count, destination);
+				// LEDs move one segment at a time, or restart at keyframe 0.
+				TEST_ASSERT_TRUE(destination == origin || destination == origin + 1);
+
+				const bool is_evaluated = (visible_leds[layer_id] >> led_id) & 1 &&
+					(layer.config.active >> led_id) & 1;
+				if (is_evaluated) {
+					// Times are folded back in the animation when it loops.
+					const uint16_t time =
+						_animator._time_ms - layer.state.led_time_ms[led_id];
+
+					TEST_ASSERT_LESS_OR_EQUAL_UINT16(end_time, time);
+				}
+			}
+		}
+	}
+
+	void _check_power(const std::vector<uint8_t>& pixels) const
+	{
+		uint16_t component_sum = 0;
+
+		for (const auto component : pixels) {
+			component_sum += component;
+		}
+
+		const auto current_ma = power::components_current_ma(
+						component_sum, config::led::component_current_ma) +
+			NUMPIXELS * config::led::idle_current_ma;
+
+		TEST_ASSERT_LESS_OR_EQUAL_UINT16(config::led::power_budget_ma, current_ma);
+	}
+
+	static uint16_t _changed_leds(const std::vector<uint8_t>& previous,
+				      const std::vector<uint8_t>& current) noexcept
+	{
+		uint16_t changed_leds = 0;
+
+		for (uint8_t led_id = 0; led_id < 16; led_id++) {
+			if (!std::equal(&previous[led_id * 3],
+					&previous[led_id * 3 + 3],
+					&current[led_id * 3])) {
+				changed_leds |= 1 << led_id;
+			}
+		}
+
+		return changed_leds;
+	}
+
+	strip_animator& _animator;
+	std::vector<std::vector<uint8_t>> _frames;
+};
+} // namespace nsec::led
+
+namespace {
+namespace nsim = nsec::simulation;
+
+constexpr unsigned long idle_animation_duration_ms = 10000;
+/*
+ * Bound of the flash reads per tick averaged over an idle animation: a
+ * regression of the keyframe engine (cache, sparse updates) shows up here. On
+ * top of it, each pixel component set reads its gamma correction.
+ */
+constexpr double max_flash_reads_per_tick = 100 + 16 * 3;
+
+// The animator registers itself with the scheduler, it lives as long as the test.
+nl::strip_animator& animator()
+{
+	static nl::strip_animator the_animator;
+	static bool is_set_up = false;
+
+	if (!is_set_up) {
+		nsim::now_ms = 1000;
+		the_animator.setup();
+		is_set_up = true;
+	}
+
+	return the_animator;
+}
+
+void write_preview(const std::string& path, const std::vector<std::vector<uint8_t>>& frames)
+{
+	constexpr unsigned int pixels_per_led = 4;
+	uint8_t brightest = 1;
+
+	for (const auto& frame : frames) {
+		brightest = std::max(brightest, *std::max_element(frame.begin(), frame.end()));
+	}
+
+	std::ofstream preview(path, std::ios::binary);
+	preview << "P6\n" << 16 * pixels_per_led << " " << frames.size() << "\n255\n";
+	for (const auto& frame : frames) {
+		for (uint8_t led_id = 0; led_id < 16; led_id++) {
+			const nl::strip_animator::led_color color(
+				const_cast<uint8_t *>(&frame[led_id * 3]));
+			const uint8_t rgb[] = { uint8_t(color.r() * 255 / brightest),
+						uint8_t(color.g() * 255 / brightest),
+						uint8_t(color.b() * 255 / brightest) };
+
+			for (unsigned int i = 0; i < pixels_per_led; i++) {
+				preview.write(reinterpret_cast<const char *>(rgb), sizeof(rgb));
+			}
+		}
+	}
+}
+
+void test_idle_animations()
+{
+	nl::strip_animator_simulator simulator(animator());
+	const char *const output_dir = std::getenv("NSEC_SIMULATION_OUTPUT_DIR");
+	unsigned long total_flash_reads = 0, total_ticks = 0, total_misses = 0;
+	double total_ns = 0, max_flash_reads = 0;
+	unsigned int max_flash_reads_id = 0;
+
+	for (unsigned int id = 0; id <= nsec::config::social::max_level; id++) {
+		animator().set_idle_animation(id);
+
+		const auto stats = simulator.run_for(idle_animation_duration_ms);
+		const double flash_reads = double(stats.flash_read_count) / stats.tick_count;
+		char message[96];
+
+		snprintf(message, sizeof(message), "idle animation %u", id);
+		TEST_ASSERT_FALSE_MESSAGE(simulator.frames().empty(), message);
+		// An LED that animates must change color at some point.
+		TEST_ASSERT_EQUAL_UINT16_MESSAGE(
+			stats.animated_leds, stats.animated_leds & stats.changed_leds, message);
+		TEST_ASSERT_TRUE_MESSAGE(flash_reads <= max_flash_reads_per_tick, message);
+
+		if (output_dir) {
+			const auto path =
+				std::string(output_dir) + "/idle_" + std::to_string(id) + ".ppm";
+
+			write_preview(path, simulator.frames());
+		}
+
+		total_flash_reads += stats.flash_read_count;
+		total_ticks += stats.tick_count;
+		total_misses += stats.keyframe_cache_miss_count;
+		total_ns += stats.host_ns;
+		if (flash_reads > max_flash_reads) {
+			max_flash_reads = flash_reads;
+			max_flash_reads_id = id;
+		}
+	}
+
+	char message[160];
+	snprintf(message,
+		 sizeof(message),
+		 "per tick: %.1f flash reads (at most %.1f, animation %u), %.2f keyframe cache "
+		 "misses, %.0f ns on the host",
+		 double(total_flash_reads) / total_ticks,
+		 max_flash_reads,
+		 max_flash_reads_id,
+		 double(total_misses) / total_ticks,
+		 total_ns / total_ticks);
+	TEST_MESSAGE(message);
+}
+
+void test_status_overlays()
+{
+	using animation_type = nl::strip_animator::pairing_completed_animation_type;
+	nl::strip_animator_simulator simulator(animator());
+
+	// Every LED of this color cycle animates.
+	animator().set_idle_animation(3);
+	simulator.run_for(2000);
+
+	// The idle animation goes on past the end of the progress bar.
+	animator().set_red_to_green_led_progress_bar(4);
+	auto stats = simulator.run_for(2000);
+	TEST_ASSERT_EQUAL_UINT16(0xfff0, stats.animated_leds & stats.changed_leds & 0xfff0);
+
+	for (uint8_t led_count = 5; led_count <= 16; led_count++) {
+		animator().set_red_to_green_led_progress_bar(led_count);
+		simulator.run_for(300);
+	}
+
+	animator().set_pairing_completed_animation(animation_type::HAPPY_CLOWN_BARF);
+	simulator.run_for(2000);
+
+	// And under the level's unlit lower bar.
+	animator().set_show_level_animation(animation_type::NO_NEW_FRIENDS, 42, false);
+	stats = simulator.run_for(2000);
+	TEST_ASSERT_EQUAL_UINT16(0xff00, stats.animated_leds & stats.changed_leds & 0xff00);
+
+	// The idle animation resumes under the overlay.
+	animator().set_idle_animation(3);
+	stats = simulator.run_for(2000);
+	TEST_ASSERT_FALSE(simulator.is_overlay_shown());
+	TEST_ASSERT_EQUAL_UINT16(stats.animated_leds, stats.animated_leds & stats.changed_leds);
+}
+
+// LEDs holding a color between two output levels keep being dithered.
+void test_held_leds_are_dithered()
+{
+	nl::strip_animator_simulator simulator(animator());
+
+	// None of the animations hold a lit LED for long, so hold this one's colors.
+	animator().set_idle_animation(3);
+	simulator.run_for(2000);
+	simulator.hold_base_layer();
+	simulator.run_for(100);
+
+	// Some of the held colors fall between two output levels.
+	const auto stats = simulator.run_for(2000);
+	TEST_ASSERT_EQUAL_UINT16(0, stats.animated_leds);
+	TEST_ASSERT_NOT_EQUAL(0, stats.changed_leds);
+
+	animator().set_idle_animation(3);
+	simulator.run_for(2000);
+}
+
+/*
+ * Two chained badges sharing the virtual clock, and so the network time. The
+ * idle animation is started at different times on each.
+ */
+void test_chained_badges()
+{
+	// Registered with the scheduler, they live as long as the test.
+	static nl::strip_animator left, right;
+	nl::strip_animator_simulator left_simulator(left), right_simulator(right);
+
+	left.setup();
+	right.setup();
+	left.set_chain_position(0, 2);
+	right.set_chain_position(1, 2);
+
+	// A single shooting star runs along the 32 LEDs of the chain.
+	left.set_idle_animation(0);
+	left_simulator.run_for(1234);
+	right.set_idle_animation(0);
+	// Follow the star once the right badge lit where it is along the chain.
+	left_simulator.run_for(100);
+
+	uint8_t previous_position = 32;
+	unsigned int advance_count = 0;
+	for (unsigned int i = 0; i < 500; i++) {
+		uint16_t left_time_ms = 0, right_time_ms = 0;
+
+		left_simulator.run_for(20);
+
+		const auto left_led = left_simulator.newest_led(left_time_ms);
+		const auto right_led = right_simulator.newest_led(right_time_ms);
+		const uint8_t position = right_led == 16 ||
+				(left_led != 16 && left_time_ms < right_time_ms) ?
+			left_led :
+			16 + right_led;
+
+		if (previous_position != 32 && position != previous_position) {
+			TEST_ASSERT_EQUAL_UINT8((previous_position + 1) % 32, position);
+			advance_count++;
+		}
+
+		previous_position = position;
+	}
+
+	// 10 s at an LED every 90 ms.
+	TEST_ASSERT_UINT16_WITHIN(2, 111, advance_count);
+
+	// Both badges show the same frames of a cycle without offset between LEDs.
+	left.set_idle_animation(1);
+	left_simulator.run_for(1234);
+	right.set_idle_animation(1);
+
+	for (unsigned int i = 0; i < 100; i++) {
+		left_simulator.run_for(100);
+
+		const auto& left_pixels = left_simulator.shown_pixels();
+		const auto& right_pixels = right_simulator.shown_pixels();
+
+		for (unsigned int component = 0; component < left_pixels.size(); component++) {
+			// Dithering differs by at most a step.
+			TEST_ASSERT_UINT8_WITHIN(
+				1, left_pixels[component], right_pixels[component]);
+		}
+	}
+}
+
+/*
+ * Network time corrections move the offset back about half the time. A badge
+ * whose offset steps back and forth shows the same frames as badges running at
+ * each offset all along.
+ */
+void test_network_time_corrections()
+{
+	namespace ncc = nsec::config::communication;
+
+	constexpr uint32_t offset_ms = 12345;
+	// The largest correction that is averaged, more than an animation tick.
+	constexpr uint32_t correction_ms =
+		ncc::network_time_step_threshold_ms >> ncc::network_time_smoothing_shift;
+	// Registered with the scheduler, they live as long as the test.
+	static nl::strip_animator corrected, on_time, late;
+	nl::strip_animator_simulator corrected_simulator(corrected), on_time_simulator(on_time),
+		late_simulator(late);
+	nl::strip_animator *const animators[] = { &corrected, &on_time, &late };
+
+	for (auto animator : animators) {
+		animator->setup();
+		animator->set_chain_position(1, 2);
+		animator->set_network_time_offset(offset_ms);
+	}
+
+	late.set_network_time_offset(offset_ms - correction_ms);
+
+	// Color cycles, without and with an offset between LEDs.
+	for (const uint8_t id : { 1, 3 }) {
+		for (auto animator : animators) {
+			animator->set_idle_animation(id);
+		}
+
+		for (unsigned int i = 0; i < 300; i++) {
+			const bool is_late = i % 2;
+			const auto& reference = is_late ? late_simulator : on_time_simulator;
+			const auto end_ms = nsim::now_ms + 30;
+
+			corrected.set_network_time_offset(offset_ms - (is_late ? correction_ms : 0));
+			// Check every tick, a misplaced LED may be back in its segment on the next.
+			while (nsim::now_ms < end_ms) {
+				corrected_simulator.run_for(1);
+
+				const auto& pixels = corrected_simulator.shown_pixels();
+				const auto& reference_pixels = reference.shown_pixels();
+
+				for (unsigned int component = 0; component < pixels.size();
+				     component++) {
+					// Dithering differs by at most a step.
+					TEST_ASSERT_UINT8_WITHIN(
+						1, reference_pixels[component], pixels[component]);
+				}
+			}
+		}
+	}
+}
+} // anonymous namespace
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+{
+	UNITY_BEGIN();
+
+	RUN_TEST(test_idle_animations);
+	RUN_TEST(test_status_overlays);
+	RUN_TEST(test_held_leds_are_dithered);
+	RUN_TEST(test_chained_badges);
+	RUN_TEST(test_network_time_corrections);
+
+	return UNITY_END();
+}